@@ -7,6 +7,18 @@
 #include <salgo/alloc/crude-allocator>
 #include <salgo/alloc/random-allocator>
 #include <salgo/alloc/array-allocator>
+#include <salgo/alloc/thread-cached>
+#include <salgo/alloc/arena-allocator>
+#include <salgo/alloc/instrumented>
+#include <salgo/alloc/slab-allocator>
+
+#include <salgo/list>
+#include <salgo/hash-table>
+
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <random>
 
 using namespace benchmark;
 
@@ -104,6 +116,29 @@ BENCHMARK( SEQUENTIAL_salgo_vector )->MinTime(0.1);
 
 
 
+static void SEQUENTIAL_salgo_vector_bitmap(State& state) {
+	srand(69); clear_cache();
+
+	using Alloc = Array_Allocator<int> ::FREE_BITMAP;
+	Alloc alloc;
+
+	Dynamic_Array<Alloc::Handle> v;
+	v.reserve( state.max_iterations );
+
+	for(auto _ : state) {
+		auto h = alloc.construct().handle();
+		v.emplace_back( h );
+	}
+
+	for(auto& e : v) alloc(e).destruct();
+}
+BENCHMARK( SEQUENTIAL_salgo_vector_bitmap )->MinTime(0.1);
+
+
+
+
+
+
 
 
 
@@ -180,6 +215,8 @@ static void QUEUE_salgo_crude(State& state) {
 		}
 	}
 
+	state.counters["rss_mb"] = rss_bytes() / 1e6;
+
 	while(!is_empty()) {
 		auto h = v[fst];
 		fst = (fst+1)%v.domain();
@@ -191,6 +228,45 @@ BENCHMARK( QUEUE_salgo_crude )->MinTime(0.1);
 
 
 
+static void QUEUE_salgo_crude_reuse(State& state) {
+	srand(69); clear_cache();
+
+	using Alloc = salgo::Crude_Allocator<int> ::REUSE;
+	Alloc alloc;
+
+	// crude queue implementation
+	Memory_Block<Alloc::Handle> ::DENSE v(state.max_iterations/10 + 10);
+	int fst = 0;
+	int lst = 0;
+	auto is_empty = [&](){ return fst == lst; };
+	auto is_full  = [&](){ return fst != lst && (v.domain()+fst-lst)%v.domain() <= 2; };
+
+	for(auto _ : state) {
+		if(is_full() || (!is_empty() && rand()%2)) {
+			auto h = v[fst];
+			fst = (fst+1)%v.domain();
+			alloc.destruct(h);
+		}
+		else {
+			auto h = alloc.construct().handle();
+			v[lst] = h;
+			lst = (lst+1)%v.domain();
+		}
+	}
+
+	state.counters["rss_mb"] = rss_bytes() / 1e6;
+
+	while(!is_empty()) {
+		auto h = v[fst];
+		fst = (fst+1)%v.domain();
+		alloc.destruct(h);
+	}
+}
+BENCHMARK( QUEUE_salgo_crude_reuse )->MinTime(0.1);
+
+
+
+
 
 
 static void QUEUE_salgo_random(State& state) {
@@ -271,6 +347,45 @@ BENCHMARK( QUEUE_salgo_vector )->MinTime(0.1);
 
 
 
+static void QUEUE_salgo_vector_bitmap(State& state) {
+	srand(69); clear_cache();
+
+	using Alloc = Array_Allocator<int> ::FREE_BITMAP;
+	Alloc alloc;
+
+	// crude queue implementation
+	Memory_Block<Alloc::Handle> ::DENSE v(state.max_iterations/10 + 10);
+	int fst = 0;
+	int lst = 0;
+	auto is_empty = [&](){ return fst == lst; };
+	auto is_full  = [&](){ return fst != lst && (v.domain()+fst-lst)%v.domain() <= 2; };
+
+	for(auto _ : state) {
+		if(is_full() || (!is_empty() && rand()%2)) {
+			auto h = v[fst];
+			fst = (fst+1)%v.domain();
+			alloc(h).destruct();
+		}
+		else {
+			auto h = alloc.construct().handle();
+			v[lst] = h;
+			lst = (lst+1)%v.domain();
+		}
+	}
+
+	while(!is_empty()) {
+		auto h = v[fst];
+		fst = (fst+1)%v.domain();
+		alloc(h).destruct();
+	}
+}
+BENCHMARK( QUEUE_salgo_vector_bitmap )->MinTime(0.1);
+
+
+
+
+
+
 
 
 
@@ -319,6 +434,7 @@ static void RANDOM_salgo_crude(State& state) {
 	using Alloc = salgo::Crude_Allocator<int>;
 	Alloc alloc;
 
+
 	Memory_Block<Alloc::Handle> ::CONSTRUCTED_FLAGS v(state.max_iterations/10 + 10);
 
 	for(auto _ : state) {
@@ -333,6 +449,8 @@ static void RANDOM_salgo_crude(State& state) {
 		}
 	}
 
+	state.counters["rss_mb"] = rss_bytes() / 1e6;
+
 	for(auto& e : v) {
 		alloc(e).destruct();
 	}
@@ -342,6 +460,38 @@ BENCHMARK( RANDOM_salgo_crude )->MinTime(0.1);
 
 
 
+static void RANDOM_salgo_crude_reuse(State& state) {
+	srand(69); clear_cache();
+
+	using Alloc = salgo::Crude_Allocator<int> ::REUSE;
+	Alloc alloc;
+
+
+	Memory_Block<Alloc::Handle> ::CONSTRUCTED_FLAGS v(state.max_iterations/10 + 10);
+
+	for(auto _ : state) {
+		int idx = rand() % v.domain();
+		if(v(idx).is_constructed()) {
+			alloc.destruct( v[idx] );
+			v(idx).destruct();
+		}
+		else {
+			auto h = alloc.construct().handle();
+			v(idx).construct(h);
+		}
+	}
+
+	state.counters["rss_mb"] = rss_bytes() / 1e6;
+
+	for(auto& e : v) {
+		alloc(e).destruct();
+	}
+}
+BENCHMARK( RANDOM_salgo_crude_reuse )->MinTime(0.1);
+
+
+
+
 
 
 static void RANDOM_salgo_random(State& state) {
@@ -406,6 +556,590 @@ BENCHMARK( RANDOM_salgo_vector )->MinTime(0.1);
 
 
 
+static void RANDOM_salgo_vector_bitmap(State& state) {
+	srand(69); clear_cache();
+
+	using Alloc = Array_Allocator<int> ::FREE_BITMAP;
+	Alloc alloc;
+
+	Memory_Block<Alloc::Handle> ::CONSTRUCTED_FLAGS v(state.max_iterations/10 + 10);
+
+	for(auto _ : state) {
+		int idx = rand() % v.domain();
+		if(v(idx).is_constructed()) {
+			alloc( v[idx] ).destruct();
+			v(idx).destruct();
+		}
+		else {
+			auto h = alloc.construct().handle();
+			v(idx).construct(h);
+		}
+	}
+
+	for(auto& e : v) {
+		alloc(e).destruct();
+	}
+}
+BENCHMARK( RANDOM_salgo_vector_bitmap )->MinTime(0.1);
+
+
+
+
+
+
+
+//
+// keep a fixed number of elements, replacing random ones
+//
+// Array_Allocator occupancy stays just below 0.5, so linear scans for holes are long
+//
+
+static const int CHURN_Elements = 1<<20;
+
+template<class ALLOC>
+static void _churn(State& state) {
+	srand(69); clear_cache();
+
+	ALLOC alloc;
+
+	Dynamic_Array<typename ALLOC::Handle> v;
+	for(int i=0; i<CHURN_Elements; ++i) v.emplace_back( alloc.construct().handle() );
+
+	for(auto _ : state) {
+		auto& h = v[ rand() % CHURN_Elements ];
+		alloc(h).destruct();
+		h = alloc.construct().handle();
+	}
+
+	state.counters["rss_mb"] = rss_bytes() / 1e6;
+	report_alloc_stats(state, alloc);
+
+	for(auto& e : v) alloc(e).destruct();
+}
+
+
+static void CHURN_std(State& state) {
+	_churn< Salgo_From_Std_Allocator< std::allocator<int> > >(state);
+}
+BENCHMARK( CHURN_std )->MinTime(0.1);
+
+
+static void CHURN_salgo_crude(State& state) {
+	_churn< salgo::Crude_Allocator<int> >(state);
+}
+BENCHMARK( CHURN_salgo_crude )->MinTime(0.1);
+
+
+static void CHURN_salgo_crude_reuse(State& state) {
+	_churn< salgo::Crude_Allocator<int> ::REUSE >(state);
+}
+BENCHMARK( CHURN_salgo_crude_reuse )->MinTime(0.1);
+
+
+static void CHURN_salgo_random(State& state) {
+	_churn< salgo::Random_Allocator<int> >(state);
+}
+BENCHMARK( CHURN_salgo_random )->MinTime(0.1);
+
+
+static void CHURN_salgo_vector(State& state) {
+	_churn< Array_Allocator<int> >(state);
+}
+BENCHMARK( CHURN_salgo_vector )->MinTime(0.1);
+
+
+static void CHURN_salgo_vector_bitmap(State& state) {
+	_churn< Array_Allocator<int> ::FREE_BITMAP >(state);
+}
+BENCHMARK( CHURN_salgo_vector_bitmap )->MinTime(0.1);
+
+
+static void CHURN_salgo_vector_stable(State& state) {
+	_churn< Array_Allocator<int> ::STABLE ::FREE_BITMAP >(state);
+}
+BENCHMARK( CHURN_salgo_vector_stable )->MinTime(0.1);
+
+
+static void CHURN_salgo_slab(State& state) {
+	_churn< Slab_Allocator<int> >(state);
+}
+BENCHMARK( CHURN_salgo_slab )->MinTime(0.1);
+
+
+// hole search lengths and memory usage, next to timings
+
+static void CHURN_salgo_random_instrumented(State& state) {
+	_churn< Instrumented< salgo::Random_Allocator<int> > >(state);
+}
+BENCHMARK( CHURN_salgo_random_instrumented )->MinTime(0.1);
+
+
+static void CHURN_salgo_vector_instrumented(State& state) {
+	_churn< Instrumented< Array_Allocator<int> > >(state);
+}
+BENCHMARK( CHURN_salgo_vector_instrumented )->MinTime(0.1);
+
+
+static void CHURN_salgo_vector_bitmap_instrumented(State& state) {
+	_churn< Instrumented< Array_Allocator<int> ::FREE_BITMAP > >(state);
+}
+BENCHMARK( CHURN_salgo_vector_bitmap_instrumented )->MinTime(0.1);
+
+
+
+
+
+
+
+
+//
+// like CHURN, but first fill the allocator and destruct 5% of elements - 95% occupancy,
+// if the allocator reuses holes instead of growing
+//
+
+template<class ALLOC>
+static void _churn_high_load(State& state) {
+	srand(69); clear_cache();
+
+	ALLOC alloc;
+
+	const int N = (1<<20) - 1;
+	Dynamic_Array<typename ALLOC::Handle> v;
+	for(int i=0; i<N; ++i) v.emplace_back( alloc.construct().handle() );
+
+	for(int i=0; i<N/20; ++i) {
+		std::swap( v[ rand() % (N-i) ], v[N-i-1] );
+		alloc( v[N-i-1] ).destruct();
+	}
+
+	const int n = N - N/20;
+	for(auto _ : state) {
+		auto& h = v[ rand() % n ];
+		alloc(h).destruct();
+		h = alloc.construct().handle();
+	}
+
+	report_alloc_stats(state, alloc);
+
+	for(int i=0; i<n; ++i) alloc( v[i] ).destruct();
+}
+
+
+static void CHURN_HIGH_LOAD_salgo_random(State& state) {
+	_churn_high_load< Instrumented< salgo::Random_Allocator<int> > >(state);
+}
+BENCHMARK( CHURN_HIGH_LOAD_salgo_random )->MinTime(0.1);
+
+
+static void CHURN_HIGH_LOAD_salgo_vector_bitmap(State& state) {
+	_churn_high_load< Instrumented< Array_Allocator<int> ::FREE_BITMAP > >(state);
+}
+BENCHMARK( CHURN_HIGH_LOAD_salgo_vector_bitmap )->MinTime(0.1);
+
+
+
+
+
+
+
+//
+// every thread keeps its own elements, replacing random ones
+//
+// all threads allocate from one shared allocator
+//
+
+static const int THREADS_Elements = 1<<14;
+
+template<class ALLOC>
+static void _threads(State& state) {
+	if(state.thread_index() == 0) clear_cache();
+
+	std::minstd_rand rnd( 69 + state.thread_index() );
+
+	ALLOC alloc;
+
+	std::vector<typename ALLOC::Handle> v;
+	for(int i=0; i<THREADS_Elements; ++i) v.emplace_back( alloc.construct().handle() );
+
+	for(auto _ : state) {
+		auto& h = v[ rnd() % THREADS_Elements ];
+		alloc(h).destruct();
+		h = alloc.construct().handle();
+	}
+
+	for(auto& e : v) alloc(e).destruct();
+}
+
+
+// shared allocator, one lock per call
+template<class ALLOC>
+struct Locked {
+	using Handle = typename ALLOC::Handle;
+
+	static auto& _alloc() { static ALLOC alloc; return alloc; }
+	static auto& _mutex() { static std::mutex mutex; return mutex; }
+
+	auto construct() {
+		std::lock_guard<std::mutex> lock( _mutex() );
+		return _alloc().construct();
+	}
+
+	void destruct(Handle h) {
+		std::lock_guard<std::mutex> lock( _mutex() );
+		_alloc().destruct(h);
+	}
+
+	auto operator()(Handle h) { return Accessor{h}; }
+
+	struct Accessor {
+		Handle h;
+		void destruct() { Locked().destruct(h); }
+	};
+};
+
+
+static void THREADS_std(State& state) {
+	_threads< Salgo_From_Std_Allocator< std::allocator<int> > >(state);
+}
+BENCHMARK( THREADS_std )->Threads(1)->Threads(4)->MinTime(0.1);
+
+
+static void THREADS_salgo_crude_locked(State& state) {
+	_threads< Locked< salgo::Crude_Allocator<int> ::REUSE > >(state);
+}
+BENCHMARK( THREADS_salgo_crude_locked )->Threads(1)->Threads(4)->MinTime(0.1);
+
+
+static void THREADS_salgo_thread_cached(State& state) {
+	_threads< salgo::Thread_Cached< salgo::Crude_Allocator<int> ::REUSE > >(state);
+}
+BENCHMARK( THREADS_salgo_thread_cached )->Threads(1)->Threads(4)->MinTime(0.1);
+
+
+
+
+
+
+
+//
+// malloc-style mixed workload: elements of 3 sizes (16, 48 and 200 bytes) from 3 allocators,
+// replacing random ones of random size
+//
+// `VAL<T>` rebinds one allocator type to all 3 element types
+// (with ::SHARED, all of them use a single pool)
+//
+
+template<int N>
+struct Bytes { char data[N]; };
+
+static const int MIXED_Elements = 1<<18;
+
+template<class ALLOC>
+static void _mixed(State& state) {
+	srand(69); clear_cache();
+
+	typename ALLOC::template VAL<Bytes<16>>  a16;
+	typename ALLOC::template VAL<Bytes<48>>  a48;
+	typename ALLOC::template VAL<Bytes<200>> a200;
+
+	struct Item {
+		int kind;
+		union { typename decltype(a16)::Handle h16; typename decltype(a48)::Handle h48; typename decltype(a200)::Handle h200; };
+		Item() : kind(0), h16() {}
+	};
+
+	auto construct = [&](Item& item) {
+		item.kind = rand() % 3;
+		if(item.kind == 0) item.h16  = a16 .construct().handle();
+		if(item.kind == 1) item.h48  = a48 .construct().handle();
+		if(item.kind == 2) item.h200 = a200.construct().handle();
+	};
+
+	auto destruct = [&](Item& item) {
+		if(item.kind == 0) a16 (item.h16 ).destruct();
+		if(item.kind == 1) a48 (item.h48 ).destruct();
+		if(item.kind == 2) a200(item.h200).destruct();
+	};
+
+	std::vector<Item> v(MIXED_Elements);
+	for(auto& item : v) construct(item);
+
+	for(auto _ : state) {
+		auto& item = v[ rand() % MIXED_Elements ];
+		destruct(item);
+		construct(item);
+	}
+
+	state.counters["rss_mb"] = rss_bytes() / 1e6;
+
+	for(auto& item : v) destruct(item);
+}
+
+
+static void MIXED_std(State& state) {
+	_mixed< Salgo_From_Std_Allocator< std::allocator<int> > >(state);
+}
+BENCHMARK( MIXED_std )->MinTime(0.1);
+
+
+static void MIXED_salgo_crude_reuse(State& state) {
+	_mixed< salgo::Crude_Allocator<int> ::REUSE >(state);
+}
+BENCHMARK( MIXED_salgo_crude_reuse )->MinTime(0.1);
+
+
+static void MIXED_salgo_slab(State& state) {
+	_mixed< Slab_Allocator<int> >(state);
+}
+BENCHMARK( MIXED_salgo_slab )->MinTime(0.1);
+
+
+namespace {
+	struct Mixed_Tag {};
+}
+
+static void MIXED_salgo_slab_shared(State& state) {
+	_mixed< Slab_Allocator<int> ::SHARED<Mixed_Tag> >(state);
+}
+BENCHMARK( MIXED_salgo_slab_shared )->MinTime(0.1);
+
+
+
+
+
+
+
+//
+// long-lived elements + short-lived temporaries
+//
+// with linear scan, once the lookup index wraps around, a single construct() scans over all long-lived elements
+//
+// reports the slowest construct() call (timing adds some overhead to the average)
+//
+
+static const int TEMPORARIES_Elements = 1<<18;
+
+template<class ALLOC>
+static void _temporaries(State& state) {
+	srand(69); clear_cache();
+
+	ALLOC alloc;
+
+	Dynamic_Array<typename ALLOC::Handle> v;
+	for(int i=0; i<TEMPORARIES_Elements; ++i) v.emplace_back( alloc.construct().handle() );
+
+	// don't measure growth and first-touch page faults
+	for(int i=0; i<alloc.domain(); ++i) alloc( alloc.construct().handle() ).destruct();
+
+	double max_ns = 0;
+
+	for(auto _ : state) {
+		auto t0 = std::chrono::steady_clock::now();
+		auto h = alloc.construct().handle();
+		auto t1 = std::chrono::steady_clock::now();
+
+		alloc(h).destruct();
+		max_ns = std::max(max_ns, std::chrono::duration<double, std::nano>(t1 - t0).count());
+	}
+
+	state.counters["max_construct_ns"] = max_ns;
+
+	for(auto& e : v) alloc(e).destruct();
+}
+
+
+static void TEMPORARIES_salgo_vector(State& state) {
+	_temporaries< Array_Allocator<int> >(state);
+}
+BENCHMARK( TEMPORARIES_salgo_vector )->MinTime(0.1);
+
+
+static void TEMPORARIES_salgo_vector_bitmap(State& state) {
+	_temporaries< Array_Allocator<int> ::FREE_BITMAP >(state);
+}
+BENCHMARK( TEMPORARIES_salgo_vector_bitmap )->MinTime(0.1);
+
+
+
+
+
+
+
+//
+// fill an empty allocator with `GROWTH_Elements` elements
+//
+// a single block has to move all elements when it grows, so some construct() calls are O(n)
+//
+// reports the slowest construct() call, and the number of calls slower than 50us
+// (on a busy machine, some of them are just preemption)
+//
+
+static const int GROWTH_Elements = 1<<20;
+
+template<class ALLOC>
+static void _growth(State& state) {
+	srand(69); clear_cache();
+
+	double max_ns = 0;
+	int num_slow = 0;
+
+	for(auto _ : state) {
+		ALLOC alloc;
+		for(int i=0; i<GROWTH_Elements; ++i) {
+			auto t0 = std::chrono::steady_clock::now();
+			alloc.construct(i);
+			auto t1 = std::chrono::steady_clock::now();
+
+			double ns = std::chrono::duration<double, std::nano>(t1 - t0).count();
+			max_ns = std::max(max_ns, ns);
+			num_slow += ns > 50000;
+		}
+	}
+
+	state.counters["max_construct_ns"] = max_ns;
+	state.counters["slow_per_fill"] = (double)num_slow / state.iterations();
+	state.SetItemsProcessed( state.iterations() * GROWTH_Elements );
+}
+
+
+static void GROWTH_std(State& state) {
+	_growth< Salgo_From_Std_Allocator< std::allocator<int> > >(state);
+}
+BENCHMARK( GROWTH_std )->MinTime(0.1);
+
+
+static void GROWTH_salgo_vector(State& state) {
+	_growth< Array_Allocator<int> >(state);
+}
+BENCHMARK( GROWTH_salgo_vector )->MinTime(0.1);
+
+
+static void GROWTH_salgo_vector_stable(State& state) {
+	_growth< Array_Allocator<int> ::STABLE >(state);
+}
+BENCHMARK( GROWTH_salgo_vector_stable )->MinTime(0.1);
+
+
+
+
+
+
+
+//
+// build a small container, read it once, throw it away
+//
+// an arena skips per-node destruction - SHARED arenas are also reset() instead of freeing pages
+//
+
+static const int BUILD_DISCARD_Elements = 1<<10;
+
+template<class CONTAINER, class RESET>
+static void _build_discard_list(State& state, RESET&& reset) {
+	srand(69); clear_cache();
+
+	for(auto _ : state) {
+		{
+			CONTAINER list;
+			for(int i=0; i<BUILD_DISCARD_Elements; ++i) list.emplace_back(i);
+
+			int sum = 0;
+			for(auto& e : list) sum += e;
+			DoNotOptimize(sum);
+		}
+		reset();
+	}
+
+	state.SetItemsProcessed( state.iterations() * BUILD_DISCARD_Elements );
+}
+
+template<class CONTAINER, class RESET>
+static void _build_discard_hash(State& state, RESET&& reset) {
+	srand(69); clear_cache();
+
+	for(auto _ : state) {
+		{
+			CONTAINER set;
+			for(int i=0; i<BUILD_DISCARD_Elements; ++i) set.emplace( rand() );
+			DoNotOptimize( set(rand()).found() );
+		}
+		reset();
+	}
+
+	state.SetItemsProcessed( state.iterations() * BUILD_DISCARD_Elements );
+}
+
+namespace {
+	struct Build_Discard_Tag {};
+	using Shared_Arena = Arena_Allocator<int> ::SHARED<Build_Discard_Tag>;
+}
+
+
+static void BUILD_DISCARD_LIST_std(State& state) {
+	_build_discard_list< List<int> ::ALLOCATOR< Salgo_From_Std_Allocator< std::allocator<int> > > >(state, []{});
+}
+BENCHMARK( BUILD_DISCARD_LIST_std )->MinTime(0.1);
+
+
+static void BUILD_DISCARD_LIST_salgo_vector(State& state) {
+	_build_discard_list< List<int> ::ALLOCATOR< Array_Allocator<int> > >(state, []{});
+}
+BENCHMARK( BUILD_DISCARD_LIST_salgo_vector )->MinTime(0.1);
+
+
+static void BUILD_DISCARD_LIST_salgo_arena(State& state) {
+	_build_discard_list< List<int> ::ALLOCATOR< Arena_Allocator<int> > >(state, []{});
+}
+BENCHMARK( BUILD_DISCARD_LIST_salgo_arena )->MinTime(0.1);
+
+
+static void BUILD_DISCARD_LIST_salgo_arena_shared(State& state) {
+	_build_discard_list< List<int> ::ALLOCATOR< Shared_Arena > >(state, []{ Shared_Arena().reset(); });
+	Shared_Arena().release();
+}
+BENCHMARK( BUILD_DISCARD_LIST_salgo_arena_shared )->MinTime(0.1);
+
+
+static void BUILD_DISCARD_LIST_salgo_slab(State& state) {
+	_build_discard_list< List<int> ::ALLOCATOR< Slab_Allocator<int> > >(state, []{});
+}
+BENCHMARK( BUILD_DISCARD_LIST_salgo_slab )->MinTime(0.1);
+
+
+static void BUILD_DISCARD_HASH_std(State& state) {
+	_build_discard_hash< Hash_Table<int> ::EXTERNAL ::ALLOCATOR< Salgo_From_Std_Allocator< std::allocator<int> > > >(state, []{});
+}
+BENCHMARK( BUILD_DISCARD_HASH_std )->MinTime(0.1);
+
+
+static void BUILD_DISCARD_HASH_salgo_vector(State& state) {
+	_build_discard_hash< Hash_Table<int> ::EXTERNAL ::ALLOCATOR< Array_Allocator<int> > >(state, []{});
+}
+BENCHMARK( BUILD_DISCARD_HASH_salgo_vector )->MinTime(0.1);
+
+
+static void BUILD_DISCARD_HASH_salgo_arena(State& state) {
+	_build_discard_hash< Hash_Table<int> ::EXTERNAL ::ALLOCATOR< Arena_Allocator<int> > >(state, []{});
+}
+BENCHMARK( BUILD_DISCARD_HASH_salgo_arena )->MinTime(0.1);
+
+
+static void BUILD_DISCARD_HASH_salgo_slab(State& state) {
+	_build_discard_hash< Hash_Table<int> ::EXTERNAL ::ALLOCATOR< Slab_Allocator<int> > >(state, []{});
+}
+BENCHMARK( BUILD_DISCARD_HASH_salgo_slab )->MinTime(0.1);
+
+
+static void BUILD_DISCARD_HASH_salgo_arena_shared(State& state) {
+	_build_discard_hash< Hash_Table<int> ::EXTERNAL ::ALLOCATOR< Shared_Arena > >(state, []{ Shared_Arena().reset(); });
+	Shared_Arena().release();
+}
+BENCHMARK( BUILD_DISCARD_HASH_salgo_arena_shared )->MinTime(0.1);
+
+
+
+
+
+
 
 BENCHMARK_MAIN();
 
@@ -0,0 +1,185 @@
+#include "common.hpp"
+#include <benchmark/benchmark.h>
+
+#include <salgo/graph/binary-forest>
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+using namespace benchmark;
+
+using namespace salgo::graph;
+
+
+
+
+
+namespace {
+	auto rnd() {
+		return rand();
+	}
+
+	using Tree = Binary_Forest ::PARENT_LINKS ::CHILD_LINKS ::DATA<int>;
+	using Handle = Tree::Handle;
+
+	// unbalanced BST insert
+	template<class TREE>
+	void insert(TREE& tree, typename TREE::Handle root, int key) {
+		auto v = tree(root);
+		for(;;) {
+			if(key < v()) {
+				if(!v.has_left()) { v.emplace_left(key); return; }
+				v = v.left();
+			}
+			else {
+				if(!v.has_right()) { v.emplace_right(key); return; }
+				v = v.right();
+			}
+		}
+	}
+
+	// erase a leaf found by random descent
+	void erase_random_leaf(Tree& tree, Handle root) {
+		auto v = tree(root);
+		for(;;) {
+			bool l = v.has_left();
+			bool r = v.has_right();
+			if(!l && !r) break;
+			if(l && r) v = (rnd() & 1) ? v.left() : v.right();
+			else v = l ? v.left() : v.right();
+		}
+		DCHECK_NE(v.handle(), root);
+		v.unlink_and_erase();
+	}
+
+	// BST of `n` random keys, then `n` rounds of erasing a random leaf and inserting a new key
+	Handle build_churned(Tree& tree, int n) {
+		auto root = tree.emplace( RAND_MAX/2 ).handle();
+		for(int i=0; i<n; ++i) insert(tree, root, rnd());
+		for(int i=0; i<n; ++i) {
+			erase_random_leaf(tree, root);
+			insert(tree, root, rnd());
+		}
+		return root;
+	}
+
+	// preorder, explicit stack
+	template<class TREE, class HANDLE>
+	int sum_dfs(TREE& tree, HANDLE root, std::vector<HANDLE>& stack) {
+		int sum = 0;
+		stack.clear();
+		stack.emplace_back(root);
+		while(!stack.empty()) {
+			auto v = tree( stack.back() );
+			stack.pop_back();
+			sum += v();
+			if(v.has_right()) stack.emplace_back( v.right().handle() );
+			if(v.has_left())  stack.emplace_back( v.left().handle() );
+		}
+		return sum;
+	}
+}
+
+
+
+
+
+//
+// child nodes are constructed near their parents (`construct_near` hint),
+// which matters once erasures leave holes in the allocator
+//
+
+static void TRAVERSE_CHURNED_salgo(State& state) {
+	srand(69); clear_cache();
+
+	const int N = 1<<20;
+
+	Tree tree;
+	auto root = build_churned(tree, N);
+
+	std::vector<Handle> stack;
+	while( state.KeepRunningBatch( N+1 ) ) {
+		DoNotOptimize( sum_dfs(tree, root, stack) );
+	}
+}
+BENCHMARK( TRAVERSE_CHURNED_salgo )->MinTime(0.1);
+
+
+
+static void BUILD_CHURNED_salgo(State& state) {
+	srand(69); clear_cache();
+
+	const int N = 1<<18;
+
+	for(auto _ : state) {
+		Tree tree;
+		DoNotOptimize( build_churned(tree, N) );
+	}
+
+	state.SetItemsProcessed( state.iterations() * N * 2 );
+}
+BENCHMARK( BUILD_CHURNED_salgo )->MinTime(0.1);
+
+
+
+
+
+
+//
+// memory per node for different handle widths (`::HANDLE_INT<X>`)
+//
+// many small trees - each one fits 16-bit handles
+//
+
+template<class TREE>
+static void _memory_per_node(State& state) {
+	srand(69); clear_cache();
+
+	const int N = 1<<15;
+	const int K = 64;
+
+	using H = typename TREE::Handle;
+
+	auto rss_before = rss_bytes();
+
+	std::vector<TREE> trees(K);
+	std::vector<H> roots;
+	for(auto& tree : trees) {
+		roots.emplace_back( tree.emplace( RAND_MAX/2 ).handle() );
+		for(int i=1; i<N; ++i) insert(tree, roots.back(), rnd());
+	}
+
+	auto rss_after = rss_bytes();
+
+	std::vector<H> stack;
+	while( state.KeepRunningBatch( K*N ) ) {
+		for(int k=0; k<K; ++k) DoNotOptimize( sum_dfs(trees[k], roots[k], stack) );
+	}
+
+	state.counters["link_bytes"] = sizeof(typename TREE::Handle_Small);
+	state.counters["bytes_per_node"] = double(rss_after - rss_before) / (K*N);
+}
+
+static void MEMORY_PER_NODE_salgo_16(State& state) {
+	_memory_per_node< Tree ::HANDLE_INT<uint16_t> >(state);
+}
+BENCHMARK( MEMORY_PER_NODE_salgo_16 )->MinTime(0.1);
+
+static void MEMORY_PER_NODE_salgo_32(State& state) {
+	_memory_per_node< Tree >(state);
+}
+BENCHMARK( MEMORY_PER_NODE_salgo_32 )->MinTime(0.1);
+
+static void MEMORY_PER_NODE_salgo_64(State& state) {
+	_memory_per_node< Tree ::HANDLE_INT<int64_t> >(state);
+}
+BENCHMARK( MEMORY_PER_NODE_salgo_64 )->MinTime(0.1);
+
+
+
+
+
+
+BENCHMARK_MAIN();
+
@@ -1,7 +1,12 @@
 #pragma once
 
+#include <algorithm>
 #include <vector>
 #include <cstdlib>
+#include <fstream>
+#include <type_traits>
+#include <utility>
+#include <unistd.h>
 #include <benchmark/benchmark.h>
 
 namespace {
@@ -18,6 +23,46 @@ inline void clear_cache() {
 }
 
 
+// element count for benchmarks that build `max_iterations` elements, then process them in batches
+// capped to bound memory - with the cap, batches repeat over the same elements
+inline int bounded_size(const benchmark::State& state, int cap = 1<<21) {
+	return (int)std::min<benchmark::IterationCount>( state.max_iterations, cap );
+}
+
+
+// resident set size of the process (Linux only, 0 elsewhere)
+inline long long rss_bytes() {
+	std::ifstream statm("/proc/self/statm");
+	long long pages_total = 0, pages_resident = 0;
+	statm >> pages_total >> pages_resident;
+	return pages_resident * sysconf(_SC_PAGESIZE);
+}
+
+
+template<class ALLOC, class = void>
+struct Has_Stats : std::false_type {};
+
+template<class ALLOC>
+struct Has_Stats<ALLOC, std::void_t<decltype( std::declval<const ALLOC&>().stats() )>> : std::true_type {};
+
+// `stats()` of a `salgo::Instrumented` allocator, printed next to timings (no-op for other allocators)
+template<class ALLOC>
+void report_alloc_stats(benchmark::State& state, const ALLOC& alloc) {
+	if constexpr(Has_Stats<ALLOC>::value) {
+		auto s = alloc.stats();
+		state.counters["live"] = s.live;
+		state.counters["peak_live"] = s.peak_live;
+		state.counters["used_mb"] = s.bytes_used / 1e6;
+		state.counters["reserved_mb"] = s.bytes_reserved / 1e6;
+		state.counters["probe_avg"] = s.probes.average();
+		state.counters["probe_max"] = s.probes.max;
+	}
+	else {
+		(void)state; (void)alloc;
+	}
+}
+
+
 }
 
 
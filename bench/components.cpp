@@ -0,0 +1,130 @@
+#include "common.hpp"
+#include <benchmark/benchmark.h>
+
+#include <salgo/graph/graph>
+#include <salgo/graph/components>
+
+#include <algorithm>
+#include <vector>
+
+using namespace benchmark;
+
+using namespace salgo;
+using namespace salgo::graph;
+
+
+
+
+
+// directed RMAT (Graph500 parameters): 2^20 vertices, 2^23 edges - one giant SCC and many tiny ones
+static auto& rmat_graph() {
+	static Graph ::DIRECTED ::BACKLINKS g;
+	if(g.verts().is_empty()) {
+		srand(69);
+		const int scale = 20;
+		g = decltype(g)(1 << scale);
+
+		for(int i=0; i < (1 << (scale+3)); ++i) {
+			int a = 0, b = 0;
+			for(int bit=0; bit<scale; ++bit) {
+				int r = rand() % 100;
+				if(r < 57) {}
+				else if(r < 76) b |= 1 << bit;
+				else if(r < 95) a |= 1 << bit;
+				else { a |= 1 << bit; b |= 1 << bit; }
+			}
+			g.edges().add(a, b);
+		}
+	}
+	return g;
+}
+
+// random DAG: 2^20 vertices, 2^22 edges from lower to higher index
+static auto& dag() {
+	static Graph ::DIRECTED g;
+	if(g.verts().is_empty()) {
+		srand(69);
+		const int n = 1<<20;
+		g = decltype(g)(n);
+		for(int i=0; i < (n << 2); ++i) {
+			int a = rand() % n, b = rand() % n;
+			if(a != b) g.edges().add( std::min(a,b), std::max(a,b) );
+		}
+	}
+	return g;
+}
+
+// undirected 1024 x 1024 grid with 30% of edges missing - many bridges and articulation points
+static auto& sparse_grid() {
+	static Graph g;
+	if(g.verts().is_empty()) {
+		srand(69);
+		const int n = 1024;
+		g = Graph(n * n);
+		for(int y=0; y<n; ++y) {
+			for(int x=0; x<n; ++x) {
+				if(x+1 < n && rand() % 10 >= 3) g.edges().add(y*n + x, y*n + x+1);
+				if(y+1 < n && rand() % 10 >= 3) g.edges().add(y*n + x, (y+1)*n + x);
+			}
+		}
+	}
+	return g;
+}
+
+
+
+
+static void SCC_RMAT_graph(State& state) {
+	auto& g = rmat_graph();
+	clear_cache();
+	for(auto _ : state) DoNotOptimize( strongly_connected_components(g).count );
+	state.SetItemsProcessed( state.iterations() * g.verts().count() );
+}
+BENCHMARK( SCC_RMAT_graph )->Unit(benchmark::kMillisecond)->MinTime(0.1);
+
+static void SCC_RMAT_csr(State& state) {
+	auto csr = rmat_graph().freeze();
+	clear_cache();
+	for(auto _ : state) DoNotOptimize( strongly_connected_components(csr).count );
+	state.SetItemsProcessed( state.iterations() * csr.verts().count() );
+}
+BENCHMARK( SCC_RMAT_csr )->Unit(benchmark::kMillisecond)->MinTime(0.1);
+
+static void SCC_RMAT_csr_parallel(State& state) {
+	auto csr = rmat_graph().freeze();
+	clear_cache();
+	for(auto _ : state) DoNotOptimize( strongly_connected_components_parallel(csr).count );
+	state.SetItemsProcessed( state.iterations() * csr.verts().count() );
+}
+BENCHMARK( SCC_RMAT_csr_parallel )->Unit(benchmark::kMillisecond)->MinTime(0.1);
+
+
+static void TOPOLOGICAL_SORT_csr(State& state) {
+	auto csr = dag().freeze();
+	clear_cache();
+	for(auto _ : state) DoNotOptimize( topological_sort(csr).count() );
+	state.SetItemsProcessed( state.iterations() * csr.verts().count() );
+}
+BENCHMARK( TOPOLOGICAL_SORT_csr )->Unit(benchmark::kMillisecond)->MinTime(0.1);
+
+
+static void ARTICULATION_POINTS_csr(State& state) {
+	auto csr = sparse_grid().freeze();
+	clear_cache();
+	for(auto _ : state) DoNotOptimize( articulation_points(csr) );
+	state.SetItemsProcessed( state.iterations() * csr.verts().count() );
+}
+BENCHMARK( ARTICULATION_POINTS_csr )->Unit(benchmark::kMillisecond)->MinTime(0.1);
+
+static void BRIDGES_csr(State& state) {
+	auto csr = sparse_grid().freeze();
+	clear_cache();
+	for(auto _ : state) DoNotOptimize( bridges(csr).count() );
+	state.SetItemsProcessed( state.iterations() * csr.verts().count() );
+}
+BENCHMARK( BRIDGES_csr )->Unit(benchmark::kMillisecond)->MinTime(0.1);
+
+
+
+
+BENCHMARK_MAIN();
@@ -6,6 +6,7 @@
 #include <salgo/unordered-array>
 
 #include <vector>
+#include <algorithm>
 
 using namespace benchmark;
 
@@ -347,6 +348,121 @@ BENCHMARK( FOREACH_ACCESS_REV_salgo_unordered )->Arg(1'000'000)->Unit(benchmark:
 
 
 
+//
+// range(0) is percent of erased elements
+//
+#define FILTER_BENCHMARK(NAME) BENCHMARK( NAME )->Arg(10)->Arg(50)->Arg(90)->Unit(benchmark::kMicrosecond)->MinTime(0.1)
+
+namespace {
+	std::vector<int> filter_input() {
+		std::vector<int> v( 1'000'000 );
+		for(auto& e : v) e = rnd();
+		return v;
+	}
+}
+
+
+static void ERASE_IF_std(State& state) {
+	srand(69); clear_cache();
+
+	const auto input = filter_input();
+	const int percent = state.range(0);
+
+	for(auto _ : state) {
+		state.PauseTiming();
+		auto v = input;
+		state.ResumeTiming();
+
+		v.erase( std::remove_if(v.begin(), v.end(), [percent](int x){ return x % 100 < percent; }), v.end() );
+		DoNotOptimize(v.data());
+	}
+}
+FILTER_BENCHMARK( ERASE_IF_std );
+
+
+static void ERASE_IF_salgo(State& state) {
+	srand(69); clear_cache();
+
+	const auto input = filter_input();
+	const int percent = state.range(0);
+
+	for(auto _ : state) {
+		state.PauseTiming();
+		salgo::Dynamic_Array<int> v;
+		v.reserve( input.size() );
+		for(auto& e : input) v.emplace_back(e);
+		state.ResumeTiming();
+
+		auto erased = v.erase_if( [percent](int x){ return x % 100 < percent; } );
+		DoNotOptimize(erased);
+	}
+}
+FILTER_BENCHMARK( ERASE_IF_salgo );
+
+
+static void ERASE_IF_salgo_unordered(State& state) {
+	srand(69); clear_cache();
+
+	const auto input = filter_input();
+	const int percent = state.range(0);
+
+	for(auto _ : state) {
+		state.PauseTiming();
+		salgo::Unordered_Array<int> v;
+		v.reserve( input.size() );
+		for(auto& e : input) v.add(e);
+		state.ResumeTiming();
+
+		auto erased = v.erase_if( [percent](int x){ return x % 100 < percent; } );
+		DoNotOptimize(erased);
+	}
+}
+FILTER_BENCHMARK( ERASE_IF_salgo_unordered );
+
+
+
+
+static void PARTITION_std(State& state) {
+	srand(69); clear_cache();
+
+	const auto input = filter_input();
+	const int percent = state.range(0);
+
+	for(auto _ : state) {
+		state.PauseTiming();
+		auto v = input;
+		state.ResumeTiming();
+
+		auto it = std::stable_partition(v.begin(), v.end(), [percent](int x){ return x % 100 >= percent; });
+		DoNotOptimize(it);
+	}
+}
+FILTER_BENCHMARK( PARTITION_std );
+
+
+static void PARTITION_salgo(State& state) {
+	srand(69); clear_cache();
+
+	const auto input = filter_input();
+	const int percent = state.range(0);
+
+	for(auto _ : state) {
+		state.PauseTiming();
+		salgo::Dynamic_Array<int> v;
+		v.reserve( input.size() );
+		for(auto& e : input) v.emplace_back(e);
+		state.ResumeTiming();
+
+		auto n = v.partition( [percent](int x){ return x % 100 >= percent; } );
+		DoNotOptimize(n);
+	}
+}
+FILTER_BENCHMARK( PARTITION_salgo );
+
+
+
+
+
 
 
 
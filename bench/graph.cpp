@@ -0,0 +1,238 @@
+#include "common.hpp"
+#include <benchmark/benchmark.h>
+
+#include <salgo/graph/graph>
+#include <salgo/graph/traversal>
+
+#include <vector>
+
+using namespace benchmark;
+
+using namespace salgo;
+using namespace salgo::graph;
+
+
+
+
+
+//
+// BFS over a random undirected graph: 2^20 vertices, 2^22 edges
+//
+// Graph keeps a separate adjacency array per vertex, Csr_Graph (from freeze()) one contiguous array
+//
+
+static const int Verts = 1<<20;
+static const int Edges = 1<<22;
+
+static auto& random_graph() {
+	static Graph g;
+	if(g.verts().is_empty()) {
+		srand(69);
+		g = Graph(Verts);
+
+		// edges are added in random order, so adjacency arrays are scattered over the heap
+		for(int i=0; i<Edges; ++i) g.edges().add( rand() % Verts, rand() % Verts );
+	}
+	return g;
+}
+
+
+// same code for Graph and Csr_Graph
+template<class G>
+static int bfs(G& g, std::vector<int>& dist, std::vector<int>& queue) {
+	std::fill(dist.begin(), dist.end(), -1);
+	queue.clear();
+
+	dist[0] = 0;
+	queue.push_back(0);
+
+	for(int i=0; i<(int)queue.size(); ++i) {
+		int v = queue[i];
+		for(auto& e : g.vert(v).outs()) {
+			int u = e.vert().handle();
+			if(dist[u] == -1) {
+				dist[u] = dist[v] + 1;
+				queue.push_back(u);
+			}
+		}
+	}
+
+	return queue.size();
+}
+
+
+static void BFS_graph(State& state) {
+	auto& g = random_graph();
+	std::vector<int> dist(Verts), queue;
+	clear_cache();
+
+	for(auto _ : state) {
+		DoNotOptimize( bfs(g, dist, queue) );
+	}
+
+	state.SetItemsProcessed( state.iterations() * 2 * Edges );
+}
+BENCHMARK( BFS_graph )->Unit(benchmark::kMillisecond)->MinTime(0.1);
+
+
+static void BFS_csr_graph(State& state) {
+	auto csr = random_graph().freeze();
+	std::vector<int> dist(Verts), queue;
+	clear_cache();
+
+	for(auto _ : state) {
+		DoNotOptimize( bfs(csr, dist, queue) );
+	}
+
+	state.SetItemsProcessed( state.iterations() * 2 * Edges );
+}
+BENCHMARK( BFS_csr_graph )->Unit(benchmark::kMillisecond)->MinTime(0.1);
+
+
+// hand-written loop over the raw arrays
+static void BFS_csr_graph_raw(State& state) {
+	auto csr = random_graph().freeze();
+	std::vector<int> dist(Verts), queue;
+	clear_cache();
+
+	auto offsets = csr.out_offsets();
+	auto targets = csr.out_targets();
+
+	for(auto _ : state) {
+		std::fill(dist.begin(), dist.end(), -1);
+		queue.clear();
+
+		dist[0] = 0;
+		queue.push_back(0);
+
+		for(int i=0; i<(int)queue.size(); ++i) {
+			int v = queue[i];
+			for(int j=offsets[v]; j<offsets[v+1]; ++j) {
+				int u = targets[j];
+				if(dist[u] == -1) {
+					dist[u] = dist[v] + 1;
+					queue.push_back(u);
+				}
+			}
+		}
+
+		DoNotOptimize( queue.size() );
+	}
+
+	state.SetItemsProcessed( state.iterations() * 2 * Edges );
+}
+BENCHMARK( BFS_csr_graph_raw )->Unit(benchmark::kMillisecond)->MinTime(0.1);
+
+
+static void FREEZE(State& state) {
+	auto& g = random_graph();
+	clear_cache();
+
+	for(auto _ : state) {
+		auto csr = g.freeze();
+		DoNotOptimize( csr );
+	}
+
+	state.SetItemsProcessed( state.iterations() * 2 * Edges );
+}
+BENCHMARK( FREEZE )->Unit(benchmark::kMillisecond)->MinTime(0.1);
+
+
+
+
+
+
+//
+// traversal engines (salgo/graph/traversal) on generated graphs
+//
+
+// RMAT (Graph500 parameters): 2^19 vertices, 2^22 edges, skewed degrees and small diameter
+static auto& rmat_graph() {
+	static Graph g;
+	if(g.verts().is_empty()) {
+		srand(69);
+		const int scale = 19;
+		g = Graph(1 << scale);
+
+		for(int i=0; i < (1 << (scale+3)); ++i) {
+			int a = 0, b = 0;
+			for(int bit=0; bit<scale; ++bit) {
+				int r = rand() % 100;
+				if(r < 57) {}                           // a = 0.57
+				else if(r < 76) b |= 1 << bit;          // b = 0.19
+				else if(r < 95) a |= 1 << bit;          // c = 0.19
+				else { a |= 1 << bit; b |= 1 << bit; }  // d = 0.05
+			}
+			g.edges().add(a, b);
+		}
+	}
+	return g;
+}
+
+// 1024 x 1024 grid: large diameter, small frontiers
+static auto& grid_graph() {
+	static Graph g;
+	if(g.verts().is_empty()) {
+		const int n = 1024;
+		g = Graph(n * n);
+		for(int y=0; y<n; ++y) {
+			for(int x=0; x<n; ++x) {
+				if(x+1 < n) g.edges().add(y*n + x, y*n + x+1);
+				if(y+1 < n) g.edges().add(y*n + x, (y+1)*n + x);
+			}
+		}
+	}
+	return g;
+}
+
+
+template<class G>
+static void _bfs(State& state, G& g, bool direction_optimizing) {
+	clear_cache();
+
+	for(auto _ : state) {
+		int visited = salgo::graph::bfs(g, 0, DIRECTION_OPTIMIZING = direction_optimizing);
+		DoNotOptimize( visited );
+	}
+
+	state.SetItemsProcessed( state.iterations() * g.verts().count() );
+}
+
+static void BFS_RMAT_graph(State& state) { _bfs(state, rmat_graph(), false); }
+BENCHMARK( BFS_RMAT_graph )->Unit(benchmark::kMillisecond)->MinTime(0.1);
+
+static void BFS_RMAT_csr_top_down(State& state) { auto csr = rmat_graph().freeze(); _bfs(state, csr, false); }
+BENCHMARK( BFS_RMAT_csr_top_down )->Unit(benchmark::kMillisecond)->MinTime(0.1);
+
+static void BFS_RMAT_csr_direction_optimizing(State& state) { auto csr = rmat_graph().freeze(); _bfs(state, csr, true); }
+BENCHMARK( BFS_RMAT_csr_direction_optimizing )->Unit(benchmark::kMillisecond)->MinTime(0.1);
+
+static void BFS_GRID_csr_top_down(State& state) { auto csr = grid_graph().freeze(); _bfs(state, csr, false); }
+BENCHMARK( BFS_GRID_csr_top_down )->Unit(benchmark::kMillisecond)->MinTime(0.1);
+
+static void BFS_GRID_csr_direction_optimizing(State& state) { auto csr = grid_graph().freeze(); _bfs(state, csr, true); }
+BENCHMARK( BFS_GRID_csr_direction_optimizing )->Unit(benchmark::kMillisecond)->MinTime(0.1);
+
+
+template<class G>
+static void _dfs(State& state, G& g) {
+	clear_cache();
+
+	for(auto _ : state) {
+		int visited = salgo::graph::dfs(g, 0);
+		DoNotOptimize( visited );
+	}
+
+	state.SetItemsProcessed( state.iterations() * g.verts().count() );
+}
+
+static void DFS_RMAT_csr(State& state) { auto csr = rmat_graph().freeze(); _dfs(state, csr); }
+BENCHMARK( DFS_RMAT_csr )->Unit(benchmark::kMillisecond)->MinTime(0.1);
+
+static void DFS_GRID_csr(State& state) { auto csr = grid_graph().freeze(); _dfs(state, csr); }
+BENCHMARK( DFS_GRID_csr )->Unit(benchmark::kMillisecond)->MinTime(0.1);
+
+
+
+
+BENCHMARK_MAIN();
@@ -0,0 +1,233 @@
+#include "common.hpp"
+#include <benchmark/benchmark.h>
+
+#include <salgo/heap>
+#include <salgo/pairing-heap>
+#include <salgo/hash-table>
+
+#include <functional>
+#include <map>
+#include <queue>
+#include <vector>
+
+using namespace benchmark;
+
+using namespace salgo;
+
+
+
+
+
+// push N random values, then pop all
+static const int N = 1 << 20;
+
+static void PUSH_POP_std_priority_queue(State& state) {
+	srand(69); clear_cache();
+	std::priority_queue<int, std::vector<int>, std::greater<int>> q;
+
+	while( state.KeepRunningBatch(N) ) {
+		for(int i=0; i<N; ++i) q.push( rand() );
+		while(!q.empty()) {
+			DoNotOptimize( q.top() );
+			q.pop();
+		}
+	}
+}
+BENCHMARK( PUSH_POP_std_priority_queue )->MinTime(0.1);
+
+static void PUSH_POP_std_multimap(State& state) {
+	srand(69); clear_cache();
+	std::multimap<int,int> q;
+
+	while( state.KeepRunningBatch(N) ) {
+		for(int i=0; i<N; ++i) q.emplace( rand(), i );
+		while(!q.empty()) {
+			DoNotOptimize( q.begin()->first );
+			q.erase( q.begin() );
+		}
+	}
+}
+BENCHMARK( PUSH_POP_std_multimap )->MinTime(0.1);
+
+template<class HEAP>
+static void _push_pop(State& state) {
+	srand(69); clear_cache();
+	HEAP q;
+
+	while( state.KeepRunningBatch(N) ) {
+		for(int i=0; i<N; ++i) q.push( rand() );
+		while(q.not_empty()) {
+			DoNotOptimize( q.top() );
+			q.pop();
+		}
+	}
+}
+
+static void PUSH_POP_salgo_heap_2(State& state) { _push_pop< Heap<int> ::ARITY<2> >(state); }
+BENCHMARK( PUSH_POP_salgo_heap_2 )->MinTime(0.1);
+
+static void PUSH_POP_salgo_heap_4(State& state) { _push_pop< Heap<int> >(state); }
+BENCHMARK( PUSH_POP_salgo_heap_4 )->MinTime(0.1);
+
+static void PUSH_POP_salgo_pairing_heap(State& state) { _push_pop< Pairing_Heap<int> >(state); }
+BENCHMARK( PUSH_POP_salgo_pairing_heap )->MinTime(0.1);
+
+
+
+
+
+// Dijkstra-like: pop the top, decrease keys of 8 random elements
+static const int M = 1 << 16;
+
+static void DECREASE_KEY_std_multimap(State& state) {
+	srand(69); clear_cache();
+
+	std::multimap<int,int> q;
+	std::vector<std::multimap<int,int>::iterator> where(M);
+	for(int i=0; i<M; ++i) where[i] = q.emplace( rand(), i );
+
+	for(auto _ : state) {
+		auto top = q.begin();
+		int id = top->second;
+		int key = top->first;
+		q.erase(top);
+		where[id] = q.emplace( key + rand() % (1<<20), id );
+
+		for(int j=0; j<8; ++j) {
+			int i = rand() % M;
+			int k = where[i]->first;
+			if(k <= key) continue;
+			q.erase( where[i] );
+			where[i] = q.emplace( key + (k - key) / 2, i );
+		}
+	}
+}
+BENCHMARK( DECREASE_KEY_std_multimap )->MinTime(0.1);
+
+template<class HEAP>
+static void _decrease_key(State& state) {
+	srand(69); clear_cache();
+
+	HEAP q;
+	std::vector<typename HEAP::Handle> where(M);
+	for(int i=0; i<M; ++i) where[i] = q.push( rand() ).handle();
+
+	for(auto _ : state) {
+		auto top = q(FIRST);
+		int key = top();
+		top.update( key + rand() % (1<<20) );
+
+		for(int j=0; j<8; ++j) {
+			int i = rand() % M;
+			int k = q[ where[i] ];
+			if(k <= key) continue;
+			q.decrease_key( where[i], key + (k - key) / 2 );
+		}
+	}
+}
+
+static void DECREASE_KEY_salgo_heap(State& state) { _decrease_key< Heap<int> >(state); }
+BENCHMARK( DECREASE_KEY_salgo_heap )->MinTime(0.1);
+
+static void DECREASE_KEY_salgo_pairing_heap(State& state) { _decrease_key< Pairing_Heap<int> >(state); }
+BENCHMARK( DECREASE_KEY_salgo_pairing_heap )->MinTime(0.1);
+
+
+
+
+
+// access pattern of `g3d::cap_hole()`: a ring of candidates, each step takes the best one,
+// erases it and its 2 neighbours, and adds 2 new ones
+//
+// `where` is a Hash_Table from ring element to its queue position, as in `cap_hole()`
+static const int Ring = 1 << 16;
+
+struct Ring_List {
+	std::vector<int> prev, next;
+
+	Ring_List() : prev(Ring), next(Ring) {
+		for(int i=0; i<Ring; ++i) {
+			prev[i] = (i + Ring - 1) % Ring;
+			next[i] = (i + 1) % Ring;
+		}
+	}
+
+	// remove `curr` and `next(curr)`, insert a new element in their place (reuses `curr`'s id)
+	int replace(int curr) {
+		int nx = next[curr];
+		int nn = next[nx];
+		next[curr] = nn;
+		prev[nn] = curr;
+		return curr;
+	}
+};
+
+static void CAP_HOLE_std_multimap(State& state) {
+	srand(69); clear_cache();
+
+	while( state.KeepRunningBatch(Ring - 3) ) {
+		state.PauseTiming();
+		Ring_List ring;
+		std::multimap<double, int> cands;
+		Hash_Table<int, std::multimap<double,int>::iterator> where;
+		state.ResumeTiming();
+
+		for(int i=0; i<Ring; ++i) where.emplace(i, cands.emplace( rand() / (double)RAND_MAX, i ));
+
+		for(int left = Ring; left > 3; --left) {
+			auto best = std::prev( cands.end() );
+			int curr = best->second;
+			int pr = ring.prev[curr];
+			int nx = ring.next[curr];
+
+			for(int e : {pr, curr, nx}) {
+				auto it = where(e);
+				cands.erase( it.val() );
+				it.erase();
+			}
+
+			int added = ring.replace(curr);
+			for(int e : {pr, added}) where.emplace(e, cands.emplace( rand() / (double)RAND_MAX, e ));
+		}
+	}
+}
+BENCHMARK( CAP_HOLE_std_multimap )->MinTime(0.1);
+
+static void CAP_HOLE_salgo_heap(State& state) {
+	srand(69); clear_cache();
+
+	struct Cand { double score; int e; };
+	struct Better_Score { bool operator()(const Cand& a, const Cand& b) const { return a.score > b.score; } };
+	using Q = Heap<Cand> ::COMPARE<Better_Score>;
+
+	while( state.KeepRunningBatch(Ring - 3) ) {
+		state.PauseTiming();
+		Ring_List ring;
+		Q cands;
+		Hash_Table<int, Q::Handle> where;
+		state.ResumeTiming();
+
+		for(int i=0; i<Ring; ++i) where.emplace(i, cands.push( Cand{rand() / (double)RAND_MAX, i} ).handle());
+
+		for(int left = Ring; left > 3; --left) {
+			int curr = cands.top().e;
+			int pr = ring.prev[curr];
+			int nx = ring.next[curr];
+
+			for(int e : {pr, curr, nx}) {
+				auto it = where(e);
+				cands.erase( it.val() );
+				it.erase();
+			}
+
+			int added = ring.replace(curr);
+			for(int e : {pr, added}) where.emplace(e, cands.push( Cand{rand() / (double)RAND_MAX, e} ).handle());
+		}
+	}
+}
+BENCHMARK( CAP_HOLE_salgo_heap )->MinTime(0.1);
+
+
+
+
+BENCHMARK_MAIN();
@@ -8,6 +8,7 @@
 #include <salgo/alloc/array-allocator>
 
 #include <list>
+#include <vector>
 
 using namespace benchmark;
 
@@ -339,6 +340,30 @@ BENCHMARK( ITERATE_salgo_countable_vectoralloc )->MinTime(0.1);
 
 
 
+static void ITERATE_salgo_countable_unrolled(State& state) {
+	srand(69); clear_cache();
+
+	const int N = bounded_size(state);
+
+	salgo::List<int> ::COUNTABLE ::UNROLLED<16> li;
+
+	for(int i=0; i<N; ++i) {
+		li.emplace_back( rnd() );
+		li.emplace_front( rnd() );
+	}
+
+	while( state.KeepRunningBatch( li.count() ) ) {
+		int sum = 0;
+		for(auto& e : li) sum += e;
+		DoNotOptimize(sum);
+	}
+}
+BENCHMARK( ITERATE_salgo_countable_unrolled )->MinTime(0.1);
+
+
+
+
+
 
 
 
@@ -428,6 +453,241 @@ BENCHMARK( INSERT_salgo )->MinTime(0.1);
 
 
 
+static void INSERT_salgo_unrolled(State& state) {
+	srand(69); clear_cache();
+
+	salgo::List<int> ::UNROLLED<16> li;
+
+	for(auto _ : state) {
+		li.emplace_back( rnd() );
+		li.emplace_front( rnd() );
+	}
+}
+BENCHMARK( INSERT_salgo_unrolled )->MinTime(0.1);
+
+
+
+
+
+
+
+
+
+//
+// lists built by inserting after random existing elements
+//
+
+static void INSERT_SCATTERED_std(State& state) {
+	srand(69); clear_cache();
+
+	std::list<int> li = {0};
+	std::vector<std::list<int>::iterator> its = { li.begin() };
+
+	for(auto _ : state) {
+		its.emplace_back( li.emplace( std::next(its[ rnd() % its.size() ]), rnd() ) );
+	}
+}
+BENCHMARK( INSERT_SCATTERED_std )->MinTime(0.1);
+
+
+static void INSERT_SCATTERED_salgo(State& state) {
+	srand(69); clear_cache();
+
+	salgo::List<int> li = {0};
+	std::vector<decltype(li)::Handle> hs = { li(FIRST) };
+
+	for(auto _ : state) {
+		hs.emplace_back( li( hs[ rnd() % hs.size() ] ).emplace_after( rnd() ).handle() );
+	}
+}
+BENCHMARK( INSERT_SCATTERED_salgo )->MinTime(0.1);
+
+
+static void INSERT_SCATTERED_salgo_unrolled(State& state) {
+	srand(69); clear_cache();
+
+	salgo::List<int> ::UNROLLED<16> li = {0};
+	std::vector<decltype(li)::Handle> hs = { li(FIRST) };
+
+	for(auto _ : state) {
+		hs.emplace_back( li( hs[ rnd() % hs.size() ] ).emplace_after( rnd() ).handle() );
+	}
+}
+BENCHMARK( INSERT_SCATTERED_salgo_unrolled )->MinTime(0.1);
+
+
+
+
+static void ITERATE_SCATTERED_std(State& state) {
+	srand(69); clear_cache();
+
+	const int N = bounded_size(state);
+
+	std::list<int> li = {0};
+	std::vector<std::list<int>::iterator> its = { li.begin() };
+	for(int i=0; i<N; ++i) {
+		its.emplace_back( li.emplace( std::next(its[ rnd() % its.size() ]), rnd() ) );
+	}
+
+	while( state.KeepRunningBatch( li.size() ) ) {
+		int sum = 0;
+		for(auto& e : li) sum += e;
+		DoNotOptimize(sum);
+	}
+}
+BENCHMARK( ITERATE_SCATTERED_std )->MinTime(0.1);
+
+
+static void ITERATE_SCATTERED_salgo(State& state) {
+	srand(69); clear_cache();
+
+	const int N = bounded_size(state);
+
+	salgo::List<int> ::COUNTABLE li = {0};
+	std::vector<decltype(li)::Handle> hs = { li(FIRST) };
+	for(int i=0; i<N; ++i) {
+		hs.emplace_back( li( hs[ rnd() % hs.size() ] ).emplace_after( rnd() ).handle() );
+	}
+
+	while( state.KeepRunningBatch( li.count() ) ) {
+		int sum = 0;
+		for(auto& e : li) sum += e;
+		DoNotOptimize(sum);
+	}
+}
+BENCHMARK( ITERATE_SCATTERED_salgo )->MinTime(0.1);
+
+
+static void ITERATE_SCATTERED_salgo_unrolled(State& state) {
+	srand(69); clear_cache();
+
+	const int N = bounded_size(state);
+
+	salgo::List<int> ::COUNTABLE ::UNROLLED<16> li = {0};
+	std::vector<decltype(li)::Handle> hs = { li(FIRST) };
+	for(int i=0; i<N; ++i) {
+		hs.emplace_back( li( hs[ rnd() % hs.size() ] ).emplace_after( rnd() ).handle() );
+	}
+
+	while( state.KeepRunningBatch( li.count() ) ) {
+		int sum = 0;
+		for(auto& e : li) sum += e;
+		DoNotOptimize(sum);
+	}
+}
+BENCHMARK( ITERATE_SCATTERED_salgo_unrolled )->MinTime(0.1);
+
+
+static void ITERATE_SCATTERED_salgo_linearized(State& state) {
+	srand(69); clear_cache();
+
+	const int N = bounded_size(state);
+
+	salgo::List<int> ::COUNTABLE li = {0};
+	std::vector<decltype(li)::Handle> hs = { li(FIRST) };
+	for(int i=0; i<N; ++i) {
+		hs.emplace_back( li( hs[ rnd() % hs.size() ] ).emplace_after( rnd() ).handle() );
+	}
+
+	li.linearize();
+
+	while( state.KeepRunningBatch( li.count() ) ) {
+		int sum = 0;
+		for(auto& e : li) sum += e;
+		DoNotOptimize(sum);
+	}
+}
+BENCHMARK( ITERATE_SCATTERED_salgo_linearized )->MinTime(0.1);
+
+
+static void LINEARIZE_SCATTERED_salgo(State& state) {
+	srand(69); clear_cache();
+
+	const int N = 1<<20;
+
+	for(auto _ : state) {
+		state.PauseTiming();
+		salgo::List<int> li = {0};
+		std::vector<decltype(li)::Handle> hs = { li(FIRST) };
+		for(int i=0; i<N; ++i) {
+			hs.emplace_back( li( hs[ rnd() % hs.size() ] ).emplace_after( rnd() ).handle() );
+		}
+		state.ResumeTiming();
+
+		li.linearize();
+
+		state.PauseTiming();
+		li.clear();
+		state.ResumeTiming();
+	}
+
+	state.SetItemsProcessed( state.iterations() * N );
+}
+BENCHMARK( LINEARIZE_SCATTERED_salgo )->MinTime(0.1);
+
+
+
+
+
+//
+// lists after many random erase + insert-after-random-element rounds:
+// `emplace_after` places new nodes near their predecessors (`construct_near` hint)
+//
+
+static void ITERATE_CHURNED_std(State& state) {
+	srand(69); clear_cache();
+
+	const int N = 1<<20;
+
+	std::list<int> li;
+	std::vector<std::list<int>::iterator> its;
+	for(int i=0; i<N; ++i) its.emplace_back( li.emplace( li.end(), rnd() ) );
+
+	for(int i=0; i<4*N; ++i) {
+		int idx = rnd() % its.size();
+		li.erase( its[idx] );
+		its[idx] = its.back();
+		its.pop_back();
+		its.emplace_back( li.emplace( std::next(its[ rnd() % its.size() ]), rnd() ) );
+	}
+
+	while( state.KeepRunningBatch( li.size() ) ) {
+		int sum = 0;
+		for(auto& e : li) sum += e;
+		DoNotOptimize(sum);
+	}
+}
+BENCHMARK( ITERATE_CHURNED_std )->MinTime(0.1);
+
+
+static void ITERATE_CHURNED_salgo(State& state) {
+	srand(69); clear_cache();
+
+	const int N = 1<<20;
+
+	salgo::List<int> ::COUNTABLE li;
+	std::vector<decltype(li)::Handle> hs;
+	for(int i=0; i<N; ++i) hs.emplace_back( li.emplace_back( rnd() ).handle() );
+
+	for(int i=0; i<4*N; ++i) {
+		int idx = rnd() % hs.size();
+		li( hs[idx] ).erase();
+		hs[idx] = hs.back();
+		hs.pop_back();
+		hs.emplace_back( li( hs[ rnd() % hs.size() ] ).emplace_after( rnd() ).handle() );
+	}
+
+	while( state.KeepRunningBatch( li.count() ) ) {
+		int sum = 0;
+		for(auto& e : li) sum += e;
+		DoNotOptimize(sum);
+	}
+}
+BENCHMARK( ITERATE_CHURNED_salgo )->MinTime(0.1);
+
+
+
+
 
 
 
@@ -602,6 +862,89 @@ BENCHMARK( ERASE_salgo_countable_vectoralloc )->MinTime(0.1);
 
 
 
+//
+// sort whole list of `state.range(0)` elements
+//
+// list is rebuilt before each sort
+//
+
+static void SORT_std(State& state) {
+	srand(69); clear_cache();
+
+	const int N = state.range(0);
+
+	for(auto _ : state) {
+		state.PauseTiming();
+		std::list<int> li;
+		for(int i=0; i<N; ++i) li.emplace_back( rnd() );
+		state.ResumeTiming();
+
+		li.sort();
+
+		state.PauseTiming();
+		li.clear();
+		state.ResumeTiming();
+	}
+
+	state.SetItemsProcessed( state.iterations() * N );
+}
+BENCHMARK( SORT_std )->Arg(1000)->Arg(1000000)->MinTime(0.1);
+
+
+static void SORT_salgo(State& state) {
+	srand(69); clear_cache();
+
+	const int N = state.range(0);
+
+	for(auto _ : state) {
+		state.PauseTiming();
+		salgo::List<int> li;
+		for(int i=0; i<N; ++i) li.emplace_back( rnd() );
+		state.ResumeTiming();
+
+		li.sort();
+
+		state.PauseTiming();
+		li.clear();
+		state.ResumeTiming();
+	}
+
+	state.SetItemsProcessed( state.iterations() * N );
+}
+BENCHMARK( SORT_salgo )->Arg(1000)->Arg(1000000)->MinTime(0.1);
+
+
+static void SORT_salgo_crudealloc(State& state) {
+	srand(69); clear_cache();
+
+	const int N = state.range(0);
+
+	for(auto _ : state) {
+		state.PauseTiming();
+		using Alloc = Crude_Allocator<int>;
+		salgo::List<int> ::ALLOCATOR<Alloc> li;
+		for(int i=0; i<N; ++i) li.emplace_back( rnd() );
+		state.ResumeTiming();
+
+		li.sort();
+
+		state.PauseTiming();
+		li.clear();
+		state.ResumeTiming();
+	}
+
+	state.SetItemsProcessed( state.iterations() * N );
+}
+BENCHMARK( SORT_salgo_crudealloc )->Arg(1000)->Arg(1000000)->MinTime(0.1);
+
+
+
+
+
+
+
+
+
 BENCHMARK_MAIN();
 
 
@@ -0,0 +1,143 @@
+#include "common.hpp"
+#include <benchmark/benchmark.h>
+
+#include <salgo/graph/graph>
+#include <salgo/graph/max-flow>
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+using namespace benchmark;
+
+using namespace salgo;
+using namespace salgo::graph;
+
+
+
+
+
+using Flow_Graph = Graph ::DIRECTED ::EDGE_DATA<int>;
+
+struct Instance {
+	Flow_Graph g;
+	int source;
+	int sink;
+};
+
+
+// GENRMF (DIMACS challenge generator): `b` frames of `a` x `a` grids
+//
+// grid edges inside a frame have capacity c2*a*a, frames are connected by random permutations with
+// capacities in [c1,c2]; source is a corner of the first frame, sink the opposite corner of the last one
+static auto genrmf(int a, int b, int c1, int c2) {
+	srand(69);
+	Instance inst;
+	inst.g = Flow_Graph(a*a*b);
+	auto id = [&](int x, int y, int z) { return z*a*a + y*a + x; };
+
+	std::vector<int> perm(a*a);
+	for(int z=0; z<b; ++z) {
+		for(int y=0; y<a; ++y) {
+			for(int x=0; x<a; ++x) {
+				if(x+1 < a) { inst.g.edges().add(id(x,y,z), id(x+1,y,z), c2*a*a); inst.g.edges().add(id(x+1,y,z), id(x,y,z), c2*a*a); }
+				if(y+1 < a) { inst.g.edges().add(id(x,y,z), id(x,y+1,z), c2*a*a); inst.g.edges().add(id(x,y+1,z), id(x,y,z), c2*a*a); }
+			}
+		}
+
+		if(z+1 < b) {
+			std::iota(perm.begin(), perm.end(), 0);
+			for(int i=a*a-1; i>0; --i) std::swap(perm[i], perm[rand() % (i+1)]);
+			for(int i=0; i<a*a; ++i) inst.g.edges().add(z*a*a + i, (z+1)*a*a + perm[i], c1 + rand() % (c2-c1+1));
+		}
+	}
+
+	inst.source = 0;
+	inst.sink = a*a*b - 1;
+	return inst;
+}
+
+// long: 2^14 vertices in 64 frames of 16 x 16
+static auto& genrmf_long() {
+	static Instance inst = genrmf(16, 64, 1, 10000);
+	return inst;
+}
+
+// wide: 2^14 vertices in 4 frames of 64 x 64
+static auto& genrmf_wide() {
+	static Instance inst = genrmf(64, 4, 1, 10000);
+	return inst;
+}
+
+// bipartite matching: 2^16 + 2^16 vertices, 8 random edges per left vertex, unit capacities
+static auto& matching() {
+	static Instance inst;
+	if(inst.g.verts().is_empty()) {
+		srand(69);
+		const int n = 1<<16;
+		inst.source = 2*n;
+		inst.sink = 2*n + 1;
+		inst.g = Flow_Graph(2*n + 2);
+		for(int i=0; i<n; ++i) {
+			inst.g.edges().add(inst.source, i, 1);
+			inst.g.edges().add(n + i, inst.sink, 1);
+			for(int j=0; j<8; ++j) inst.g.edges().add(i, n + rand() % n, 1);
+		}
+	}
+	return inst;
+}
+
+
+static auto capacity = [](auto& out) { return (long long)out.edge().data(); };
+
+enum class Algo { DINIC, PUSH_RELABEL, MIN_CUT };
+
+static void _run(State& state, Instance& inst, Algo algo) {
+	auto csr = inst.g.freeze();
+	clear_cache();
+
+	for(auto _ : state) {
+		switch(algo) {
+			case Algo::DINIC: DoNotOptimize( max_flow(csr, inst.source, inst.sink, capacity).value ); break;
+			case Algo::PUSH_RELABEL: DoNotOptimize( max_flow_push_relabel(csr, inst.source, inst.sink, capacity).value ); break;
+			case Algo::MIN_CUT: DoNotOptimize( min_cut(csr, inst.source, inst.sink, capacity).value ); break;
+		}
+	}
+
+	state.SetItemsProcessed( state.iterations() * csr.num_edges() );
+}
+
+
+static void GENRMF_LONG_dinic(State& state) { _run(state, genrmf_long(), Algo::DINIC); }
+BENCHMARK( GENRMF_LONG_dinic )->Unit(benchmark::kMillisecond)->MinTime(0.1);
+
+static void GENRMF_LONG_push_relabel(State& state) { _run(state, genrmf_long(), Algo::PUSH_RELABEL); }
+BENCHMARK( GENRMF_LONG_push_relabel )->Unit(benchmark::kMillisecond)->MinTime(0.1);
+
+static void GENRMF_LONG_min_cut(State& state) { _run(state, genrmf_long(), Algo::MIN_CUT); }
+BENCHMARK( GENRMF_LONG_min_cut )->Unit(benchmark::kMillisecond)->MinTime(0.1);
+
+
+static void GENRMF_WIDE_dinic(State& state) { _run(state, genrmf_wide(), Algo::DINIC); }
+BENCHMARK( GENRMF_WIDE_dinic )->Unit(benchmark::kMillisecond)->MinTime(0.1);
+
+static void GENRMF_WIDE_push_relabel(State& state) { _run(state, genrmf_wide(), Algo::PUSH_RELABEL); }
+BENCHMARK( GENRMF_WIDE_push_relabel )->Unit(benchmark::kMillisecond)->MinTime(0.1);
+
+static void GENRMF_WIDE_min_cut(State& state) { _run(state, genrmf_wide(), Algo::MIN_CUT); }
+BENCHMARK( GENRMF_WIDE_min_cut )->Unit(benchmark::kMillisecond)->MinTime(0.1);
+
+
+static void MATCHING_dinic(State& state) { _run(state, matching(), Algo::DINIC); }
+BENCHMARK( MATCHING_dinic )->Unit(benchmark::kMillisecond)->MinTime(0.1);
+
+static void MATCHING_push_relabel(State& state) { _run(state, matching(), Algo::PUSH_RELABEL); }
+BENCHMARK( MATCHING_push_relabel )->Unit(benchmark::kMillisecond)->MinTime(0.1);
+
+static void MATCHING_min_cut(State& state) { _run(state, matching(), Algo::MIN_CUT); }
+BENCHMARK( MATCHING_min_cut )->Unit(benchmark::kMillisecond)->MinTime(0.1);
+
+
+
+
+BENCHMARK_MAIN();
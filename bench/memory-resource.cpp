@@ -0,0 +1,168 @@
+#include "common.hpp"
+#include <benchmark/benchmark.h>
+
+#include <salgo/alloc/memory-resource>
+#include <salgo/list>
+
+#include <list>
+#include <map>
+#include <memory_resource>
+#include <vector>
+
+using namespace benchmark;
+
+using namespace salgo;
+
+
+
+
+
+// std::pmr::list: erase every other element, insert the same number at the front
+template<class RESOURCE>
+static void _list_churn(State& state) {
+	srand(69); clear_cache();
+
+	const int N = 1'000'000;
+	RESOURCE resource;
+	std::pmr::list<int> li(&resource);
+
+	for(int i=0; i<N; ++i) li.emplace_back( rand() );
+
+	while( state.KeepRunningBatch(N) ) {
+		int ith = 0;
+		for(auto it = li.begin(); it != li.end(); ) {
+			auto ne = std::next(it);
+			if(ith++ % 2) {
+				li.erase(it);
+				li.emplace_front( rand() );
+			}
+			it = ne;
+		}
+	}
+}
+
+struct New_Delete_Resource : std::pmr::memory_resource {
+	void* do_allocate(std::size_t b, std::size_t a) override { return std::pmr::new_delete_resource()->allocate(b,a); }
+	void do_deallocate(void* p, std::size_t b, std::size_t a) override { std::pmr::new_delete_resource()->deallocate(p,b,a); }
+	bool do_is_equal(const std::pmr::memory_resource& o) const noexcept override { return this == &o; }
+};
+
+static void LIST_CHURN_new_delete(State& state) { _list_churn<New_Delete_Resource>(state); }
+BENCHMARK( LIST_CHURN_new_delete )->MinTime(0.1);
+
+static void LIST_CHURN_std_pool(State& state) { _list_churn<std::pmr::unsynchronized_pool_resource>(state); }
+BENCHMARK( LIST_CHURN_std_pool )->MinTime(0.1);
+
+static void LIST_CHURN_salgo(State& state) { _list_churn<Salgo_Memory_Resource>(state); }
+BENCHMARK( LIST_CHURN_salgo )->MinTime(0.1);
+
+
+
+
+
+// std::pmr::map: random inserts and erases
+template<class RESOURCE>
+static void _map_churn(State& state) {
+	srand(69); clear_cache();
+
+	const int N = 1 << 20;
+	RESOURCE resource;
+	std::pmr::map<int,int> m(&resource);
+
+	for(int i=0; i<N; ++i) m.emplace( rand() % (2*N), i );
+
+	for(auto _ : state) {
+		m.erase( rand() % (2*N) );
+		m.emplace( rand() % (2*N), 0 );
+	}
+}
+
+static void MAP_CHURN_std_pool(State& state) { _map_churn<std::pmr::unsynchronized_pool_resource>(state); }
+BENCHMARK( MAP_CHURN_std_pool )->MinTime(0.1);
+
+static void MAP_CHURN_salgo(State& state) { _map_churn<Salgo_Memory_Resource>(state); }
+BENCHMARK( MAP_CHURN_salgo )->MinTime(0.1);
+
+
+
+
+
+// raw allocate/deallocate of mixed sizes (8 .. 512 bytes)
+template<class RESOURCE>
+static void _mixed_sizes(State& state) {
+	srand(69); clear_cache();
+
+	const int N = 1 << 16;
+	RESOURCE resource;
+
+	struct Block { void* p; std::size_t size; };
+	std::vector<Block> blocks(N);
+	for(auto& b : blocks) {
+		b.size = 8 + rand() % 505;
+		b.p = resource.allocate(b.size, 8);
+	}
+
+	for(auto _ : state) {
+		auto& b = blocks[ rand() % N ];
+		resource.deallocate(b.p, b.size, 8);
+		b.size = 8 + rand() % 505;
+		b.p = resource.allocate(b.size, 8);
+	}
+
+	for(auto& b : blocks) resource.deallocate(b.p, b.size, 8);
+}
+
+static void MIXED_SIZES_std_pool(State& state) { _mixed_sizes<std::pmr::unsynchronized_pool_resource>(state); }
+BENCHMARK( MIXED_SIZES_std_pool )->MinTime(0.1);
+
+static void MIXED_SIZES_salgo(State& state) { _mixed_sizes<Salgo_Memory_Resource>(state); }
+BENCHMARK( MIXED_SIZES_salgo )->MinTime(0.1);
+
+
+
+
+
+// salgo::List ::PMR on top of each resource, vs. the default Array_Allocator
+template<class LIST>
+static void _salgo_list_churn(State& state, LIST& li) {
+	const int N = 1'000'000;
+	for(int i=0; i<N; ++i) li.emplace_back( rand() );
+
+	while( state.KeepRunningBatch(N) ) {
+		int ith = 0;
+		for(auto& e : li) {
+			if(ith++ % 2) {
+				e.erase();
+				li.emplace_front( rand() );
+			}
+		}
+	}
+}
+
+static void SALGO_LIST_CHURN_pmr_std_pool(State& state) {
+	srand(69); clear_cache();
+	std::pmr::unsynchronized_pool_resource resource;
+	List<int> ::PMR li(&resource);
+	_salgo_list_churn(state, li);
+}
+BENCHMARK( SALGO_LIST_CHURN_pmr_std_pool )->MinTime(0.1);
+
+static void SALGO_LIST_CHURN_pmr_salgo(State& state) {
+	srand(69); clear_cache();
+	Salgo_Memory_Resource resource;
+	List<int> ::PMR li(&resource);
+	_salgo_list_churn(state, li);
+}
+BENCHMARK( SALGO_LIST_CHURN_pmr_salgo )->MinTime(0.1);
+
+static void SALGO_LIST_CHURN_array_allocator(State& state) {
+	srand(69); clear_cache();
+	List<int> li;
+	_salgo_list_churn(state, li);
+}
+BENCHMARK( SALGO_LIST_CHURN_array_allocator )->MinTime(0.1);
+
+
+
+
+BENCHMARK_MAIN();
@@ -0,0 +1,243 @@
+#include "common.hpp"
+#include <benchmark/benchmark.h>
+
+#include <salgo/graph/graph>
+#include <salgo/graph/traversal>
+#include <salgo/graph/reorder-vertices>
+
+#include <memory> // std::unique_ptr
+#include <numeric>
+#include <vector>
+
+using namespace benchmark;
+
+using namespace salgo;
+using namespace salgo::graph;
+
+
+
+
+
+using G = Graph;
+
+// vertex ids as they often come from files: random
+static std::vector<int> shuffled_labels(int n) {
+	std::vector<int> label(n);
+	std::iota(label.begin(), label.end(), 0);
+	for(int i=n-1; i>0; --i) std::swap(label[i], label[rand() % (i+1)]);
+	return label;
+}
+
+// triangulated 1024 x 1024 grid (mesh-like), shuffled
+static G mesh_graph() {
+	srand(69);
+	const int w = 1024;
+	auto label = shuffled_labels(w*w);
+	G g(w*w);
+	for(int y=0; y<w; ++y) {
+		for(int x=0; x<w; ++x) {
+			int v = y*w + x;
+			if(x+1 < w) g.edges().add(label[v], label[v+1]);
+			if(y+1 < w) g.edges().add(label[v], label[v+w]);
+			if(x+1 < w && y+1 < w) g.edges().add(label[v], label[v+w+1]);
+		}
+	}
+	return g;
+}
+
+// undirected RMAT (Graph500 parameters): 2^18 vertices, 2^21 edges, shuffled
+static G rmat_graph() {
+	srand(69);
+	const int scale = 18;
+	auto label = shuffled_labels(1 << scale);
+	G g(1 << scale);
+	for(int i=0; i < (1 << (scale+3)); ++i) {
+		int a = 0, b = 0;
+		for(int bit=0; bit<scale; ++bit) {
+			int r = rand() % 100;
+			if(r < 57) {}
+			else if(r < 76) b |= 1 << bit;
+			else if(r < 95) a |= 1 << bit;
+			else { a |= 1 << bit; b |= 1 << bit; }
+		}
+		g.edges().add(label[a], label[b]);
+	}
+	return g;
+}
+
+
+
+enum class Input { MESH, RMAT };
+enum Order { SHUFFLED, BFS, RCM, DEGREE, GORDER, NUM_ORDERS };
+
+static const Vertex_Order Vertex_Orders[] = { Vertex_Order::BFS, Vertex_Order::BFS, Vertex_Order::RCM, Vertex_Order::DEGREE, Vertex_Order::GORDER };
+
+static G& input(Input in) {
+	static G mesh = mesh_graph();
+	static G rmat = rmat_graph();
+	return in == Input::MESH ? mesh : rmat;
+}
+
+struct Reordered {
+	G::Csr_Graph csr;
+	int source; // the highest-degree vertex (RMAT has many isolated ones)
+};
+
+static Reordered& reordered(Input in, Order order) {
+	static std::unique_ptr<Reordered> cache[2][NUM_ORDERS];
+	auto& r = cache[(int)in][order];
+	if(!r) {
+		G g = input(in);
+		int source = 0;
+		for(auto& v : g.verts()) if(v.outs().count() > g.vert(source).outs().count()) source = v.handle();
+		if(order != SHUFFLED) source = reorder_vertices(g, Vertex_Orders[order])[source];
+		r.reset( new Reordered{ g.freeze(), source } );
+	}
+	return *r;
+}
+
+
+
+static void _bfs(State& state, Input in, Order order) {
+	auto& r = reordered(in, order);
+	clear_cache();
+
+	for(auto _ : state) {
+		DoNotOptimize( salgo::graph::bfs(r.csr, r.source) );
+	}
+
+	state.SetItemsProcessed( state.iterations() * r.csr.num_edges() );
+}
+
+// 10 iterations of pull-based PageRank
+static void _pagerank(State& state, Input in, Order order) {
+	auto& r = reordered(in, order);
+	const int n = r.csr.verts().domain();
+	std::vector<double> rank(n, 1.0 / n), contribution(n);
+	clear_cache();
+
+	for(auto _ : state) {
+		for(int iter=0; iter<10; ++iter) {
+			for(int v=0; v<n; ++v) {
+				int deg = r.csr.vert(v).outs().count();
+				contribution[v] = deg ? rank[v] / deg : 0;
+			}
+			for(int v=0; v<n; ++v) {
+				double sum = 0;
+				for(auto& out : r.csr.vert(v).outs()) sum += contribution[ out.vert().handle() ];
+				rank[v] = 0.15 / n + 0.85 * sum;
+			}
+		}
+		DoNotOptimize( rank[0] );
+	}
+
+	state.SetItemsProcessed( state.iterations() * 10 * r.csr.num_edges() );
+}
+
+static void _reorder(State& state, Input in, Vertex_Order order) {
+	for(auto _ : state) {
+		state.PauseTiming();
+		G g = input(in);
+		state.ResumeTiming();
+
+		DoNotOptimize( reorder_vertices(g, order)[0] );
+	}
+
+	state.SetItemsProcessed( state.iterations() * input(in).verts().count() );
+}
+
+
+
+static void BFS_MESH_shuffled(State& state) { _bfs(state, Input::MESH, SHUFFLED); }
+BENCHMARK( BFS_MESH_shuffled )->Unit(benchmark::kMillisecond)->MinTime(0.1);
+
+static void BFS_MESH_bfs(State& state) { _bfs(state, Input::MESH, BFS); }
+BENCHMARK( BFS_MESH_bfs )->Unit(benchmark::kMillisecond)->MinTime(0.1);
+
+static void BFS_MESH_rcm(State& state) { _bfs(state, Input::MESH, RCM); }
+BENCHMARK( BFS_MESH_rcm )->Unit(benchmark::kMillisecond)->MinTime(0.1);
+
+static void BFS_MESH_degree(State& state) { _bfs(state, Input::MESH, DEGREE); }
+BENCHMARK( BFS_MESH_degree )->Unit(benchmark::kMillisecond)->MinTime(0.1);
+
+static void BFS_MESH_gorder(State& state) { _bfs(state, Input::MESH, GORDER); }
+BENCHMARK( BFS_MESH_gorder )->Unit(benchmark::kMillisecond)->MinTime(0.1);
+
+
+static void BFS_RMAT_shuffled(State& state) { _bfs(state, Input::RMAT, SHUFFLED); }
+BENCHMARK( BFS_RMAT_shuffled )->Unit(benchmark::kMillisecond)->MinTime(0.1);
+
+static void BFS_RMAT_bfs(State& state) { _bfs(state, Input::RMAT, BFS); }
+BENCHMARK( BFS_RMAT_bfs )->Unit(benchmark::kMillisecond)->MinTime(0.1);
+
+static void BFS_RMAT_rcm(State& state) { _bfs(state, Input::RMAT, RCM); }
+BENCHMARK( BFS_RMAT_rcm )->Unit(benchmark::kMillisecond)->MinTime(0.1);
+
+static void BFS_RMAT_degree(State& state) { _bfs(state, Input::RMAT, DEGREE); }
+BENCHMARK( BFS_RMAT_degree )->Unit(benchmark::kMillisecond)->MinTime(0.1);
+
+static void BFS_RMAT_gorder(State& state) { _bfs(state, Input::RMAT, GORDER); }
+BENCHMARK( BFS_RMAT_gorder )->Unit(benchmark::kMillisecond)->MinTime(0.1);
+
+
+static void PAGERANK_MESH_shuffled(State& state) { _pagerank(state, Input::MESH, SHUFFLED); }
+BENCHMARK( PAGERANK_MESH_shuffled )->Unit(benchmark::kMillisecond)->MinTime(0.1);
+
+static void PAGERANK_MESH_bfs(State& state) { _pagerank(state, Input::MESH, BFS); }
+BENCHMARK( PAGERANK_MESH_bfs )->Unit(benchmark::kMillisecond)->MinTime(0.1);
+
+static void PAGERANK_MESH_rcm(State& state) { _pagerank(state, Input::MESH, RCM); }
+BENCHMARK( PAGERANK_MESH_rcm )->Unit(benchmark::kMillisecond)->MinTime(0.1);
+
+static void PAGERANK_MESH_degree(State& state) { _pagerank(state, Input::MESH, DEGREE); }
+BENCHMARK( PAGERANK_MESH_degree )->Unit(benchmark::kMillisecond)->MinTime(0.1);
+
+static void PAGERANK_MESH_gorder(State& state) { _pagerank(state, Input::MESH, GORDER); }
+BENCHMARK( PAGERANK_MESH_gorder )->Unit(benchmark::kMillisecond)->MinTime(0.1);
+
+
+static void PAGERANK_RMAT_shuffled(State& state) { _pagerank(state, Input::RMAT, SHUFFLED); }
+BENCHMARK( PAGERANK_RMAT_shuffled )->Unit(benchmark::kMillisecond)->MinTime(0.1);
+
+static void PAGERANK_RMAT_bfs(State& state) { _pagerank(state, Input::RMAT, BFS); }
+BENCHMARK( PAGERANK_RMAT_bfs )->Unit(benchmark::kMillisecond)->MinTime(0.1);
+
+static void PAGERANK_RMAT_rcm(State& state) { _pagerank(state, Input::RMAT, RCM); }
+BENCHMARK( PAGERANK_RMAT_rcm )->Unit(benchmark::kMillisecond)->MinTime(0.1);
+
+static void PAGERANK_RMAT_degree(State& state) { _pagerank(state, Input::RMAT, DEGREE); }
+BENCHMARK( PAGERANK_RMAT_degree )->Unit(benchmark::kMillisecond)->MinTime(0.1);
+
+static void PAGERANK_RMAT_gorder(State& state) { _pagerank(state, Input::RMAT, GORDER); }
+BENCHMARK( PAGERANK_RMAT_gorder )->Unit(benchmark::kMillisecond)->MinTime(0.1);
+
+
+static void REORDER_MESH_bfs(State& state) { _reorder(state, Input::MESH, Vertex_Order::BFS); }
+BENCHMARK( REORDER_MESH_bfs )->Unit(benchmark::kMillisecond)->MinTime(0.1);
+
+static void REORDER_MESH_rcm(State& state) { _reorder(state, Input::MESH, Vertex_Order::RCM); }
+BENCHMARK( REORDER_MESH_rcm )->Unit(benchmark::kMillisecond)->MinTime(0.1);
+
+static void REORDER_MESH_degree(State& state) { _reorder(state, Input::MESH, Vertex_Order::DEGREE); }
+BENCHMARK( REORDER_MESH_degree )->Unit(benchmark::kMillisecond)->MinTime(0.1);
+
+static void REORDER_MESH_gorder(State& state) { _reorder(state, Input::MESH, Vertex_Order::GORDER); }
+BENCHMARK( REORDER_MESH_gorder )->Unit(benchmark::kMillisecond)->MinTime(0.1);
+
+
+static void REORDER_RMAT_bfs(State& state) { _reorder(state, Input::RMAT, Vertex_Order::BFS); }
+BENCHMARK( REORDER_RMAT_bfs )->Unit(benchmark::kMillisecond)->MinTime(0.1);
+
+static void REORDER_RMAT_rcm(State& state) { _reorder(state, Input::RMAT, Vertex_Order::RCM); }
+BENCHMARK( REORDER_RMAT_rcm )->Unit(benchmark::kMillisecond)->MinTime(0.1);
+
+static void REORDER_RMAT_degree(State& state) { _reorder(state, Input::RMAT, Vertex_Order::DEGREE); }
+BENCHMARK( REORDER_RMAT_degree )->Unit(benchmark::kMillisecond)->MinTime(0.1);
+
+static void REORDER_RMAT_gorder(State& state) { _reorder(state, Input::RMAT, Vertex_Order::GORDER); }
+BENCHMARK( REORDER_RMAT_gorder )->Unit(benchmark::kMillisecond)->MinTime(0.1);
+
+
+
+
+BENCHMARK_MAIN();
@@ -0,0 +1,157 @@
+#include "common.hpp"
+#include <benchmark/benchmark.h>
+
+#include <salgo/graph/graph>
+#include <salgo/graph/shortest-paths>
+
+#include <functional>
+#include <limits>
+#include <queue>
+#include <utility>
+#include <vector>
+
+using namespace benchmark;
+
+using namespace salgo;
+using namespace salgo::graph;
+
+
+
+
+
+using Weighted_Graph = Graph ::EDGE_DATA<int>;
+
+// road-like: 1024 x 1024 grid with random lengths, large diameter, degree <= 4
+static auto& road_graph() {
+	static Weighted_Graph g;
+	if(g.verts().is_empty()) {
+		srand(69);
+		const int n = 1024;
+		g = Weighted_Graph(n * n);
+		for(int y=0; y<n; ++y) {
+			for(int x=0; x<n; ++x) {
+				if(x+1 < n) g.edges().add(y*n + x, y*n + x+1, 100 + rand() % 900);
+				if(y+1 < n) g.edges().add(y*n + x, (y+1)*n + x, 100 + rand() % 900);
+			}
+		}
+	}
+	return g;
+}
+
+// random: 2^20 vertices, 2^22 edges, small diameter
+static auto& random_graph() {
+	static Weighted_Graph g;
+	if(g.verts().is_empty()) {
+		srand(69);
+		const int n = 1<<20;
+		g = Weighted_Graph(n);
+		for(int i=0; i < (n << 2); ++i) g.edges().add( rand() % n, rand() % n, 1 + rand() % 1000 );
+	}
+	return g;
+}
+
+
+static auto weight = [](auto& out) { return out.edge().data(); };
+
+
+// baseline: std::priority_queue with lazy deletion
+template<class G>
+static int dijkstra_std(G& g, std::vector<int>& dist) {
+	std::fill(dist.begin(), dist.end(), std::numeric_limits<int>::max());
+
+	std::priority_queue<std::pair<int,int>, std::vector<std::pair<int,int>>, std::greater<>> q;
+	dist[0] = 0;
+	q.emplace(0, 0);
+
+	int settled = 0;
+	while(!q.empty()) {
+		auto [d, v] = q.top(); q.pop();
+		if(d != dist[v]) continue;
+		++settled;
+
+		for(auto& out : g.vert(v).outs()) {
+			int u = out.vert().handle();
+			int du = d + out.edge().data();
+			if(du < dist[u]) {
+				dist[u] = du;
+				q.emplace(du, u);
+			}
+		}
+	}
+	return settled;
+}
+
+
+enum class Algo { STD, HEAP, RADIX, DELTA_STEPPING };
+
+template<class G>
+static void _run(State& state, G& g, Algo algo) {
+	std::vector<int> dist( g.verts().domain() );
+	clear_cache();
+
+	for(auto _ : state) {
+		switch(algo) {
+			case Algo::STD: DoNotOptimize( dijkstra_std(g, dist) ); break;
+			case Algo::HEAP: DoNotOptimize( shortest_paths(g, 0, weight) ); break;
+			case Algo::RADIX: DoNotOptimize( shortest_paths_radix(g, 0, weight) ); break;
+			case Algo::DELTA_STEPPING: DoNotOptimize( shortest_paths_delta_stepping(g, 0, weight) ); break;
+		}
+	}
+
+	state.SetItemsProcessed( state.iterations() * g.verts().count() );
+}
+
+// point-to-point: the opposite corner of the road grid is the farthest, so go half-way
+static void _run_target(State& state, bool radix) {
+	auto csr = road_graph().freeze();
+	const int target = 512 * 1024 + 512;
+	clear_cache();
+
+	for(auto _ : state) {
+		if(radix) DoNotOptimize( shortest_paths_radix(csr, 0, weight, TARGET = target) );
+		else DoNotOptimize( shortest_paths(csr, 0, weight, TARGET = target) );
+	}
+
+	state.SetItemsProcessed( state.iterations() * csr.verts().count() );
+}
+
+
+static void ROAD_std_priority_queue(State& state) { auto csr = road_graph().freeze(); _run(state, csr, Algo::STD); }
+BENCHMARK( ROAD_std_priority_queue )->Unit(benchmark::kMillisecond)->MinTime(0.1);
+
+static void ROAD_heap(State& state) { auto csr = road_graph().freeze(); _run(state, csr, Algo::HEAP); }
+BENCHMARK( ROAD_heap )->Unit(benchmark::kMillisecond)->MinTime(0.1);
+
+static void ROAD_radix(State& state) { auto csr = road_graph().freeze(); _run(state, csr, Algo::RADIX); }
+BENCHMARK( ROAD_radix )->Unit(benchmark::kMillisecond)->MinTime(0.1);
+
+static void ROAD_delta_stepping(State& state) { auto csr = road_graph().freeze(); _run(state, csr, Algo::DELTA_STEPPING); }
+BENCHMARK( ROAD_delta_stepping )->Unit(benchmark::kMillisecond)->MinTime(0.1);
+
+static void ROAD_heap_target(State& state) { _run_target(state, false); }
+BENCHMARK( ROAD_heap_target )->Unit(benchmark::kMillisecond)->MinTime(0.1);
+
+static void ROAD_radix_target(State& state) { _run_target(state, true); }
+BENCHMARK( ROAD_radix_target )->Unit(benchmark::kMillisecond)->MinTime(0.1);
+
+
+static void RANDOM_std_priority_queue(State& state) { auto csr = random_graph().freeze(); _run(state, csr, Algo::STD); }
+BENCHMARK( RANDOM_std_priority_queue )->Unit(benchmark::kMillisecond)->MinTime(0.1);
+
+static void RANDOM_heap(State& state) { auto csr = random_graph().freeze(); _run(state, csr, Algo::HEAP); }
+BENCHMARK( RANDOM_heap )->Unit(benchmark::kMillisecond)->MinTime(0.1);
+
+static void RANDOM_radix(State& state) { auto csr = random_graph().freeze(); _run(state, csr, Algo::RADIX); }
+BENCHMARK( RANDOM_radix )->Unit(benchmark::kMillisecond)->MinTime(0.1);
+
+static void RANDOM_delta_stepping(State& state) { auto csr = random_graph().freeze(); _run(state, csr, Algo::DELTA_STEPPING); }
+BENCHMARK( RANDOM_delta_stepping )->Unit(benchmark::kMillisecond)->MinTime(0.1);
+
+// Graph (not frozen)
+static void RANDOM_graph_heap(State& state) { _run(state, random_graph(), Algo::HEAP); }
+BENCHMARK( RANDOM_graph_heap )->Unit(benchmark::kMillisecond)->MinTime(0.1);
+
+
+
+
+BENCHMARK_MAIN();
@@ -0,0 +1,155 @@
+#include "common.hpp"
+#include <benchmark/benchmark.h>
+
+#include <salgo/slot-map>
+#include <salgo/alloc/array-allocator>
+
+#include <vector>
+
+using namespace benchmark;
+
+using namespace salgo;
+using namespace salgo::alloc;
+
+
+
+
+
+//
+// 2^20 elements, then half of them erased at random
+//
+// Array_Allocator iteration skips the holes one by one, Slot_Map iterates a dense array
+//
+
+static const int Elements = 1<<20;
+
+template<class CONT>
+static auto build_churned(CONT& cont) {
+	std::vector<typename CONT::Handle> handles;
+	for(int i=0; i<Elements; ++i) handles.emplace_back( cont.construct_or_emplace(i) );
+
+	for(int i=0; i<Elements/2; ++i) {
+		int j = rand() % handles.size();
+		cont.erase( handles[j] );
+		handles[j] = handles.back();
+		handles.pop_back();
+	}
+
+	return handles;
+}
+
+
+
+namespace {
+	struct Vector : Array_Allocator<int> {
+		auto construct_or_emplace(int x) { return construct(x).handle(); }
+		void erase(Handle h) { (*this)(h).destruct(); }
+	};
+
+	struct Slots : Slot_Map<int> {
+		auto construct_or_emplace(int x) { return emplace(x).handle(); }
+	};
+}
+
+
+
+static void ITERATE_CHURNED_salgo_vector(State& state) {
+	srand(69); clear_cache();
+
+	Vector cont;
+	build_churned(cont);
+
+	for(auto _ : state) {
+		int sum = 0;
+		for(auto& e : cont) sum += e;
+		DoNotOptimize(sum);
+	}
+
+	state.SetItemsProcessed( state.iterations() * cont.count() );
+}
+BENCHMARK( ITERATE_CHURNED_salgo_vector )->MinTime(0.1);
+
+
+
+static void ITERATE_CHURNED_salgo_slot_map(State& state) {
+	srand(69); clear_cache();
+
+	Slots cont;
+	build_churned(cont);
+
+	for(auto _ : state) {
+		int sum = 0;
+		for(auto& e : cont) sum += e;
+		DoNotOptimize(sum);
+	}
+
+	state.SetItemsProcessed( state.iterations() * cont.count() );
+}
+BENCHMARK( ITERATE_CHURNED_salgo_slot_map )->MinTime(0.1);
+
+
+
+
+//
+// erase a random element, insert a new one
+//
+
+template<class CONT>
+static void _churn(State& state) {
+	srand(69); clear_cache();
+
+	CONT cont;
+	auto handles = build_churned(cont);
+
+	for(auto _ : state) {
+		auto& h = handles[ rand() % handles.size() ];
+		cont.erase(h);
+		h = cont.construct_or_emplace(0);
+	}
+}
+
+static void CHURN_salgo_vector(State& state) {
+	_churn<Vector>(state);
+}
+BENCHMARK( CHURN_salgo_vector )->MinTime(0.1);
+
+static void CHURN_salgo_slot_map(State& state) {
+	_churn<Slots>(state);
+}
+BENCHMARK( CHURN_salgo_slot_map )->MinTime(0.1);
+
+
+
+
+//
+// random access by handle
+//
+
+template<class CONT>
+static void _lookup(State& state) {
+	srand(69); clear_cache();
+
+	CONT cont;
+	auto handles = build_churned(cont);
+
+	for(auto _ : state) {
+		DoNotOptimize( cont[ handles[ rand() % handles.size() ] ] );
+	}
+}
+
+static void LOOKUP_salgo_vector(State& state) {
+	_lookup<Vector>(state);
+}
+BENCHMARK( LOOKUP_salgo_vector )->MinTime(0.1);
+
+static void LOOKUP_salgo_slot_map(State& state) {
+	_lookup<Slots>(state);
+}
+BENCHMARK( LOOKUP_salgo_slot_map )->MinTime(0.1);
+
+
+
+
+
+
+BENCHMARK_MAIN();
@@ -0,0 +1,111 @@
+#include "common.hpp"
+#include <benchmark/benchmark.h>
+
+#include <salgo/union-find>
+#include <salgo/graph/dynamic-connectivity>
+#include <salgo/graph/graph>
+
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace benchmark;
+
+using namespace salgo;
+
+
+
+
+
+//
+// connected components of a random graph: 2^20 vertices, 2^22 edges
+//
+// ::CONCURRENT merge_edges() is run with the number of threads given as the benchmark argument
+//
+
+static const int Vertices = 1<<20;
+static const int Edges = 1<<22;
+
+static const auto& random_edges() {
+	static std::vector<std::pair<int,int>> edges;
+	if(edges.empty()) {
+		srand(69);
+		for(int i=0; i<Edges; ++i) edges.emplace_back( rand() % Vertices, rand() % Vertices );
+	}
+	return edges;
+}
+
+
+static void COMPONENTS_salgo(State& state) {
+	auto& edges = random_edges();
+	clear_cache();
+
+	for(auto _ : state) {
+		Union_Find uf(Vertices);
+		for(auto& [a, b] : edges) {
+			if(uf(a) != uf(b)) uf.merge(a, b);
+		}
+		DoNotOptimize(uf);
+	}
+
+	state.SetItemsProcessed( state.iterations() * Edges );
+}
+BENCHMARK( COMPONENTS_salgo )->Unit(benchmark::kMillisecond)->MinTime(0.1);
+
+
+static void COMPONENTS_salgo_concurrent(State& state) {
+	auto& edges = random_edges();
+	clear_cache();
+
+	for(auto _ : state) {
+		Union_Find ::CONCURRENT uf(Vertices);
+		uf.merge_edges( edges, state.range(0) );
+		DoNotOptimize(uf);
+	}
+
+	state.SetItemsProcessed( state.iterations() * Edges );
+}
+BENCHMARK( COMPONENTS_salgo_concurrent )->RangeMultiplier(2)->Range(1, 16)->UseRealTime()
+	->Unit(benchmark::kMillisecond)->MinTime(0.1);
+
+
+
+
+
+
+//
+// offline dynamic connectivity: 2^16 vertices, 2^18 edges living for random intervals, 2^18 queries at 2^16 time steps
+//
+// (Union_Find ::ROLLBACK under a segment tree over time)
+//
+
+static void DYNAMIC_CONNECTIVITY_salgo(State& state) {
+	const int V = 1<<16;
+	const int E = 1<<18;
+	const int T = 1<<16;
+	const int Q = 1<<18;
+
+	srand(69);
+	salgo::graph::Graph ::EDGE_DATA<salgo::graph::Lifetime> g(V);
+	for(int i=0; i<E; ++i) {
+		int fr = rand() % T;
+		g.edges().add( rand() % V, rand() % V, salgo::graph::Lifetime{fr, fr + rand() % (T/8)} );
+	}
+
+	std::vector<salgo::graph::Connectivity_Query> queries;
+	for(int i=0; i<Q; ++i) queries.push_back({ rand() % T, rand() % V, rand() % V });
+
+	clear_cache();
+
+	for(auto _ : state) {
+		auto result = salgo::graph::offline_connectivity(g, queries);
+		DoNotOptimize(result);
+	}
+
+	state.SetItemsProcessed( state.iterations() * Q );
+}
+BENCHMARK( DYNAMIC_CONNECTIVITY_salgo )->Unit(benchmark::kMillisecond)->MinTime(0.1);
+
+
+
+BENCHMARK_MAIN();
@@ -16,6 +16,7 @@ namespace salgo::_ {
 
 SALGO_GENERATE_HAS_MEMBER(Reference)
 SALGO_GENERATE_HAS_MEMBER(Comparable)
+SALGO_GENERATE_HAS_MEMBER(_get_data)
 
 template<bool, Const_Flag C, class CONTEXT>
 class _Reference;
@@ -125,16 +126,27 @@ public:
 	void reset() { _handle = Handle{}; }
 
 	// get value
+	// (Context::Reference can provide `_get_data()` to bypass `operator[](HANDLE)`, e.g. using a cached location)
 	decltype(auto) data()       {
-		static_assert(is_operator_subscript_invocable< Const<Container,C>, Handle >,
-			"in order to access DATA/VALUE, your container should have operator[](HANDLE) defined");
-		return (*_container)[_handle];
+		if constexpr(has_member___get_data< _::Reference<C,CONTEXT> >) {
+			return static_cast<_::Reference<C,CONTEXT>*>(this)->_get_data();
+		}
+		else {
+			static_assert(is_operator_subscript_invocable< Const<Container,C>, Handle >,
+				"in order to access DATA/VALUE, your container should have operator[](HANDLE) defined");
+			return (*_container)[_handle];
+		}
 	}
 
 	decltype(auto) data() const {
-		static_assert(is_operator_subscript_invocable< Const<Container,C>, Handle >,
-			"in order to access DATA/VALUE, your container should have operator[](HANDLE) defined");
-		return (*_container)[_handle];
+		if constexpr(has_member___get_data< _::Reference<C,CONTEXT> >) {
+			return static_cast<const _::Reference<C,CONTEXT>*>(this)->_get_data();
+		}
+		else {
+			static_assert(is_operator_subscript_invocable< Const<Container,C>, Handle >,
+				"in order to access DATA/VALUE, your container should have operator[](HANDLE) defined");
+			return (*_container)[_handle];
+		}
 	}
 
 
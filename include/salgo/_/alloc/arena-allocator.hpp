@@ -0,0 +1,346 @@
+#pragma once
+
+#include "../handles.hpp"
+#include "../global-instance.hpp"
+#include "../const-flag.hpp"
+
+#include <glog/logging.h>
+
+#include <cstddef> // std::max_align_t
+#include <new> // placement new, ::operator new
+#include <type_traits>
+#include <utility> // std::forward, std::swap
+
+namespace salgo::alloc::_::arena_allocator {
+
+
+
+//
+// HANDLES
+//
+// page index and byte offset inside the page, same 5/27-bit encoding as Crude_Allocator
+//
+// parametrized by unused context X, to make Handles from different Contexts incompatible
+//
+static const int div = 27;
+
+using H0 = Int_Handle<int,(1<<(32-div))-1>;
+
+// big
+template<class X>
+struct Handle : Pair_Handle_Base<Handle<X>, H0, int> {
+	using BASE = Pair_Handle_Base<Handle<X>, H0, int>;
+
+	Handle() = default;
+
+	template<class A, class B>
+	Handle(A aa, B bb) : BASE(aa,bb) {
+		DCHECK_GE(aa, 0); DCHECK_LT(aa, 1<<(32-div));
+		DCHECK_GE(bb, 0); DCHECK_LT(bb, 1<<div);
+	}
+};
+
+// small
+template<class X>
+struct Handle_Small : Int_Handle_Base<Handle_Small<X>, unsigned int> {
+	using BASE = Int_Handle_Base<Handle_Small<X>, unsigned int>;
+
+	Handle_Small() = default;
+	Handle_Small(unsigned int v) : BASE(v) {}
+
+	Handle_Small( const Handle<X>& h ) { *this = h; }
+	Handle_Small& operator=(const Handle<X>& h) {
+		DCHECK_LT(h.a, 1<<(32-div));
+		DCHECK_LT(h.b, 1<<div);
+		*this = (h.a << div) | h.b;
+		return *this;
+	}
+
+	operator Handle<X>() const {
+		return Handle<X>(H0((*this)>>div), (*this)&((1<<div)-1));
+	}
+};
+
+
+
+
+//
+// untyped memory: bump-allocates from pages of doubling sizes
+//
+// `reset()` makes all memory available again at once (without calling any destructors),
+// pages are kept for reuse
+//
+class Arena {
+public:
+	static constexpr int Max_Pages = 1 << (32-div);
+	static constexpr int First_Page_Size = 1 << 12;
+	static constexpr int Max_Page_Size = 1 << div; // byte offset has to fit in the handle
+
+	static constexpr int page_size(int a) {
+		return a >= div-12 ? Max_Page_Size : First_Page_Size << a;
+	}
+
+private:
+	char* _pages[Max_Pages] = {};
+	int _num_pages = 0; // allocated pages
+
+	int _current = -1; // page used for new allocations
+	int _offset = 0; // first free byte in the current page
+
+public:
+	Arena() = default;
+
+	Arena(const Arena&) = delete;
+	Arena& operator=(const Arena&) = delete;
+
+	Arena(Arena&& o) { _swap(o); }
+	Arena& operator=(Arena&& o) { release(); _swap(o); return *this; }
+
+	~Arena() { release(); }
+
+
+public:
+	// returns {page, byte offset}
+	template<class HANDLE>
+	HANDLE allocate(int bytes, int align) {
+		DCHECK_LE(bytes, Max_Page_Size) << "arena allocation too big";
+		DCHECK_LE(align, (int)alignof(std::max_align_t));
+
+		int offset = (_offset + align - 1) & ~(align - 1);
+		while(_current == -1 || offset + bytes > page_size(_current)) {
+			_next_page();
+			offset = 0;
+		}
+
+		_offset = offset + bytes;
+		return HANDLE( H0(_current), offset );
+	}
+
+	char* ptr(int page, int offset) const { return _pages[page] + offset; }
+
+
+	// everything allocated so far is discarded - no destructors are called
+	void reset() {
+		_current = -1;
+		_offset = 0;
+	}
+
+	// like `reset()`, but also gives the memory back to the system
+	void release() {
+		for(int i=0; i<_num_pages; ++i) ::operator delete( _pages[i] );
+		_num_pages = 0;
+		reset();
+	}
+
+	// bytes of memory held
+	long long capacity() const {
+		long long result = 0;
+		for(int i=0; i<_num_pages; ++i) result += page_size(i);
+		return result;
+	}
+
+
+private:
+	void _swap(Arena& o) {
+		std::swap(_pages, o._pages);
+		std::swap(_num_pages, o._num_pages);
+		std::swap(_current, o._current);
+		std::swap(_offset, o._offset);
+	}
+
+	void _next_page() {
+		++_current;
+		DCHECK_LT(_current, Max_Pages) << "Arena out of handle space";
+
+		if(_current == _num_pages) {
+			_pages[_num_pages] = (char*)::operator new( page_size(_num_pages) );
+			++_num_pages;
+		}
+	}
+};
+
+
+
+
+template<class TAG>
+struct Shared_Arena : Arena {};
+
+
+
+
+template<
+	class _VAL,
+	class _SHARED_TAG // void if owning
+>
+struct Context {
+
+	//
+	// TEMPLATE PARAMETERS
+	//
+	using Val = _VAL;
+	using Shared_Tag = _SHARED_TAG;
+	static constexpr bool Shared = !std::is_same_v<Shared_Tag, void>;
+
+
+	using       Handle = arena_allocator::      Handle<Context>;
+	using Handle_Small = arena_allocator::Handle_Small<Context>;
+
+
+
+
+	// forward
+	class Arena_Allocator;
+
+
+
+
+	//
+	// accessor
+	//
+	template<Const_Flag C>
+	class Accessor {
+	public:
+		// get handle
+		auto     handle() const { return _handle; }
+		operator   auto() const { return handle(); }
+
+		auto& operator()()       { return _owner[_handle]; }
+		auto& operator()() const { return _owner[_handle]; }
+		operator auto&()       { return operator()(); }
+		operator auto&() const { return operator()(); }
+
+		void destruct() {
+			static_assert(C == MUTAB, "called destruct() on CONST accessor");
+			_owner.destruct( _handle );
+		}
+
+
+	private:
+		Accessor(Const<Arena_Allocator,C>& owner, Handle handle)
+			: _owner(owner), _handle(handle) {}
+
+		friend Arena_Allocator;
+
+
+	private:
+		Const<Arena_Allocator,C>& _owner;
+		const Handle _handle;
+	};
+
+
+
+
+	struct Owned_Arena { Arena arena; };
+	struct Shared_Arena_Ref {};
+
+	using Arena_Base = std::conditional_t<Shared, Shared_Arena_Ref, Owned_Arena>;
+
+
+
+
+	class Arena_Allocator : private Arena_Base {
+	public:
+		// ::SHARED instances with the same tag refer to the same arena
+		static constexpr bool Is_Shared = Shared;
+
+		// elements never move
+		static constexpr bool Is_Persistent = true;
+
+		// destruct() only calls the destructor - memory is reclaimed by `reset()`,
+		// so containers can skip destructing trivially destructible elements
+		static constexpr bool Is_Monotonic = true;
+
+	public:
+		using          Val = Context::Val;
+		using Handle_Small = Context::Handle_Small;
+		using       Handle = Context::Handle;
+
+
+	public:
+		template<class... ARGS>
+		auto construct(ARGS&&... args) {
+			static_assert(alignof(Val) <= alignof(std::max_align_t), "over-aligned types not supported");
+			auto handle = arena().template allocate<Handle>( sizeof(Val), alignof(Val) );
+			new( _ptr(handle) ) Val( std::forward<ARGS>(args)... );
+			return Accessor<MUTAB>( *this, handle );
+		}
+
+		// bump allocation - new elements are always placed right after the most recently constructed one
+		template<class... ARGS>
+		auto construct_near(Handle, ARGS&&... args) {
+			return construct( std::forward<ARGS>(args)... );
+		}
+
+		void destruct(Handle handle) { (*this)[handle].~Val(); }
+
+
+		auto& operator[](Handle handle)       { return *reinterpret_cast<      Val*>( _ptr(handle) ); }
+		auto& operator[](Handle handle) const { return *reinterpret_cast<const Val*>( _ptr(handle) ); }
+
+		auto operator()(Handle handle)       { return Accessor<MUTAB>(*this, handle); }
+		auto operator()(Handle handle) const { return Accessor<CONST>(*this, handle); }
+
+
+		// memory held by the arena (shared by all allocators using it, if ::SHARED)
+		long long bytes_reserved() const { return arena().capacity(); }
+
+		// discard all elements at once - destructors are not called
+		void reset() { arena().reset(); }
+
+		// like reset(), but also frees the memory
+		void release() { arena().release(); }
+
+
+		Arena& arena() {
+			if constexpr(Shared) return global_instance<Shared_Arena<Shared_Tag>>();
+			else return Arena_Base::arena;
+		}
+
+		const Arena& arena() const {
+			if constexpr(Shared) return global_instance<Shared_Arena<Shared_Tag>>();
+			else return Arena_Base::arena;
+		}
+
+	private:
+		char* _ptr(Handle handle) const { return arena().ptr( handle.a, handle.b ); }
+	};
+
+
+
+
+	struct With_Builder : Arena_Allocator {
+
+		template<class NEW_VAL>
+		using VAL = typename
+			Context<NEW_VAL, Shared_Tag> :: With_Builder;
+
+		// non-owning: all allocators with the same TAG (and any VAL) use one global arena
+		template<class TAG>
+		using SHARED = typename
+			Context<Val, TAG> :: With_Builder;
+	};
+
+
+}; // struct Context
+
+}  // namespace salgo::alloc::_::arena_allocator
+
+
+
+
+
+
+namespace salgo::alloc {
+
+template<
+	class VAL
+>
+using Arena_Allocator = typename _::arena_allocator::Context<
+	VAL,
+	void // shared tag
+>::With_Builder;
+
+using Arena = _::arena_allocator::Arena;
+
+} // namespace salgo::alloc
+
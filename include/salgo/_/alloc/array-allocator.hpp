@@ -10,6 +10,8 @@ Grows memory block similar to std::vector, when congestion is 0.5 or more.
 
 When constructing a new element, it looks for a hole in circular fashion.
 
+With `::STABLE`, elements are stored in chunks of doubling sizes instead, and are never moved.
+
 Multithreaded code: keep in mind that old objects can be moved when new objects are allocated!
 
 */
@@ -25,7 +27,11 @@ namespace salgo::alloc::_::array_allocator {
 
 template<
 	class VAL,
-	int ALIGN
+	int ALIGN,
+	bool FREE_BITMAP,
+	bool STABLE,
+	class HANDLE_INT,
+	bool PROBE_STATS
 >
 struct Params;
 
@@ -41,6 +47,9 @@ class Iterator;
 template<class P>
 struct Context;
 
+template<class VAL, int ALIGN, class HANDLE_INT>
+class Stable_Block;
+
 template<class P>
 class Array_Allocator;
 
@@ -59,7 +68,11 @@ namespace salgo::alloc {
 template< class VAL = int > // TODO: make it compile with `void`
 using Array_Allocator = _::array_allocator::With_Builder< _::array_allocator::Params<
 	VAL,
-	0 // ALIGN
+	0, // ALIGN
+	false, // FREE_BITMAP
+	false, // STABLE
+	int, // HANDLE_INT
+	false // PROBE_STATS
 >>;
 
 
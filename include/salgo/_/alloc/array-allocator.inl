@@ -9,6 +9,12 @@ Constructed objects are NOT persistent - they can be moved in memory by this all
 Grows memory block similar to std::vector, when congestion is 0.5 or more.
 
 When constructing a new element, it looks for a hole in circular fashion.
+With `::FREE_BITMAP`, holes are found using a hierarchical bitmap of free slots instead of a linear scan.
+The same holes are chosen in both modes.
+
+With `::STABLE`, elements are stored in chunks of doubling sizes (like in Chunked_Array) instead of a single block.
+Growing allocates a new chunk and never moves existing elements, so references stay valid.
+Indices, growth policy and hole finding are the same.
 
 Multithreaded code: keep in mind that old objects can be moved when new objects are allocated!
 
@@ -20,26 +26,284 @@ Multithreaded code: keep in mind that old objects can be moved when new objects
 #include "../memory-block.inl"
 
 #include "../subscript-tags.hpp"
+#include "../hierarchical-bitset.hpp"
+#include "../add-member.hpp"
+#include "probe-stats.hpp"
+
+#include <algorithm> // std::min
+#include <memory> // std::unique_ptr
+#include <utility> // std::exchange
+#include <vector>
 
 #include "../helper-macros-on.inc"
 
 namespace salgo::alloc::_::array_allocator {
 
 
+SALGO_ADD_MEMBER(free_slots)
+SALGO_ADD_MEMBER(probes)
+
+
+
+
+//
+// `::STABLE` storage: index `i` lives in chunk `bsr(i+1)` of size `2^chunk`
+//
+// new chunks are left uninitialized (only constructed-flags are cleared), so growing is cheap
+//
+// provides the part of Memory_Block interface used by Array_Allocator
+//
+template<class VAL, int ALIGN, class HANDLE_INT>
+class Stable_Block {
+public:
+	using Val = VAL;
+
+private:
+	using Block_Handles = typename salgo::Memory_Block<Val> ::CONSTRUCTED_FLAGS ::template ALIGN<ALIGN> ::template HANDLE_INT<HANDLE_INT>;
+
+public:
+	using Handle       = typename Block_Handles::Handle;
+	using Handle_Small = typename Block_Handles::Handle_Small;
+	using Index        = typename Block_Handles::Index;
+
+	using Handle_Int = HANDLE_INT;
+	using Index_Int  = typename Block_Handles::Index_Int;
+	static constexpr Index_Int Max_Domain = Block_Handles::Max_Domain;
+
+
+private:
+	static constexpr int Max_Chunks = 8*sizeof(Index_Int) - 1;
+
+	struct alignas(ALIGN ? ALIGN : alignof(Val)) alignas(Val) Slot {
+		Slot() {} // leave uninitialized
+
+		auto& get()       { return *reinterpret_cast<      Val*>(data); }
+		auto& get() const { return *reinterpret_cast<const Val*>(data); }
+
+		char data[ sizeof(Val) ];
+	};
+
+	struct Chunk {
+		std::unique_ptr<Slot[]> slots;
+		std::vector<bool> constructed;
+	};
+
+
+public:
+	template<Const_Flag C>
+	class Accessor {
+	public:
+		template<class... ARGS>
+		auto& construct(ARGS&&... args) {
+			static_assert(C == MUTAB, "called construct() on CONST accessor");
+			DCHECK( is_not_constructed() ) << "element already constructed";
+			new( &_slot() ) Val( std::forward<ARGS>(args)... );
+			_flag() = true;
+			++_owner._count;
+			return *this;
+		}
+
+		auto& destruct() {
+			static_assert(C == MUTAB, "called destruct() on CONST accessor");
+			DCHECK( is_constructed() ) << "erasing already erased element";
+			_slot().get().~Val();
+			_flag() = false;
+			--_owner._count;
+			return *this;
+		}
+
+		bool is_constructed() const { return _owner._chunks[ _chunk(_index) ].constructed[ _offset(_index) ]; }
+		bool is_not_constructed() const { return ! is_constructed(); }
+
+		operator Handle() const { return _index; }
+
+	private:
+		Accessor(Const<Stable_Block,C>& owner, Index index) : _owner(owner), _index(index) {}
+		friend Stable_Block;
+
+		auto& _slot() const { return _owner._chunks[ _chunk(_index) ].slots[ _offset(_index) ]; }
+		auto  _flag() const { return _owner._chunks[ _chunk(_index) ].constructed[ _offset(_index) ]; }
+
+	private:
+		Const<Stable_Block,C>& _owner;
+		Index _index;
+	};
+
+
+	//
+	// data
+	//
+private:
+	Chunk _chunks[ Max_Chunks ];
+	int _num_chunks = 0;
+	Index_Int _domain = 0;
+	Index_Int _count = 0;
+
+
+public:
+	Stable_Block() = default;
+
+	Stable_Block(const Stable_Block& o) {
+		resize( o._domain );
+		for(Index_Int i=0; i<_domain; ++i) {
+			if(o(i).is_constructed()) (*this)(i).construct( o[i] );
+		}
+	}
+
+	Stable_Block(Stable_Block&& o) :
+			_num_chunks( std::exchange(o._num_chunks, 0) ),
+			_domain( std::exchange(o._domain, 0) ),
+			_count( std::exchange(o._count, 0) ) {
+		for(int k=0; k<_num_chunks; ++k) _chunks[k] = std::move( o._chunks[k] );
+	}
+
+	Stable_Block& operator=(const Stable_Block& o) {
+		this->~Stable_Block();
+		new(this) Stable_Block(o);
+		return *this;
+	}
+
+	Stable_Block& operator=(Stable_Block&& o) {
+		this->~Stable_Block();
+		new(this) Stable_Block( std::move(o) );
+		return *this;
+	}
+
+	// chunks free themselves
+	~Stable_Block() {
+		for(Index_Int i=0; i<_domain; ++i) {
+			if((*this)(i).is_constructed()) (*this)(i).destruct();
+		}
+	}
+
+
+public:
+	auto& operator[](Index i)       { _check_bounds(i); return _chunks[ _chunk(i) ].slots[ _offset(i) ].get(); }
+	auto& operator[](Index i) const { _check_bounds(i); return _chunks[ _chunk(i) ].slots[ _offset(i) ].get(); }
+
+	auto operator()(Index i)       { _check_bounds(i); return Accessor<MUTAB>(*this, i); }
+	auto operator()(Index i) const { _check_bounds(i); return Accessor<CONST>(*this, i); }
+
+
+	auto operator()(First_Tag)       { return operator()( _first() ); }
+	auto operator()(First_Tag) const { return operator()( _first() ); }
+
+	auto operator()(Last_Tag)       { return operator()( _last() ); }
+	auto operator()(Last_Tag) const { return operator()( _last() ); }
+
+	auto& operator[](First_Tag)       { return operator[]( _first() ); }
+	auto& operator[](First_Tag) const { return operator[]( _first() ); }
+
+	auto& operator[](Last_Tag)       { return operator[]( _last() ); }
+	auto& operator[](Last_Tag) const { return operator[]( _last() ); }
+
+
+	Index_Int domain() const { return _domain; }
+	Index_Int count() const { return _count; }
+	bool is_empty() const { return _count == 0; }
+
+	// only allocates or frees chunks - existing elements are not moved
+	void resize(Index_Int new_size) {
+		DCHECK_GE(new_size, 0);
+		DCHECK_LE(new_size, Max_Domain) << "Array_Allocator size overflows its HANDLE_INT type";
+
+		for(Index_Int i=new_size; i<_domain; ++i) {
+			if((*this)(i).is_constructed()) (*this)(i).destruct();
+		}
+
+		int new_num_chunks = new_size ? _chunk(new_size-1) + 1 : 0;
+		DCHECK_LE(new_num_chunks, Max_Chunks);
+
+		for(int k=_num_chunks; k<new_num_chunks; ++k) {
+			_chunks[k].slots.reset( new Slot[ Index_Int(1) << k ] );
+			_chunks[k].constructed.assign( Index_Int(1) << k, false );
+		}
+		for(int k=new_num_chunks; k<_num_chunks; ++k) _chunks[k] = Chunk();
+
+		_num_chunks = new_num_chunks;
+		_domain = new_size;
+	}
+
+	// index of the first constructed element, or `domain()` if empty
+	Index begin() const {
+		Index_Int i = 0;
+		while(i < _domain && (*this)(i).is_not_constructed()) ++i;
+		return i;
+	}
+
+	// moves elements!
+	template<class CALLBACK>
+	Index_Int compact(CALLBACK&& cb) {
+		Index_Int idx = 0;
+		for(Index_Int i=0; i<_domain; ++i) {
+			if((*this)(i).is_constructed()) {
+				if(idx < i) {
+					(*this)(idx).construct( std::move( (*this)[i] ) );
+					(*this)(i).destruct();
+				}
+				cb(i, idx);
+				++idx;
+			}
+		}
+		resize(idx);
+		return idx;
+	}
+
+	Index_Int compact() {
+		return compact( [](auto&&, auto&&){} );
+	}
+
+
+private:
+	static int _chunk(Index_Int i) { return 63 ^ __builtin_clzll(i+1); }
+	static Index_Int _offset(Index_Int i) { return (i+1) ^ (Index_Int(1) << _chunk(i)); }
+
+	Index _first() const {
+		DCHECK( !is_empty() );
+		return begin();
+	}
+
+	Index _last() const {
+		DCHECK( !is_empty() );
+		Index_Int i = _domain;
+		do --i; while((*this)(i).is_not_constructed());
+		return i;
+	}
+
+	void _check_bounds(Index i) const {
+		DCHECK(i >= 0 && i < _domain) << "index " << i << " out of bounds [0," << _domain << ")";
+	}
+};
+
+
+
+
 template<
 	class _VAL,
-	int _ALIGN
+	int _ALIGN,
+	bool _FREE_BITMAP,
+	bool _STABLE,
+	class _HANDLE_INT,
+	bool _PROBE_STATS
 >
 struct Params {
 	using Val = _VAL;
 	static constexpr auto Align = _ALIGN;
+	static constexpr bool Free_Bitmap = _FREE_BITMAP;
+	static constexpr bool Stable = _STABLE;
+	using Handle_Int = _HANDLE_INT;
+	static constexpr bool Probe_Stats = _PROBE_STATS;
 
-	using Block = typename salgo::Memory_Block<Val> ::CONSTRUCTED_FLAGS ::COUNT ::template ALIGN<Align>;
+	using Block = std::conditional_t<Stable,
+		Stable_Block<Val, Align, Handle_Int>,
+		typename salgo::Memory_Block<Val> ::CONSTRUCTED_FLAGS ::COUNT ::template ALIGN<Align> ::template HANDLE_INT<Handle_Int>
+	>;
 
 
 	using Handle       = typename Block::Handle;
 	using Handle_Small = typename Block::Handle_Small;
 	using Index        = typename Block::Index;
+	using Index_Int    = typename Block::Index_Int;
 };
 
 
@@ -62,11 +326,13 @@ public:
 	void construct() {
 		static_assert(C == MUTAB, "called construct() on CONST accessor");
 		CONT.v( HANDLE ).construct();
+		if constexpr(P::Free_Bitmap) CONT.free_slots.reset( HANDLE );
 	}
 
 	void destruct() {
 		static_assert(C == MUTAB, "called destruct() on CONST accessor");
 		CONT.v( HANDLE ).destruct();
+		if constexpr(P::Free_Bitmap) CONT.free_slots.set( HANDLE );
 	}
 
 	void erase() { destruct(); } // alias
@@ -135,7 +401,11 @@ struct Context {
 
 
 template<class P>
-class Array_Allocator : protected P {
+class Array_Allocator :
+		protected P,
+		private Add_free_slots<salgo::_::Hierarchical_Bitset<typename P::Index_Int>, P::Free_Bitmap>,
+		private Add_probes<salgo::_::Probe_Stats, P::Probe_Stats> {
+
 	friend Accessor<P,CONST>;
 	friend Accessor<P,MUTAB>;
 
@@ -147,25 +417,38 @@ public:
 	using typename P::Handle_Small;
 	using typename P::Handle;
 	using typename P::Index;
+	using typename P::Index_Int;
 
 	using P::Align;
 	static constexpr bool Auto_Destruct = true;
+	static constexpr bool Has_Free_Bitmap = P::Free_Bitmap;
+
+	// with `::STABLE`, elements are never moved
+	static constexpr bool Is_Persistent = P::Stable;
+
+	// max number of slots, limited by `::HANDLE_INT<INT>`
+	static constexpr Index_Int Max_Domain = P::Block::Max_Domain;
 
 private:
 	typename P::Block v;
 	Index lookup_index = 0;
 
+	// `free_slots` has a bit set for each unconstructed slot
+	using FREE_SLOTS_BASE = Add_free_slots<salgo::_::Hierarchical_Bitset<Index_Int>, P::Free_Bitmap>;
+	using PROBES_BASE = Add_probes<salgo::_::Probe_Stats, P::Probe_Stats>;
+
 public:
 	Array_Allocator() = default;
 
 	// reserve and construct `num_starting_elements`
 	template<class... ARGS>
-	Array_Allocator(int num_starting_elements, ARGS... args) :
+	Array_Allocator(Index_Int num_starting_elements, ARGS... args) :
 			v(num_starting_elements),
 			lookup_index(num_starting_elements) {
-		for(int i=0; i<num_starting_elements; ++i) {
+		for(Index_Int i=0; i<num_starting_elements; ++i) {
 			v(i).construct( args... );
 		}
+		if constexpr(P::Free_Bitmap) FREE_SLOTS_BASE::free_slots.resize( num_starting_elements );
 	}
 
 
@@ -173,23 +456,34 @@ public:
 public:
 	template<class... ARGS>
 	auto construct(ARGS&&... args) {
-		static_assert(std::is_move_constructible_v<Val>, "Array_Allocator must be able to move its elements");
+		static_assert(P::Stable || std::is_move_constructible_v<Val>, "Array_Allocator must be able to move its elements (or use ::STABLE)");
 
-		// grow if needed
-		if(v.count()*2 >= v.domain()) {
-			// std::cout << "grow array allocator from " << v.domain() << " to " << v.domain()*2+1 << std::endl;
+		_grow_if_needed();
 
-			//lookup_index = v.size();
-			v.resize( v.domain()*2 + 1 );
+		if constexpr(P::Free_Bitmap) {
+			Index_Int i = FREE_SLOTS_BASE::free_slots.find_next( lookup_index );
+			if(i == -1) i = FREE_SLOTS_BASE::free_slots.find_first();
+			DCHECK_NE(-1, i);
 
-			// std::cout << "grow array allocator done" << std::endl;
-		}
+			// same count as the linear scan would have
+			if constexpr(P::Probe_Stats) {
+				Index_Int skipped = i - (Index_Int)lookup_index;
+				PROBES_BASE::probes.add( skipped < 0 ? skipped + v.domain() : skipped );
+			}
 
-		while( v(lookup_index).is_constructed() ) {
-			++lookup_index;
-			if((int)lookup_index == v.domain()) {
-				lookup_index = 0;
+			lookup_index = i;
+		}
+		else {
+			int skipped = 0;
+			while( v(lookup_index).is_constructed() ) {
+				++skipped;
+				++lookup_index;
+				if((Index_Int)lookup_index == v.domain()) {
+					lookup_index = 0;
+				}
 			}
+
+			if constexpr(P::Probe_Stats) PROBES_BASE::probes.add( skipped );
 		}
 
 		auto index = lookup_index;
@@ -199,33 +493,55 @@ public:
 			lookup_index = 0;
 		}
 
-		return Accessor<P,MUTAB>( this, v(index).construct( std::forward<ARGS>(args)... ) );
+		return _construct_at( index, std::forward<ARGS>(args)... );
 	}
 
+	//
+	// construct in a free slot at most `Near_Window` slots away from `hint`, if possible
+	// otherwise, same as `construct()`
+	//
+	// `lookup_index` is not moved to the hint, so later `construct()` calls don't scan dense areas
+	//
 	template<class... ARGS>
-	auto construct_near(Handle, ARGS&&... args) {
-		//lookup_index = (int)h + 1;
-		// TODO: currently we don't use hints, because this can kill performance if not done right
+	auto construct_near(Handle hint, ARGS&&... args) {
+		static_assert(P::Stable || std::is_move_constructible_v<Val>, "Array_Allocator must be able to move its elements (or use ::STABLE)");
+
+		_grow_if_needed(); // keeps indices
+
+		if(hint.valid()) {
+			for(int d=1; d<=Near_Window; ++d) {
+				Index_Int idx = (Index_Int)hint + d;
+				if(idx < v.domain() && v(idx).is_not_constructed()) return _construct_at( idx, std::forward<ARGS>(args)... );
+
+				idx = (Index_Int)hint - d;
+				if(idx >= 0 && v(idx).is_not_constructed()) return _construct_at( idx, std::forward<ARGS>(args)... );
+			}
+		}
+
 		return construct( std::forward<ARGS>(args)... );
 	}
 
+	static constexpr int Near_Window = 8;
+
 	template<class... ARGS>
 	auto add(ARGS&&... args) { return construct( std::forward<ARGS>(args)... ); } // alias
 
 
 	template<class... ARGS>
-	void resize(int new_size, ARGS&&... args) {
+	void resize(Index_Int new_size, ARGS&&... args) {
 		auto old_size = v.domain();
 		v.resize(new_size);
-		for(int i=old_size; i<new_size; ++i) {
+		if constexpr(P::Free_Bitmap) FREE_SLOTS_BASE::free_slots.resize( new_size, true );
+		for(Index_Int i=old_size; i<new_size; ++i) {
 			operator()(i).construct( args... );
 		}
 	}
 
-	void reserve(int reserve_size) {
+	void reserve(Index_Int reserve_size) {
 		if(reserve_size <= v.domain()) return;
 
 		v.resize( reserve_size );
+		if constexpr(P::Free_Bitmap) FREE_SLOTS_BASE::free_slots.resize( reserve_size, true );
 	}
 
 
@@ -258,6 +574,15 @@ public:
 
 	auto domain() const { return v.domain(); }
 
+	// memory held for elements (constructed or not)
+	long long bytes_reserved() const { return (long long)v.domain() * sizeof(Val); }
+
+	// hole search statistics of `construct()`, if enabled with `::PROBE_STATS`
+	const auto& probe_stats() const {
+		static_assert(P::Probe_Stats, "enable with ::PROBE_STATS");
+		return PROBES_BASE::probes;
+	}
+
 public:
 	auto begin()       { return Iterator<P,MUTAB>(this, v.begin()); }
 	auto begin() const { return Iterator<P,CONST>(this, v.begin()); }
@@ -265,7 +590,36 @@ public:
 	auto end() const { return End_Iterator<P>(); }
 
 	template<class... ARGS>
-	auto compact(ARGS&&... args) { return v.compact( std::forward<ARGS>(args)... ); }
+	auto compact(ARGS&&... args) {
+		auto r = v.compact( std::forward<ARGS>(args)... );
+		if constexpr(P::Free_Bitmap) {
+			FREE_SLOTS_BASE::free_slots.resize(0);
+			FREE_SLOTS_BASE::free_slots.resize( v.domain() );
+		}
+		return r;
+	}
+
+
+private:
+	void _grow_if_needed() {
+		if(v.count()*2 >= v.domain() && v.domain() < Max_Domain) {
+			// std::cout << "grow array allocator from " << v.domain() << " to " << v.domain()*2+1 << std::endl;
+
+			//lookup_index = v.size();
+			v.resize( (Index_Int)std::min( v.domain()*2LL + 1, (long long)Max_Domain ) );
+			if constexpr(P::Free_Bitmap) FREE_SLOTS_BASE::free_slots.resize( v.domain(), true );
+
+			// std::cout << "grow array allocator done" << std::endl;
+		}
+
+		DCHECK_LT(v.count(), Max_Domain) << "Array_Allocator overflows its HANDLE_INT type";
+	}
+
+	template<class... ARGS>
+	auto _construct_at(Index index, ARGS&&... args) {
+		if constexpr(P::Free_Bitmap) FREE_SLOTS_BASE::free_slots.reset( index );
+		return Accessor<P,MUTAB>( this, v(index).construct( std::forward<ARGS>(args)... ) );
+	}
 };
 
 
@@ -282,12 +636,30 @@ public:
 
 	using typename P::Val;
 	using P::Align;
+	using P::Free_Bitmap;
+	using P::Stable;
+	using typename P::Handle_Int;
+	using P::Probe_Stats;
 
 	template<class X>
-	using VAL = With_Builder<Params<X, Align>>;
+	using VAL = With_Builder<Params<X, Align, Free_Bitmap, Stable, Handle_Int, Probe_Stats>>;
 
 	template<int X>
-	using ALIGN = With_Builder<Params<Val, X>>;
+	using ALIGN = With_Builder<Params<Val, X, Free_Bitmap, Stable, Handle_Int, Probe_Stats>>;
+
+	// O(log_64 N) hole finding, instead of linear scan
+	using FREE_BITMAP = With_Builder<Params<Val, Align, true, Stable, Handle_Int, Probe_Stats>>;
+
+	// never move elements: store them in chunks of doubling sizes
+	using STABLE = With_Builder<Params<Val, Align, Free_Bitmap, true, Handle_Int, Probe_Stats>>;
+
+	// integer type used by handles (and node links of containers using this allocator),
+	// e.g. `uint16_t` for small containers
+	template<class X>
+	using HANDLE_INT = With_Builder<Params<Val, Align, Free_Bitmap, Stable, X, Probe_Stats>>;
+
+	// count hole search lengths in `construct()`, see `probe_stats()`
+	using PROBE_STATS = With_Builder<Params<Val, Align, Free_Bitmap, Stable, Handle_Int, true>>;
 };
 
 
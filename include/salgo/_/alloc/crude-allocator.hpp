@@ -5,18 +5,45 @@
 #include "../handles.hpp"
 #include "../global-instance.hpp"
 #include "../subscript-tags.hpp"
+#include "../add-member.hpp"
 
 #include <glog/logging.h>
 
+#include <algorithm> // std::min
+#include <array>
+#include <cstring> // memcpy
+#include <limits>
+#include <type_traits>
+
 namespace salgo::_::crude_allocator {
 
 
+static const int block_bits = 5;
+
+using H0 = Int_Handle<int,(1<<block_bits)-1>;
+
+
 template<
 	class VAL,
 	bool AUTO_DESTRUCT,
-	bool SINGLETON
+	bool SINGLETON,
+	bool REUSE,
+	class HANDLE_INT
 >
-struct Params {};
+struct Params {
+	// `Handle_Small` packs `block_bits` of block index and `Div` bits of offset inside the block
+	using Handle_Int = std::make_unsigned_t<HANDLE_INT>;
+	static_assert(sizeof(Handle_Int) >= 2, "HANDLE_INT type too small");
+
+	static constexpr int Div = std::min( 8*(int)sizeof(Handle_Int) - block_bits, 31 ); // offsets are `int`
+
+	static constexpr int Max_Blocks = (1 << block_bits) - 1; // the last block index is the invalid handle
+	static constexpr int Max_Block_Size = Div == 31 ? std::numeric_limits<int>::max() : 1 << Div;
+};
+
+
+
+SALGO_ADD_MEMBER(reuse)
 
 
 
@@ -25,15 +52,11 @@ struct Params {};
 //
 // defined outside Context to specialize std::hash<>
 //
-// parametrized by unused context X, to make Handles from different Contexts incompatible
+// parametrized by Params X, to make Handles from different Contexts incompatible
 //
 template<class> struct Handle;
 template<class> struct Handle_Small;
 
-static const int div = 27;
-
-using H0 = Int_Handle<int,(1<<(32-div))-1>;
-
 // big
 template<class X>
 struct Handle : Pair_Handle_Base<Handle<X>, H0, int> {
@@ -43,8 +66,8 @@ struct Handle : Pair_Handle_Base<Handle<X>, H0, int> {
 
 	template<class A, class B>
 	Handle(A aa, B bb) : BASE(aa,bb) {
-		DCHECK_GE(aa, 0); DCHECK_LT(aa, 1<<(32-div));
-		DCHECK_GE(bb, 0); DCHECK_LT(bb, 1<<div);
+		DCHECK_GE(aa, 0); DCHECK_LE(aa, X::Max_Blocks); // == for the invalid handle
+		DCHECK_GE(bb, 0); DCHECK_LT(bb, 1LL<<X::Div);
 	}
 };
 
@@ -52,25 +75,28 @@ struct Handle : Pair_Handle_Base<Handle<X>, H0, int> {
 
 // small
 template<class X>
-struct Handle_Small : Int_Handle_Base<Handle_Small<X>, unsigned int> {
-	using BASE = Int_Handle_Base<Handle_Small<X>, unsigned int>;
+struct Handle_Small : Int_Handle_Base<Handle_Small<X>, typename X::Handle_Int> {
+	using Int = typename X::Handle_Int;
+	using BASE = Int_Handle_Base<Handle_Small<X>, Int>;
+	static constexpr int Div = X::Div;
 
 
 	Handle_Small() = default;
-	Handle_Small(unsigned int v) : BASE(v) {}
+	Handle_Small(Int v) : BASE(v) {}
 
 	Handle_Small( const Handle<X>& h ) { *this = h; }
 	Handle_Small& operator=(const Handle<X>& h) {
-		DCHECK_LT(h.a, 1<<(32-div));
-		DCHECK_LT(h.b, 1<<div);
-		*this = (h.a << div) | h.b;
+		DCHECK_LE(h.a, X::Max_Blocks);
+		DCHECK_LT(h.b, 1LL<<Div) << "Crude_Allocator offset overflows its HANDLE_INT type";
+		*this = Handle_Small( Int( (Int(h.a) << Div) | Int(h.b) ) );
 		//LOG(INFO) << h << " -> " << *this;
 		return *this;
 	}
 
 	operator Handle<X>() const {
-		//LOG(INFO) << *this << " -> " << Handle<X>((*this)>>div, (*this)&((1<<div)-1));
-		return Handle<X>(H0((*this)>>div), (*this)&((1<<div)-1));
+		Int v = *this;
+		//LOG(INFO) << *this << " -> " << Handle<X>(v>>Div, v&((1<<Div)-1));
+		return Handle<X>(H0( int(v >> Div) ), int( v & ((Int(1) << Div) - 1) ));
 	}
 };
 
@@ -85,11 +111,13 @@ struct Handle_Small : Int_Handle_Base<Handle_Small<X>, unsigned int> {
 template<
 	class _VAL,
 	bool  _AUTO_DESTRUCT,
-	bool  _SINGLETON
+	bool  _SINGLETON,
+	bool  _REUSE,
+	class _HANDLE_INT
 >
 struct Context {
 
-	using P = Params<_VAL, _AUTO_DESTRUCT, _SINGLETON>;
+	using P = Params<_VAL, _AUTO_DESTRUCT, _SINGLETON, _REUSE, _HANDLE_INT>;
 
 	//
 	// TEMPLATE PARAMETERS
@@ -97,6 +125,13 @@ struct Context {
 	using Val = _VAL;
 	static constexpr bool Auto_Destruct = _AUTO_DESTRUCT;
 	static constexpr bool Singleton = _SINGLETON;
+	static constexpr bool Reuse = _REUSE;
+	using Handle_Int = _HANDLE_INT;
+
+	static constexpr int Max_Blocks = P::Max_Blocks;
+
+	// same sizes as the blocks appended in non-REUSE mode: 2, 6, 14, 30, ... (up to `Max_Block_Size`)
+	static constexpr int block_size(int a) { return (int)std::min( (4LL << a) - 2, (long long)P::Max_Block_Size ); }
 
 
 	using Memory_Block = std::conditional_t<
@@ -172,9 +207,32 @@ struct Context {
 
 
 
-	class Crude_Allocator {
+	//
+	// REUSE mode bookkeeping
+	//
+	struct Block_Info {
+		int free_head = -1; // intrusive free list, links are stored inside destructed slots
+		int filled = 0; // slots past `filled` were never used
+		int num_existing = 0;
+		bool released = false;
+	};
+
+	struct Reuse_State {
+		std::array<Block_Info, Max_Blocks> blocks;
+		int current = -1; // block used for new allocations
+	};
+
+
+
+
+
+	class Crude_Allocator : private Add_reuse<Reuse_State, Reuse> {
+		using REUSE_BASE = Add_reuse<Reuse_State, Reuse>;
+
 	private:
-		salgo::Dynamic_Array< Memory_Block > v;
+		// fixed-size block table: element access doesn't read anything that adding blocks writes
+		std::array< Memory_Block, Max_Blocks > v;
+		int num_blocks = 0;
 		int current_filled = 0;
 		int current_max_size = 0;
 
@@ -183,37 +241,162 @@ struct Context {
 		using Handle_Small = Context::Handle_Small;
 		using       Handle = Context::      Handle;
 
+		static constexpr bool Has_Reuse = Reuse;
+
+		// elements never move
+		static constexpr bool Is_Persistent = true;
+
+		// element access can run concurrently with construct() / destruct() of other elements (see Thread_Cached)
+		static constexpr bool Has_Lock_Free_Access = true;
+
 
 	public:
 		template<class... ARGS>
 		auto construct(ARGS&&... args) {
+			if constexpr(Reuse) return _construct_reuse( std::forward<ARGS>(args)... );
+			else return _construct_bump( std::forward<ARGS>(args)... );
+		}
+
+		// without REUSE, memory is never reused, so new elements are always placed right after the most recently constructed one
+		// with REUSE, free slots of the hint's block are taken first
+		template<class... ARGS>
+		auto construct_near(Handle hint, ARGS&&... args) {
+			if constexpr(Reuse) {
+				if(hint.valid() && (int)hint.a < num_blocks && _has_room(hint.a)) return _construct_in( hint.a, std::forward<ARGS>(args)... );
+			}
+			return construct(std::forward<ARGS>(args)...);
+		}
+
+
+		void destruct( Handle h ) {
+			v[h.a](h.b).destruct();
+
+			if constexpr(Reuse) {
+				auto& r = REUSE_BASE::reuse;
+				auto& block = r.blocks[h.a];
+
+				_set_link(h, block.free_head);
+				block.free_head = h.b;
+				--block.num_existing;
+
+				if(block.num_existing == 0) {
+					// give memory back, unless new elements are being allocated from this block
+					if(h.a != r.current) {
+						v[h.a] = Memory_Block();
+						block = Block_Info();
+						block.released = true;
+					}
+					// otherwise start it over: drop the free list, bump from the beginning
+					else {
+						block.free_head = -1;
+						block.filled = 0;
+					}
+				}
+			}
+		}
+
+		auto& operator[]( Handle h )       { return v[h.a][h.b]; }
+		auto& operator[]( Handle h ) const { return v[h.a][h.b]; }
+
+		auto operator()( Handle h )       { return Accessor<MUTAB>(*this, h); }
+		auto operator()( Handle h ) const { return Accessor<CONST>(*this, h); }
+
+		// memory held for elements (constructed or not)
+		long long bytes_reserved() const {
+			long long result = 0;
+			for(int a=0; a<num_blocks; ++a) result += v[a].domain();
+			return result * sizeof(Val);
+		}
+
+
+	private:
+		template<class... ARGS>
+		auto _construct_bump(ARGS&&... args) {
 			if(current_filled >= current_max_size) {
-				current_max_size = (current_max_size+1) << 1;
-				v.emplace_back( current_max_size );
+				current_max_size = (int)std::min( (current_max_size+1LL) << 1, (long long)P::Max_Block_Size );
+				_add_block( current_max_size );
 				current_filled = 0;
 			}
 
-			v[LAST](current_filled).construct( std::forward<ARGS>(args)... );
+			v[num_blocks-1](current_filled).construct( std::forward<ARGS>(args)... );
 
-			Handle handle = {H0(v.size()-1), current_filled++};
+			Handle handle = {H0(num_blocks-1), current_filled++};
 
 			return Accessor<MUTAB>( *this, handle );
 		}
 
+
 		template<class... ARGS>
-		auto construct_near(Handle, ARGS&&... args) {
-			// TODO
-			return construct(std::forward<ARGS>(args)...);
+		auto _construct_reuse(ARGS&&... args) {
+			auto& r = REUSE_BASE::reuse;
+			if(r.current == -1 || !_has_room(r.current)) r.current = _pick_block();
+
+			return _construct_in( r.current, std::forward<ARGS>(args)... );
 		}
 
+		// block `a` must have room
+		template<class... ARGS>
+		auto _construct_in(int a, ARGS&&... args) {
+			static_assert(sizeof(Val) >= sizeof(int), "REUSE requires elements big enough to hold a free list link");
 
-		void destruct(       Handle h )  { v[h.a](h.b).destruct(); }
+			auto& block = REUSE_BASE::reuse.blocks[a];
 
-		auto& operator[]( Handle h )       { return v[h.a][h.b]; }
-		auto& operator[]( Handle h ) const { return v[h.a][h.b]; }
+			int b;
+			if(block.free_head != -1) {
+				b = block.free_head;
+				block.free_head = _get_link( Handle(H0(a), b) );
+			}
+			else b = block.filled++;
 
-		auto operator()( Handle h )       { return Accessor<MUTAB>(*this, h); }
-		auto operator()( Handle h ) const { return Accessor<CONST>(*this, h); }
+			++block.num_existing;
+
+			v[a](b).construct( std::forward<ARGS>(args)... );
+
+			return Accessor<MUTAB>( *this, Handle(H0(a), b) );
+		}
+
+		bool _has_room(int a) const {
+			auto& block = REUSE_BASE::reuse.blocks[a];
+			return !block.released && (block.free_head != -1 || block.filled < block_size(a));
+		}
+
+		// the fullest block that still has room - so that the other blocks can drain and be released
+		int _pick_block() {
+			auto& r = REUSE_BASE::reuse;
+
+			int best = -1;
+			for(int a=0; a<num_blocks; ++a) {
+				if(!_has_room(a)) continue;
+				if(best == -1 || (long long)r.blocks[a].num_existing * block_size(best) >
+						(long long)r.blocks[best].num_existing * block_size(a)) best = a;
+			}
+			if(best != -1) return best;
+
+			// re-allocate the biggest released block
+			for(int a=num_blocks-1; a>=0; --a) {
+				if(!r.blocks[a].released) continue;
+				v[a] = Memory_Block( block_size(a) );
+				r.blocks[a] = Block_Info();
+				return a;
+			}
+
+			_add_block( block_size(num_blocks) );
+			return num_blocks-1;
+		}
+
+		void _add_block(int size) {
+			CHECK_LT(num_blocks, Max_Blocks) << "Crude_Allocator out of handle space";
+			v[num_blocks++] = Memory_Block(size);
+		}
+
+		// the free list link lives in the raw storage of a destructed element
+		void _set_link(Handle h, int link) { std::memcpy( v[h.a](h.b).raw_storage(), &link, sizeof(int) ); }
+
+		int _get_link(Handle h) const {
+			int link;
+			std::memcpy( &link, v[h.a](h.b).raw_storage(), sizeof(int) );
+			return link;
+		}
 	};
 
 
@@ -225,6 +408,10 @@ struct Context {
 	class Allocator_Proxy {
 		static auto& _get() { return global_instance<Crude_Allocator>(); }
 
+	public:
+		// all instances refer to the same allocator
+		static constexpr bool Is_Shared = true;
+
 	public:
 		using          Val = typename Crude_Allocator::Val;
 		using Handle_Small = typename Crude_Allocator::Handle_Small;
@@ -234,6 +421,9 @@ struct Context {
 		template<class... ARGS>
 		auto construct(ARGS&&... args) { return _get(). construct( std::forward<ARGS>(args)... ); }
 
+		template<class... ARGS>
+		auto construct_near(ARGS&&... args) { return _get(). construct_near( std::forward<ARGS>(args)... ); }
+
 		template<class... ARGS>
 		auto  destruct(ARGS&&... args) { return _get().  destruct( std::forward<ARGS>(args)... ); }
 
@@ -270,13 +460,22 @@ struct Context {
 
 		template<class NEW_VAL>
 		using VAL = typename
-			Context<NEW_VAL, Auto_Destruct, Singleton> :: With_Builder;
+			Context<NEW_VAL, Auto_Destruct, Singleton, Reuse, Handle_Int> :: With_Builder;
 
 		using AUTO_DESTRUCT = typename
-			Context<Val, true, Singleton> :: With_Builder;
+			Context<Val, true, Singleton, Reuse, Handle_Int> :: With_Builder;
 
 		using SINGLETON = typename
-			Context<Val, Auto_Destruct, true> :: With_Builder;
+			Context<Val, Auto_Destruct, true, Reuse, Handle_Int> :: With_Builder;
+
+		using REUSE = typename
+			Context<Val, Auto_Destruct, Singleton, true, Handle_Int> :: With_Builder;
+
+		// integer type of `Handle_Small` (used for node links of containers):
+		// 5 bits of block index, the rest (up to 31 bits) for offset inside the block
+		template<class X>
+		using HANDLE_INT = typename
+			Context<Val, Auto_Destruct, Singleton, Reuse, X> :: With_Builder;
 	};
 
 
@@ -297,7 +496,9 @@ template<
 using Crude_Allocator = typename _::crude_allocator::Context<
 	VAL,
 	false, // auto-destruct
-	false // singleton
+	false, // singleton
+	false, // reuse
+	int // handle int
 >::With_Builder;
 
 
@@ -0,0 +1,275 @@
+#pragma once
+
+#include "probe-stats.hpp"
+
+#include "../has-member.hpp"
+#include "../const-flag.hpp"
+
+#include <type_traits>
+#include <utility> // std::forward
+
+namespace salgo::_::instrumented {
+
+
+
+SALGO_GENERATE_HAS_MEMBER(bytes_reserved)
+
+
+
+// turn on `::PROBE_STATS` if the allocator has it
+template<class ALLOCATOR, class = void>
+struct With_Probe_Stats {
+	using Type = ALLOCATOR;
+	static constexpr bool value = false;
+};
+
+template<class ALLOCATOR>
+struct With_Probe_Stats<ALLOCATOR, std::void_t<typename ALLOCATOR::PROBE_STATS>> {
+	using Type = typename ALLOCATOR::PROBE_STATS;
+	static constexpr bool value = true;
+};
+
+
+
+// snapshot returned by `stats()`
+struct Stats {
+	long long constructs = 0;
+	long long destructs = 0;
+	long long live = 0;
+	long long peak_live = 0;
+
+	long long bytes_used = 0; // `live * sizeof(Val)`
+	long long bytes_reserved = 0; // memory held by the allocator (0 if it doesn't report it)
+
+	Probe_Stats probes; // hole search lengths (zeros if the allocator has no `::PROBE_STATS`)
+};
+
+
+
+
+//
+// statistics wrapper for a salgo allocator
+//
+// counts construct/destruct calls made through it, and collects the allocator's own statistics
+// it's a separate type, so non-instrumented allocators don't pay anything
+//
+template<
+	class _ALLOCATOR
+>
+struct Context {
+
+	//
+	// TEMPLATE PARAMETERS
+	//
+	using Supplied_Allocator = _ALLOCATOR;
+
+	using Backing = typename With_Probe_Stats<Supplied_Allocator>::Type;
+	static constexpr bool Has_Probe_Stats = With_Probe_Stats<Supplied_Allocator>::value;
+
+	using          Val = typename Backing::Val;
+	using       Handle = typename Backing::Handle;
+	using Handle_Small = typename Backing::Handle_Small;
+
+
+
+
+	// forward
+	class Instrumented;
+
+	template<Const_Flag C, class BACKING_ITERATOR>
+	class Iterator;
+
+
+
+
+	//
+	// accessor
+	//
+	template<Const_Flag C>
+	class Accessor {
+	public:
+		// get handle
+		auto     handle() const { return _handle; }
+		operator   auto() const { return handle(); }
+
+		auto& operator()()       { return (*_owner)[_handle]; }
+		auto& operator()() const { return (*_owner)[_handle]; }
+		operator auto&()       { return operator()(); }
+		operator auto&() const { return operator()(); }
+
+		void destruct() {
+			static_assert(C == MUTAB, "called destruct() on CONST accessor");
+			_owner->destruct( _handle );
+		}
+
+		auto iterator() const { return _owner->_iterator( _owner->Backing::operator()( _handle ).iterator() ); }
+
+
+	private:
+		Accessor(Const<Instrumented,C>& owner, Handle handle)
+			: _owner(&owner), _handle(handle) {}
+
+		friend Instrumented;
+
+		template<Const_Flag, class>
+		friend class Iterator;
+
+
+	private:
+		Const<Instrumented,C>* _owner;
+		Handle _handle;
+	};
+
+
+
+
+	//
+	// iterator - walks the wrapped allocator, but gives accessors of the wrapper (so `destruct()` is counted)
+	//
+	template<Const_Flag C, class BACKING_ITERATOR>
+	class Iterator {
+	public:
+		auto     handle() const { return Handle( _it.handle() ); }
+		operator Handle() const { return handle(); }
+
+		auto& operator*()  { _accessor._handle = handle(); return _accessor; }
+		auto  operator->() { return &operator*(); }
+
+		auto& operator++() { ++_it; return *this; }
+		auto& operator--() { --_it; return *this; }
+
+		template<Const_Flag CC, class IT>
+		bool operator!=(const Iterator<CC,IT>& o) const { return _it != o._it; }
+
+		template<Const_Flag CC, class IT>
+		bool operator==(const Iterator<CC,IT>& o) const { return !(*this != o); }
+
+
+	private:
+		Iterator(Const<Instrumented,C>& owner, BACKING_ITERATOR it)
+			: _it(it), _accessor(owner, Handle()) {}
+
+		friend Instrumented;
+
+		template<Const_Flag, class>
+		friend class Iterator;
+
+
+	private:
+		BACKING_ITERATOR _it;
+		Accessor<C> _accessor;
+	};
+
+
+
+
+	class Instrumented : public Backing {
+	public:
+		using          Val = Context::Val;
+		using Handle_Small = Context::Handle_Small;
+		using       Handle = Context::Handle;
+
+
+	public:
+		template<class... ARGS>
+		auto construct(ARGS&&... args) {
+			Handle handle = Backing::construct( std::forward<ARGS>(args)... ).handle();
+			_on_construct();
+			return Accessor<MUTAB>( *this, handle );
+		}
+
+		template<class... ARGS>
+		auto construct_near(Handle hint, ARGS&&... args) {
+			Handle handle = Backing::construct_near( hint, std::forward<ARGS>(args)... ).handle();
+			_on_construct();
+			return Accessor<MUTAB>( *this, handle );
+		}
+
+		void destruct(Handle handle) {
+			Backing::operator()( handle ).destruct();
+			++_destructs;
+		}
+
+
+		auto operator()(Handle handle)       { return Accessor<MUTAB>(*this, handle); }
+		auto operator()(Handle handle) const { return Accessor<CONST>(*this, handle); }
+
+
+		auto begin()       { return _iterator( Backing::begin() ); }
+		auto begin() const { return _iterator( Backing::begin() ); }
+
+		auto end()       { return _iterator( Backing::end() ); }
+		auto end() const { return _iterator( Backing::end() ); }
+
+
+	public:
+		Stats stats() const {
+			Stats s;
+			s.constructs = _constructs;
+			s.destructs = _destructs;
+			s.live = _constructs - _destructs;
+			s.peak_live = _peak_live;
+
+			s.bytes_used = s.live * (long long)sizeof(Val);
+			if constexpr(has_member__bytes_reserved<Backing>) s.bytes_reserved = Backing::bytes_reserved();
+
+			if constexpr(Has_Probe_Stats) s.probes = Backing::probe_stats();
+			return s;
+		}
+
+		// counters only - the allocator's own statistics are kept
+		void reset_stats() {
+			_constructs = _destructs = _peak_live = 0;
+		}
+
+
+	private:
+		template<Const_Flag>
+		friend class Accessor;
+
+		template<class IT> auto _iterator(IT it)       { return Iterator<MUTAB,IT>(*this, it); }
+		template<class IT> auto _iterator(IT it) const { return Iterator<CONST,IT>(*this, it); }
+
+		void _on_construct() {
+			++_constructs;
+			if(_constructs - _destructs > _peak_live) _peak_live = _constructs - _destructs;
+		}
+
+		long long _constructs = 0;
+		long long _destructs = 0;
+		long long _peak_live = 0;
+	};
+
+
+
+
+	struct With_Builder : Instrumented {
+
+		template<class NEW_VAL>
+		using VAL = typename
+			Context<typename Supplied_Allocator ::template VAL<NEW_VAL>> :: With_Builder;
+	};
+
+
+}; // struct Context
+
+}  // namespace salgo::_::instrumented
+
+
+
+
+
+
+namespace salgo {
+
+template<
+	class ALLOCATOR
+>
+using Instrumented = typename _::instrumented::Context<
+	ALLOCATOR
+>::With_Builder;
+
+using Allocator_Stats = _::instrumented::Stats;
+
+} // namespace salgo
+
@@ -0,0 +1,140 @@
+#pragma once
+
+#include "arena-allocator.hpp" // Arena
+
+#include <glog/logging.h>
+
+#include <algorithm> // std::max
+#include <cstddef> // std::max_align_t
+#include <memory_resource>
+
+namespace salgo::_::memory_resource {
+
+
+
+//
+// `std::pmr::memory_resource` backed by salgo arenas
+//
+// requests are rounded up to power-of-two size classes (`Min_Size` .. `Max_Size` bytes);
+// each size class bump-allocates from its own `Arena` and keeps freed blocks in an intrusive free list,
+// so blocks of a class are packed together and reused LIFO
+//
+// bigger or over-aligned requests are forwarded to the upstream resource
+//
+// not thread-safe (like `std::pmr::unsynchronized_pool_resource`)
+//
+class Salgo_Memory_Resource : public std::pmr::memory_resource {
+public:
+	static constexpr int Min_Bits = 3; // free list link has to fit
+	static constexpr int Max_Bits = 12;
+
+	static constexpr int Min_Size = 1 << Min_Bits;
+	static constexpr int Max_Size = 1 << Max_Bits;
+
+	static constexpr int Num_Classes = Max_Bits - Min_Bits + 1;
+
+private:
+	using Arena = salgo::alloc::_::arena_allocator::Arena;
+	using Arena_Handle = salgo::alloc::_::arena_allocator::Handle<Salgo_Memory_Resource>;
+
+	struct Free_Block { Free_Block* next; };
+
+	struct Size_Class {
+		Arena arena;
+		Free_Block* free = nullptr;
+	};
+
+	Size_Class _classes[Num_Classes];
+	std::pmr::memory_resource* _upstream;
+
+
+public:
+	explicit Salgo_Memory_Resource(std::pmr::memory_resource* upstream = std::pmr::get_default_resource())
+		: _upstream(upstream) { DCHECK(upstream); }
+
+	Salgo_Memory_Resource(const Salgo_Memory_Resource&) = delete;
+	Salgo_Memory_Resource& operator=(const Salgo_Memory_Resource&) = delete;
+
+
+public:
+	// size class that serves a request, or -1 if it goes upstream
+	static int size_class(std::size_t bytes, std::size_t align) {
+		if(align > alignof(std::max_align_t)) return -1;
+
+		std::size_t size = std::max({ bytes, align, (std::size_t)Min_Size });
+		if(size > (std::size_t)Max_Size) return -1;
+
+		return (63 ^ __builtin_clzll(size - 1)) + 1 - Min_Bits; // ceil(log2(size)) - Min_Bits
+	}
+
+	static constexpr int class_size(int c) { return Min_Size << c; }
+
+
+	// frees all memory of the size classes at once - blocks allocated from them become invalid
+	//
+	// (upstream allocations are not tracked - they have to be deallocated one by one)
+	void release() {
+		for(auto& c : _classes) {
+			c.arena.release();
+			c.free = nullptr;
+		}
+	}
+
+	// memory held by the size classes
+	long long bytes_reserved() const {
+		long long result = 0;
+		for(auto& c : _classes) result += c.arena.capacity();
+		return result;
+	}
+
+	auto upstream_resource() const { return _upstream; }
+
+
+protected:
+	void* do_allocate(std::size_t bytes, std::size_t align) override {
+		int c = size_class(bytes, align);
+		if(c == -1) return _upstream->allocate(bytes, align);
+
+		auto& sc = _classes[c];
+		if(sc.free) {
+			auto block = sc.free;
+			sc.free = block->next;
+			return block;
+		}
+
+		int size = class_size(c);
+		auto h = sc.arena.allocate<Arena_Handle>( size, std::min(size, (int)alignof(std::max_align_t)) );
+		return sc.arena.ptr( h.a, h.b );
+	}
+
+	void do_deallocate(void* p, std::size_t bytes, std::size_t align) override {
+		int c = size_class(bytes, align);
+		if(c == -1) {
+			_upstream->deallocate(p, bytes, align);
+			return;
+		}
+
+		auto block = static_cast<Free_Block*>(p);
+		block->next = _classes[c].free;
+		_classes[c].free = block;
+	}
+
+	bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+		return this == &other;
+	}
+};
+
+
+
+} // namespace salgo::_::memory_resource
+
+
+
+
+
+
+namespace salgo {
+
+using Salgo_Memory_Resource = _::memory_resource::Salgo_Memory_Resource;
+
+} // namespace salgo
@@ -0,0 +1,182 @@
+#pragma once
+
+#include "../pointer-handle.hpp"
+#include "../const-flag.hpp"
+
+#include <glog/logging.h>
+
+#include <memory_resource>
+#include <new> // placement new
+#include <utility> // std::forward
+
+namespace salgo::_::pmr_allocator {
+
+
+
+//
+// salgo allocator that gets memory for each element from a `std::pmr::memory_resource`
+//
+// uses regular pointers as handles (like Salgo_From_Std_Allocator)
+// the resource is given on construction - `std::pmr::get_default_resource()` otherwise
+//
+template<
+	class _VAL
+>
+struct Context {
+
+	//
+	// TEMPLATE PARAMETERS
+	//
+	using Val = _VAL; // can be incomplete here, e.g. a container node that stores our handles
+
+
+	struct Handle : Pointer_Handle<Val*, Handle> {
+		using BASE = Pointer_Handle<Val*, Handle>;
+		using BASE::BASE;
+	};
+
+	using Handle_Small = Handle;
+
+
+	// forward
+	class Pmr_Allocator;
+
+
+
+
+	//
+	// accessor
+	//
+	template<Const_Flag C>
+	class Accessor {
+	public:
+		// get handle
+		auto   handle() const { return _handle; }
+		operator auto() const { return handle(); }
+
+		// get val
+		auto& operator()()       { return _owner[_handle]; }
+		auto& operator()() const { return _owner[_handle]; }
+		operator auto&()       { return operator()(); }
+		operator auto&() const { return operator()(); }
+
+		void destruct() {
+			static_assert(C == MUTAB, "called destruct() on CONST accessor");
+			_owner.destruct( _handle );
+		}
+
+
+	private:
+		Accessor(Const<Pmr_Allocator,C>& owner, Handle handle)
+			: _owner(owner), _handle(handle) {}
+
+		friend Pmr_Allocator;
+
+
+	private:
+		Const<Pmr_Allocator,C>& _owner;
+		const Handle _handle;
+	};
+
+
+
+
+	class Pmr_Allocator {
+	public:
+		// elements never move
+		static constexpr bool Is_Persistent = true;
+
+	public:
+		using          Val = Context::Val;
+		using       Handle = Context::Handle;
+		using Handle_Small = Context::Handle_Small;
+
+
+	#ifndef NDEBUG
+		int _num_allocations = 0;
+		public: ~Pmr_Allocator() {
+			DCHECK_EQ(0, _num_allocations);
+		}
+	#endif
+
+
+	public:
+		Pmr_Allocator() = default;
+		Pmr_Allocator(std::pmr::memory_resource* resource) : _resource(resource) { DCHECK(resource); }
+
+
+	public:
+		template<class... ARGS>
+		auto construct(ARGS&&... args) {
+
+			#ifndef NDEBUG
+			++_num_allocations;
+			#endif
+
+			Val* ptr = static_cast<Val*>( _resource->allocate( sizeof(Val), alignof(Val) ) );
+			new(ptr) Val( std::forward<ARGS>(args)... );
+			return Accessor<MUTAB>(*this, ptr);
+		}
+
+		// memory resources take no hints
+		template<class... ARGS>
+		auto construct_near(Handle, ARGS&&... args) {
+			return construct( std::forward<ARGS>(args)... );
+		}
+
+		void destruct(Handle handle) {
+
+			#ifndef NDEBUG
+			--_num_allocations;
+			#endif
+
+			(*this)[handle].~Val();
+			_resource->deallocate( handle.pointer, sizeof(Val), alignof(Val) );
+		}
+
+
+		auto& operator[](Handle handle)       { return *handle.pointer; }
+		auto& operator[](Handle handle) const { return *(const Val*)handle.pointer; }
+
+		auto operator()(Handle handle)       { return Accessor<MUTAB>(*this, handle); }
+		auto operator()(Handle handle) const { return Accessor<CONST>(*this, handle); }
+
+
+		auto resource() const { return _resource; }
+
+
+	private:
+		std::pmr::memory_resource* _resource = std::pmr::get_default_resource();
+	};
+
+
+
+
+	struct With_Builder : Pmr_Allocator {
+		using BASE = Pmr_Allocator;
+		using BASE::BASE;
+
+		template<class NEW_VAL>
+		using VAL = typename Context<NEW_VAL> :: With_Builder;
+	};
+
+
+}; // struct Context
+
+} // namespace salgo::_::pmr_allocator
+
+
+
+
+
+
+namespace salgo {
+
+template<
+	class VAL
+>
+using Pmr_Allocator = typename _::pmr_allocator::Context<
+	VAL
+>::With_Builder;
+
+} // namespace salgo
@@ -0,0 +1,28 @@
+#pragma once
+
+namespace salgo::_ {
+
+
+
+//
+// hole search statistics of an allocator's `construct()` calls
+//
+// enabled with `::PROBE_STATS` builder (Array_Allocator, Random_Allocator) - otherwise not even stored
+//
+struct Probe_Stats {
+	long long calls = 0; // construct() calls
+	long long total = 0; // occupied slots skipped in total
+	int max = 0; // most occupied slots skipped by a single call
+
+	void add(int probes) {
+		++calls;
+		total += probes;
+		if(probes > max) max = probes;
+	}
+
+	double average() const { return calls ? double(total) / calls : 0.0; }
+};
+
+
+
+} // namespace salgo::_
@@ -1,12 +1,15 @@
 #pragma once
 
-#include "../memory-block.hpp"
-#include "../dynamic-array.hpp"
+#include "../memory-block.inl"
+#include "../dynamic-array.inl"
 #include "../handles.hpp"
 #include "../global-instance.hpp"
-#include "../chunked-array.hpp"
+#include "../chunked-array.inl"
 #include "../accessors.hpp"
 #include "../rand.hpp"
+#include "../hierarchical-bitset.hpp"
+#include "../add-member.hpp"
+#include "probe-stats.hpp"
 
 
 
@@ -31,6 +34,8 @@ namespace _ {
 namespace random_allocator {
 
 
+SALGO_ADD_MEMBER(probes)
+
 
 
 
@@ -38,7 +43,8 @@ namespace random_allocator {
 
 template<
 	class _VAL,
-	bool  _SINGLETON
+	bool  _SINGLETON,
+	bool  _PROBE_STATS
 >
 struct Context {
 
@@ -47,6 +53,7 @@ struct Context {
 	//
 	using Val = _VAL;
 	static constexpr bool Singleton = _SINGLETON;
+	static constexpr bool Probe_Stats = _PROBE_STATS;
 
 
 	using Array = typename salgo::Chunked_Array<Val> ::SPARSE ::COUNT;
@@ -91,7 +98,7 @@ struct Context {
 	public:
 		void destruct() {
 			static_assert(C == MUTAB, "called erase() on CONST accessor");
-			CONT.v(HANDLE).destruct();
+			CONT.destruct( HANDLE );
 		}
 	};
 
@@ -107,22 +114,16 @@ struct Context {
 		// FORWARDING_CONSTRUCTOR(Iterator, BASE) {}
 		friend Random_Allocator;
 
-		using BASE::_container;
-		using BASE::_handle;
-
-
 	private:
 		friend Iterator_Base<C,Context>;
 
 		void _increment() {
-			do ++_handle; while( _handle != _container->end().accessor() && !_container->exists( _handle ) );
+			do ++MUT_HANDLE; while( HANDLE != CONT.v.end().handle() && CONT.v( HANDLE ).not_constructed() );
 		}
 
 		void _decrement() {
-			do --_handle; while( !_container->exists( _handle ) );
+			do --MUT_HANDLE; while( CONT.v( HANDLE ).not_constructed() );
 		}
-
-		auto _get_comparable() const {  return _handle;  }
 	};
 
 
@@ -134,7 +135,9 @@ struct Context {
 
 
 
-	class Random_Allocator {
+	class Random_Allocator : private Add_probes<salgo::_::Probe_Stats, Probe_Stats> {
+		using PROBES_BASE = Add_probes<salgo::_::Probe_Stats, Probe_Stats>;
+
 		friend Accessor<CONST>;
 		friend Accessor<MUTAB>;
 
@@ -144,6 +147,13 @@ struct Context {
 	private:
 		Array v;
 
+		// set bit = hole (not constructed), for indices below `v.capacity()` - the ones past
+		// `v.domain()` stay unset: they're filled using `emplace_back()`
+		salgo::_::Hierarchical_Bitset<> _holes;
+
+		// own generator state, so hole choice depends only on this allocator's history
+		Xoroshiro128 _rng;
+
 	public:
 		using Val = Context::Val;
 		using Handle_Small = Context::Handle_Small;
@@ -153,50 +163,104 @@ struct Context {
 	public:
 		template<class... ARGS>
 		auto construct(ARGS&&... args) {
-			// if current chunk not full yet, or congestion too high
-			if(v.domain() < v.capacity() || v.count()*2 >= v.domain()) {
-				// ...simply emplace_back a new element
-				return Accessor<MUTAB>( this, v.emplace_back( std::forward<ARGS>(args)... ) );
+			// if current chunk not full yet, or no holes
+			if(v.domain() < v.capacity() || v.count() == v.domain()) return _emplace_back( std::forward<ARGS>(args)... );
+
+			// otherwise, draw a random index and take the first hole at or after it (wrapping around)
+			//
+			// holes are found using the bitmap in O(log_64 N), so even at high load the search is bounded
+			DCHECK((v.domain() & (v.domain()+1)) == 0); // power of 2
+
+			int idx = _rng.rand_32() & v.domain();
+			int hole = _holes.find_next(idx);
+			int skipped = hole - idx;
+
+			if(hole == -1) {
+				hole = _holes.find_first();
+				skipped = v.domain() - idx + hole;
 			}
 
-			// otherwise, find a hole in the chunked vector
-			for(;;) {
-				DCHECK((v.domain() & (v.domain()+1)) == 0); // power of 2
+			DCHECK_NE(-1, hole) << "count() < domain(), but no hole tracked";
 
-				// draw a random index, and check if it's free
-				// check up to 10 subsequent elements before drawing another random index
-				int idx = rand_32() & v.domain();
-				for(int i=0; i<10; ++i) {
-					int new_idx = idx + i;
-					if(new_idx >= v.domain()) break;
+			if constexpr(Probe_Stats) PROBES_BASE::probes.add( skipped );
+			return _construct_at( hole, std::forward<ARGS>(args)... );
+		}
 
-					if(!v(new_idx).constructed()) {
-						v(new_idx).construct( std::forward<ARGS>(args)... );
-						return Accessor<MUTAB>(this, new_idx);
+		//
+		// construct in a hole at most `Near_Window` elements away from `hint`, if possible
+		// otherwise, same as `construct()`
+		//
+		template<class... ARGS>
+		auto construct_near(Handle hint, ARGS&&... args) {
+			if(hint.valid()) {
+				int index = (unsigned int)Handle_Small(hint);
+				for(int d=1; d<=Near_Window; ++d) {
+					int idx = index + d;
+					if(idx < v.domain() && !v(idx).constructed()) {
+						return _construct_at( idx, std::forward<ARGS>(args)... );
+					}
+
+					idx = index - d;
+					if(idx >= 0 && !v(idx).constructed()) {
+						return _construct_at( idx, std::forward<ARGS>(args)... );
 					}
 				}
 			}
-		}
 
-		template<class... ARGS>
-		auto construct_near(Handle, ARGS&&... args) {
-			// TODO
-			// currently we don't use the hint
 			return construct(std::forward<ARGS>(args)...);
 		}
 
+		static constexpr int Near_Window = 8;
+
+		void destruct(Handle h) {
+			v(h).destruct();
+			_holes.set( (unsigned int)Handle_Small(h) );
+		}
+
+		// restart the hole choice sequence
+		void seed(uint64_t seed) { _rng.seed(seed); }
+
 		auto& operator[]( Handle h )       { return v[h]; }
 		auto& operator[]( Handle h ) const { return v[h]; }
 
 		auto operator()( Handle h )       { return Accessor<MUTAB>(this, h); }
 		auto operator()( Handle h ) const { return Accessor<CONST>(this, h); }
 
+		// memory held for elements (constructed or not)
+		long long bytes_reserved() const { return (long long)v.capacity() * sizeof(Val); }
+
+		// hole search statistics of `construct()`, if enabled with `::PROBE_STATS`
+		const auto& probe_stats() const {
+			static_assert(Probe_Stats, "enable with ::PROBE_STATS");
+			return PROBES_BASE::probes;
+		}
+
+	private:
+		template<class... ARGS>
+		auto _emplace_back(ARGS&&... args) {
+			if constexpr(Probe_Stats) PROBES_BASE::probes.add(0);
+			auto handle = v.emplace_back( std::forward<ARGS>(args)... ).handle();
+
+			// new chunk
+			if(_holes.size() < v.capacity()) _holes.resize( v.capacity() );
+
+			return Accessor<MUTAB>( this, handle );
+		}
+
+		template<class... ARGS>
+		auto _construct_at(int idx, ARGS&&... args) {
+			v(idx).construct( std::forward<ARGS>(args)... );
+			_holes.reset(idx);
+			return Accessor<MUTAB>(this, idx);
+		}
+
 	public:
-		auto begin()       { return v.begin(); }
-		auto begin() const { return v.begin(); }
+		// iterators give this allocator's accessors, so `destruct()` through them keeps `_holes` up to date
+		auto begin()       { return Iterator<MUTAB>(this, v.begin().handle()); }
+		auto begin() const { return Iterator<CONST>(this, v.begin().handle()); }
 
-		auto end()       { return v.end(); }
-		auto end() const { return v.end(); }
+		auto end()       { return Iterator<MUTAB>(this, v.end().handle()); }
+		auto end() const { return Iterator<CONST>(this, v.end().handle()); }
 	};
 
 
@@ -208,6 +272,10 @@ struct Context {
 	class Allocator_Proxy {
 		static auto& _get() { return global_instance<Random_Allocator>(); }
 
+	public:
+		// all instances refer to the same allocator
+		static constexpr bool Is_Shared = true;
+
 	public:
 		using          Val = typename Random_Allocator::Val;
 		using Handle_Small = typename Random_Allocator::Handle_Small;
@@ -217,6 +285,9 @@ struct Context {
 		template<class... ARGS>
 		auto construct(ARGS&&... args) { return _get(). construct( std::forward<ARGS>(args)... ); }
 
+		template<class... ARGS>
+		auto construct_near(ARGS&&... args) { return _get(). construct_near( std::forward<ARGS>(args)... ); }
+
 		template<class... ARGS>
 		auto  destruct(ARGS&&... args) { return _get().  destruct( std::forward<ARGS>(args)... ); }
 
@@ -253,10 +324,14 @@ struct Context {
 
 		template<class NEW_VAL>
 		using VAL = typename
-			Context<NEW_VAL, Singleton> :: With_Builder;
+			Context<NEW_VAL, Singleton, Probe_Stats> :: With_Builder;
 
 		using SINGLETON = typename
-			Context<Val, true> :: With_Builder;
+			Context<Val, true, Probe_Stats> :: With_Builder;
+
+		// count hole search lengths in `construct()`, see `probe_stats()`
+		using PROBE_STATS = typename
+			Context<Val, Singleton, true> :: With_Builder;
 
 		// identity - it's always auto_destruct
 		using AUTO_DESTRUCT = With_Builder;
@@ -278,7 +353,8 @@ template<
 >
 using Random_Allocator = typename _::random_allocator::Context<
 	VAL,
-	false // singleton
+	false, // singleton
+	false // probe stats
 >::With_Builder;
 
 
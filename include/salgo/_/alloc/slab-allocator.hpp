@@ -0,0 +1,418 @@
+#pragma once
+
+#include "../handles.hpp"
+#include "../global-instance.hpp"
+#include "../const-flag.hpp"
+
+#include <glog/logging.h>
+
+#include <cstddef> // std::max_align_t
+#include <cstdint> // uint64_t
+#include <new> // placement new, ::operator new
+#include <type_traits>
+#include <utility> // std::forward, std::swap
+#include <vector>
+
+namespace salgo::alloc::_::slab_allocator {
+
+
+
+//
+// HANDLES
+//
+// slab index (inside the size class) and slot index inside the slab
+//
+// parametrized by unused context X, to make Handles from different Contexts incompatible
+//
+static const int slot_bits = 13; // 64 KiB slab of 8-byte slots
+static const int slab_bits = 32 - slot_bits;
+
+using H0 = Int_Handle<int,(1<<slab_bits)-1>;
+
+// big
+template<class X>
+struct Handle : Pair_Handle_Base<Handle<X>, H0, int> {
+	using BASE = Pair_Handle_Base<Handle<X>, H0, int>;
+
+	Handle() = default;
+
+	template<class A, class B>
+	Handle(A aa, B bb) : BASE(aa,bb) {
+		DCHECK_GE(aa, 0); DCHECK_LT(aa, 1<<slab_bits);
+		DCHECK_GE(bb, 0); DCHECK_LT(bb, 1<<slot_bits);
+	}
+};
+
+// small
+template<class X>
+struct Handle_Small : Int_Handle_Base<Handle_Small<X>, unsigned int> {
+	using BASE = Int_Handle_Base<Handle_Small<X>, unsigned int>;
+
+	Handle_Small() = default;
+	Handle_Small(unsigned int v) : BASE(v) {}
+
+	Handle_Small( const Handle<X>& h ) { *this = h; }
+	Handle_Small& operator=(const Handle<X>& h) {
+		DCHECK_LT(h.a, 1<<slab_bits);
+		DCHECK_LT(h.b, 1<<slot_bits);
+		*this = ((unsigned int)h.a << slot_bits) | h.b;
+		return *this;
+	}
+
+	operator Handle<X>() const {
+		return Handle<X>(H0((*this)>>slot_bits), (*this)&((1<<slot_bits)-1));
+	}
+};
+
+
+
+
+//
+// untyped memory: power-of-two size classes (8 .. 4096 bytes)
+//
+// each size class has its own 64 KiB slabs, with a bitmap of free slots per slab
+// slabs with free slots are kept on a stack - the most recently used one is filled first
+//
+// slabs are never given back until the pool is destructed
+//
+class Slab_Pool {
+public:
+	static constexpr int Min_Bits = 3;
+	static constexpr int Max_Bits = 12;
+	static constexpr int Num_Classes = Max_Bits - Min_Bits + 1;
+
+	static constexpr int Slab_Size = 1 << (Min_Bits + slot_bits);
+	static constexpr int Max_Slabs = (1 << slab_bits) - 1; // per size class, the last slab index is the invalid handle
+
+	static constexpr int size_class(int bytes, int align) {
+		int size = bytes > align ? bytes : align;
+		int c = 0;
+		while((1 << (c + Min_Bits)) < size) ++c;
+		return c;
+	}
+
+	static constexpr int class_size(int c) { return 1 << (c + Min_Bits); }
+	static constexpr int slots_per_slab(int c) { return Slab_Size >> (c + Min_Bits); }
+	static constexpr int words_per_slab(int c) { return (slots_per_slab(c) + 63) / 64; }
+
+private:
+	struct Slab {
+		char* data;
+		int num_free;
+		int hint; // first bitmap word that may have a free slot
+		int partial_pos; // index in the `partial` stack, -1 if full
+	};
+
+	struct Size_Class {
+		std::vector<Slab> slabs;
+		std::vector<uint64_t> free_bits; // `words_per_slab` words per slab, set bit = free slot
+		std::vector<int> partial; // slabs with free slots
+	};
+
+	Size_Class _classes[Num_Classes];
+
+public:
+	Slab_Pool() = default;
+
+	Slab_Pool(const Slab_Pool&) = delete;
+	Slab_Pool& operator=(const Slab_Pool&) = delete;
+
+	Slab_Pool(Slab_Pool&& o) { _swap(o); }
+	Slab_Pool& operator=(Slab_Pool&& o) { _release(); _swap(o); return *this; }
+
+	~Slab_Pool() { _release(); }
+
+
+public:
+	// returns {slab, slot}
+	template<class HANDLE>
+	HANDLE allocate(int c) {
+		auto& sc = _classes[c];
+		if(sc.partial.empty()) _new_slab(c);
+		return _allocate<HANDLE>( c, sc.partial.back() );
+	}
+
+	// try the same slab first
+	template<class HANDLE>
+	HANDLE allocate_near(int c, int slab) {
+		if(_classes[c].slabs[slab].num_free) return _allocate<HANDLE>(c, slab);
+		return allocate<HANDLE>(c);
+	}
+
+	void deallocate(int c, int slab, int slot) {
+		auto& sc = _classes[c];
+		auto& s = sc.slabs[slab];
+
+		int word = slot >> 6;
+		auto& bits = sc.free_bits[ slab * words_per_slab(c) + word ];
+		DCHECK( !(bits & (1ULL << (slot & 63))) ) << "double free";
+		bits |= 1ULL << (slot & 63);
+
+		if(word < s.hint || s.num_free == 0) s.hint = word;
+		++s.num_free;
+
+		if(s.partial_pos == -1) {
+			s.partial_pos = (int)sc.partial.size();
+			sc.partial.emplace_back(slab);
+		}
+	}
+
+	char* ptr(int c, int slab, int slot) const {
+		return _classes[c].slabs[slab].data + (slot << (c + Min_Bits));
+	}
+
+	// bytes of memory held
+	long long capacity() const {
+		long long result = 0;
+		for(auto& sc : _classes) result += (long long)sc.slabs.size() * Slab_Size;
+		return result;
+	}
+
+
+private:
+	template<class HANDLE>
+	HANDLE _allocate(int c, int slab) {
+		auto& sc = _classes[c];
+		auto& s = sc.slabs[slab];
+		DCHECK_GT(s.num_free, 0);
+
+		int base = slab * words_per_slab(c);
+		while(!sc.free_bits[ base + s.hint ]) ++s.hint;
+
+		auto& bits = sc.free_bits[ base + s.hint ];
+		int slot = s.hint * 64 + __builtin_ctzll(bits);
+		bits &= bits - 1;
+
+		if(--s.num_free == 0) {
+			// it's not necessarily on top of the stack (if allocated near a hint)
+			int last = sc.partial.back();
+			sc.partial[ s.partial_pos ] = last;
+			sc.slabs[ last ].partial_pos = s.partial_pos;
+			sc.partial.pop_back();
+			s.partial_pos = -1;
+		}
+
+		return HANDLE( H0(slab), slot );
+	}
+
+	void _new_slab(int c) {
+		auto& sc = _classes[c];
+		DCHECK_LT((int)sc.slabs.size(), Max_Slabs) << "Slab_Pool out of handle space";
+
+		int slab = (int)sc.slabs.size();
+		sc.slabs.emplace_back( Slab{ (char*)::operator new(Slab_Size), slots_per_slab(c), 0, (int)sc.partial.size() } );
+
+		for(int i=0; i<words_per_slab(c); ++i) {
+			int n = slots_per_slab(c) - 64*i;
+			sc.free_bits.emplace_back( n >= 64 ? ~0ULL : (1ULL << n) - 1 );
+		}
+
+		sc.partial.emplace_back(slab);
+	}
+
+	void _release() {
+		for(auto& sc : _classes) {
+			for(auto& s : sc.slabs) ::operator delete( s.data );
+			sc = Size_Class();
+		}
+	}
+
+	void _swap(Slab_Pool& o) {
+		for(int c=0; c<Num_Classes; ++c) {
+			std::swap(_classes[c].slabs, o._classes[c].slabs);
+			std::swap(_classes[c].free_bits, o._classes[c].free_bits);
+			std::swap(_classes[c].partial, o._classes[c].partial);
+		}
+	}
+};
+
+
+
+
+template<class TAG>
+struct Shared_Pool : Slab_Pool {};
+
+
+
+
+template<
+	class _VAL,
+	class _SHARED_TAG // void if owning
+>
+struct Context {
+
+	//
+	// TEMPLATE PARAMETERS
+	//
+	using Val = _VAL;
+	using Shared_Tag = _SHARED_TAG;
+	static constexpr bool Shared = !std::is_same_v<Shared_Tag, void>;
+
+
+	using       Handle = slab_allocator::      Handle<Context>;
+	using Handle_Small = slab_allocator::Handle_Small<Context>;
+
+
+
+
+	// forward
+	class Slab_Allocator;
+
+
+
+
+	//
+	// accessor
+	//
+	template<Const_Flag C>
+	class Accessor {
+	public:
+		// get handle
+		auto     handle() const { return _handle; }
+		operator   auto() const { return handle(); }
+
+		auto& operator()()       { return _owner[_handle]; }
+		auto& operator()() const { return _owner[_handle]; }
+		operator auto&()       { return operator()(); }
+		operator auto&() const { return operator()(); }
+
+		void destruct() {
+			static_assert(C == MUTAB, "called destruct() on CONST accessor");
+			_owner.destruct( _handle );
+		}
+
+
+	private:
+		Accessor(Const<Slab_Allocator,C>& owner, Handle handle)
+			: _owner(owner), _handle(handle) {}
+
+		friend Slab_Allocator;
+
+
+	private:
+		Const<Slab_Allocator,C>& _owner;
+		const Handle _handle;
+	};
+
+
+
+
+	struct Owned_Pool { Slab_Pool pool; };
+	struct Shared_Pool_Ref {};
+
+	using Pool_Base = std::conditional_t<Shared, Shared_Pool_Ref, Owned_Pool>;
+
+
+
+
+	class Slab_Allocator : private Pool_Base {
+	public:
+		// ::SHARED instances with the same tag refer to the same pool
+		static constexpr bool Is_Shared = Shared;
+
+		// elements never move
+		static constexpr bool Is_Persistent = true;
+
+	public:
+		using          Val = Context::Val;
+		using Handle_Small = Context::Handle_Small;
+		using       Handle = Context::Handle;
+
+
+	public:
+		template<class... ARGS>
+		auto construct(ARGS&&... args) {
+			_check_size();
+			auto handle = pool().template allocate<Handle>( _class() );
+			new( _ptr(handle) ) Val( std::forward<ARGS>(args)... );
+			return Accessor<MUTAB>( *this, handle );
+		}
+
+		// same slab as `hint` if it has a free slot
+		template<class... ARGS>
+		auto construct_near(Handle hint, ARGS&&... args) {
+			if(!hint.valid()) return construct( std::forward<ARGS>(args)... );
+
+			_check_size();
+			auto handle = pool().template allocate_near<Handle>( _class(), hint.a );
+			new( _ptr(handle) ) Val( std::forward<ARGS>(args)... );
+			return Accessor<MUTAB>( *this, handle );
+		}
+
+		void destruct(Handle handle) {
+			(*this)[handle].~Val();
+			pool().deallocate( _class(), handle.a, handle.b );
+		}
+
+
+		auto& operator[](Handle handle)       { return *reinterpret_cast<      Val*>( _ptr(handle) ); }
+		auto& operator[](Handle handle) const { return *reinterpret_cast<const Val*>( _ptr(handle) ); }
+
+		auto operator()(Handle handle)       { return Accessor<MUTAB>(*this, handle); }
+		auto operator()(Handle handle) const { return Accessor<CONST>(*this, handle); }
+
+
+		// memory held by the pool (all size classes, shared by all allocators using it if ::SHARED)
+		long long bytes_reserved() const { return pool().capacity(); }
+
+
+		Slab_Pool& pool() {
+			if constexpr(Shared) return global_instance<Shared_Pool<Shared_Tag>>();
+			else return Pool_Base::pool;
+		}
+
+		const Slab_Pool& pool() const {
+			if constexpr(Shared) return global_instance<Shared_Pool<Shared_Tag>>();
+			else return Pool_Base::pool;
+		}
+
+	private:
+		// `Val` can be incomplete where the Context is instantiated, so compute it lazily
+		static constexpr int _class() { return Slab_Pool::size_class( sizeof(Val), alignof(Val) ); }
+
+		static void _check_size() {
+			static_assert(sizeof(Val) <= (1 << Slab_Pool::Max_Bits), "Slab_Allocator supports elements up to 4096 bytes");
+			static_assert(alignof(Val) <= alignof(std::max_align_t), "over-aligned types not supported");
+		}
+
+		char* _ptr(Handle handle) const { return pool().ptr( _class(), handle.a, handle.b ); }
+	};
+
+
+
+
+	struct With_Builder : Slab_Allocator {
+
+		template<class NEW_VAL>
+		using VAL = typename
+			Context<NEW_VAL, Shared_Tag> :: With_Builder;
+
+		// non-owning: all allocators with the same TAG (and any VAL) use one global pool
+		template<class TAG>
+		using SHARED = typename
+			Context<Val, TAG> :: With_Builder;
+	};
+
+
+}; // struct Context
+
+}  // namespace salgo::alloc::_::slab_allocator
+
+
+
+
+
+
+namespace salgo::alloc {
+
+template<
+	class VAL
+>
+using Slab_Allocator = typename _::slab_allocator::Context<
+	VAL,
+	void // shared tag
+>::With_Builder;
+
+using Slab_Pool = _::slab_allocator::Slab_Pool;
+
+} // namespace salgo::alloc
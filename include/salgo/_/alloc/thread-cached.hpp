@@ -0,0 +1,253 @@
+#pragma once
+
+#include "../global-instance.hpp"
+#include "../const-flag.hpp"
+
+#include <glog/logging.h>
+
+#include <mutex>
+#include <new> // placement new
+#include <type_traits>
+#include <utility> // std::forward
+
+namespace salgo::_::thread_cached {
+
+
+
+//
+// thread-local caching front-end for a salgo allocator
+//
+// all instances refer to one shared backing allocator (like ::SINGLETON allocators),
+// guarded by a mutex that is only taken once per `Batch` construct/destruct calls
+//
+// each thread keeps a magazine of reserved slots:
+// * construct() takes a slot from the magazine, refilling it from the backing allocator if empty
+// * destruct() returns the slot to the magazine, flushing a batch to the backing allocator if full
+//
+// element access doesn't lock, so the backing allocator must be persistent (elements never move),
+// and its element access must not read anything construct() / destruct() write (`Has_Lock_Free_Access`,
+// e.g. `Crude_Allocator` with its fixed-size block table)
+//
+template<
+	class _ALLOCATOR,
+	int _BATCH
+>
+struct Context {
+
+	//
+	// TEMPLATE PARAMETERS
+	//
+	using Supplied_Allocator = _ALLOCATOR;
+	static constexpr int Batch = _BATCH;
+
+	using Val = typename Supplied_Allocator::Val;
+
+
+	// backing allocator only reserves memory - values are constructed by Thread_Cached
+	//
+	// (`Val` can be incomplete here, e.g. a container node that stores our handles)
+	struct Slot {
+		Slot() {} // leave uninitialized
+
+		template<class... ARGS>
+		void construct(ARGS&&... args) { new(data) Val( std::forward<ARGS>(args)... ); }
+		void destruct() { get().~Val(); }
+
+		auto& get()       { return *reinterpret_cast<      Val*>(data); }
+		auto& get() const { return *reinterpret_cast<const Val*>(data); }
+
+	private:
+		alignas(Val) char data[ sizeof(Val) ];
+	};
+
+	using Backing = typename Supplied_Allocator ::template VAL<Slot>;
+
+	static_assert(Batch > 0);
+
+
+	using       Handle = typename Backing::Handle;
+	using Handle_Small = typename Backing::Handle_Small;
+
+
+
+
+	struct Shared {
+		Backing backing;
+		std::mutex mutex;
+	};
+
+	static auto& _shared() { return global_instance<Shared>(); }
+
+
+
+
+	class Magazine {
+	public:
+		Handle_Small handles[ 2*Batch ];
+		int size = 0;
+
+		~Magazine() {
+			auto& shared = _shared();
+			std::lock_guard<std::mutex> lock(shared.mutex);
+			while(size) shared.backing.destruct( handles[--size] );
+		}
+
+		void refill() {
+			DCHECK_EQ(size, 0);
+			auto& shared = _shared();
+			std::lock_guard<std::mutex> lock(shared.mutex);
+			while(size < Batch) handles[size++] = shared.backing.construct().handle();
+		}
+
+		void flush() {
+			DCHECK_EQ(size, 2*Batch);
+			auto& shared = _shared();
+			std::lock_guard<std::mutex> lock(shared.mutex);
+			while(size > Batch) shared.backing.destruct( handles[--size] );
+		}
+	};
+
+	static auto& _magazine() {
+		thread_local Magazine magazine;
+		return magazine;
+	}
+
+
+
+
+	// forward
+	class Thread_Cached;
+
+
+
+
+	//
+	// accessor
+	//
+	template<Const_Flag C>
+	class Accessor {
+	public:
+		// get handle
+		auto     handle() const { return _handle; }
+		operator   auto() const { return handle(); }
+
+		auto& operator()()       { return _owner[_handle]; }
+		auto& operator()() const { return _owner[_handle]; }
+		operator auto&()       { return operator()(); }
+		operator auto&() const { return operator()(); }
+
+		void destruct() {
+			static_assert(C == MUTAB, "called destruct() on CONST accessor");
+			_owner.destruct( _handle );
+		}
+
+
+	private:
+		Accessor(Const<Thread_Cached,C>& owner, Handle handle)
+			: _owner(owner), _handle(handle) {}
+
+		friend Thread_Cached;
+
+
+	private:
+		Const<Thread_Cached,C>& _owner;
+		const Handle _handle;
+	};
+
+
+
+
+	template<class A, class = void>
+	struct Has_Lock_Free_Access : std::false_type {};
+
+	template<class A>
+	struct Has_Lock_Free_Access<A, std::void_t<decltype(A::Has_Lock_Free_Access)>> : std::bool_constant<A::Has_Lock_Free_Access> {};
+
+	class Thread_Cached {
+		static_assert(Backing::Is_Persistent, "Thread_Cached requires a persistent backing allocator");
+		static_assert(Has_Lock_Free_Access<Backing>::value, "Thread_Cached requires a backing allocator with lock-free element access");
+
+	public:
+		// all instances refer to the same allocator
+		static constexpr bool Is_Shared = true;
+		static constexpr bool Is_Persistent = true;
+
+	public:
+		using          Val = Context::Val;
+		using Handle_Small = Context::Handle_Small;
+		using       Handle = Context::Handle;
+
+
+	public:
+		template<class... ARGS>
+		auto construct(ARGS&&... args) {
+			auto& magazine = _magazine();
+			if(magazine.size == 0) magazine.refill();
+
+			Handle handle = magazine.handles[ --magazine.size ];
+			_slot(handle).construct( std::forward<ARGS>(args)... );
+			return Accessor<MUTAB>( *this, handle );
+		}
+
+		// slots come from the thread's magazine - no placement control
+		template<class... ARGS>
+		auto construct_near(Handle, ARGS&&... args) {
+			return construct( std::forward<ARGS>(args)... );
+		}
+
+		void destruct(Handle handle) {
+			_slot(handle).destruct();
+
+			auto& magazine = _magazine();
+			if(magazine.size == 2*Batch) magazine.flush();
+			magazine.handles[ magazine.size++ ] = handle;
+		}
+
+
+		auto& operator[](Handle handle)       { return _slot(handle).get(); }
+		auto& operator[](Handle handle) const { return _slot(handle).get(); }
+
+		auto operator()(Handle handle)       { return Accessor<MUTAB>(*this, handle); }
+		auto operator()(Handle handle) const { return Accessor<CONST>(*this, handle); }
+
+
+	private:
+		static Slot& _slot(Handle handle) { return _shared().backing[handle]; }
+	};
+
+
+
+
+	struct With_Builder : Thread_Cached {
+
+		template<class NEW_VAL>
+		using VAL = typename
+			Context<typename Supplied_Allocator ::template VAL<NEW_VAL>, Batch> :: With_Builder;
+
+		template<int NEW_BATCH>
+		using BATCH = typename
+			Context<Supplied_Allocator, NEW_BATCH> :: With_Builder;
+	};
+
+
+}; // struct Context
+
+}  // namespace salgo::_::thread_cached
+
+
+
+
+
+
+namespace salgo {
+
+template<
+	class ALLOCATOR
+>
+using Thread_Cached = typename _::thread_cached::Context<
+	ALLOCATOR,
+	64 // batch
+>::With_Builder;
+
+} // namespace salgo
+
@@ -0,0 +1,213 @@
+#pragma once
+
+/*
+
+Stream compaction (filtering) of trivially copyable elements stored in a contiguous block.
+
+Predicate results are gathered into a bit mask, one block of `Lanes` elements at a time,
+and the selected elements are written out using a single compress-store:
+	* AVX-512: `vpcompressd` / `vpcompressq`
+	* AVX2: lane permutation driven by a lookup table, followed by a full-width store
+	* otherwise: branchless scalar copy
+
+Only elements of size 4 or 8 are vectorized. Element order is always preserved.
+
+*/
+
+#include <memory> // std::allocator
+#include <cstdint>
+#include <cstring> // memcpy
+#include <type_traits>
+
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+namespace salgo::_::compress_store {
+
+
+
+//
+// generic (scalar) kernel
+//
+template<class T, int SIZE = sizeof(T), class = void>
+struct Kernel {
+	static constexpr int Lanes = 1;
+
+	using Vec = T;
+
+	static Vec load(const T* src) { return *src; }
+
+	// store selected lanes of `v` at `dst`
+	// may write up to `Lanes` elements, regardless of mask
+	static int store(T* dst, const Vec& v, unsigned mask) {
+		*dst = v;
+		return mask & 1;
+	}
+};
+
+
+
+#if defined(__AVX512F__)
+
+template<class T>
+struct Kernel<T, 4> {
+	static constexpr int Lanes = 16;
+
+	using Vec = __m512i;
+
+	static Vec load(const T* src) { return _mm512_loadu_si512( (const void*)src ); }
+
+	static int store(T* dst, const Vec& v, unsigned mask) {
+		_mm512_mask_compressstoreu_epi32( (void*)dst, (__mmask16)mask, v );
+		return __builtin_popcount(mask);
+	}
+};
+
+template<class T>
+struct Kernel<T, 8> {
+	static constexpr int Lanes = 8;
+
+	using Vec = __m512i;
+
+	static Vec load(const T* src) { return _mm512_loadu_si512( (const void*)src ); }
+
+	static int store(T* dst, const Vec& v, unsigned mask) {
+		_mm512_mask_compressstoreu_epi64( (void*)dst, (__mmask8)mask, v );
+		return __builtin_popcount(mask);
+	}
+};
+
+#elif defined(__AVX2__)
+
+//
+// for each mask, 8 byte-sized indices of 32-bit lanes to gather
+//
+// 64-bit elements are gathered as pairs of 32-bit lanes
+//
+template<int ELEMENT_LANES>
+struct Permutation_Table {
+	static constexpr int Element_Lanes = ELEMENT_LANES; // 32-bit lanes per element
+	static constexpr int Elements = 8 / Element_Lanes;
+
+	uint64_t indices[1 << Elements] = {};
+
+	constexpr Permutation_Table() {
+		for(int mask = 0; mask < (1 << Elements); ++mask) {
+			uint64_t r = 0;
+			int k = 0;
+			for(int b = 0; b < Elements; ++b) if(mask >> b & 1) {
+				for(int l = 0; l < Element_Lanes; ++l) {
+					r |= uint64_t(b * Element_Lanes + l) << (8 * k++);
+				}
+			}
+			indices[mask] = r;
+		}
+	}
+};
+
+template<int ELEMENT_LANES>
+inline constexpr Permutation_Table<ELEMENT_LANES> permutation_table = {};
+
+
+template<class T, int SIZE>
+struct Kernel<T, SIZE, std::enable_if_t<SIZE == 4 || SIZE == 8>> {
+	static constexpr int Lanes = 32 / SIZE;
+
+	using Vec = __m256i;
+
+	static Vec load(const T* src) { return _mm256_loadu_si256( (const __m256i*)src ); }
+
+	static int store(T* dst, const Vec& v, unsigned mask) {
+		auto perm = _mm256_cvtepu8_epi32( _mm_cvtsi64_si128( permutation_table<SIZE/4>.indices[mask] ) );
+		_mm256_storeu_si256( (__m256i*)dst, _mm256_permutevar8x32_epi32(v, perm) );
+		return __builtin_popcount(mask);
+	}
+};
+
+#endif
+
+
+
+template<class K, class T, class PRED>
+inline unsigned _block_mask(const T* src, PRED& pred) {
+	unsigned mask = 0;
+	for(int k=0; k<K::Lanes; ++k) mask |= unsigned( bool( pred(src[k]) ) ) << k;
+	return mask;
+}
+
+
+
+//
+// keep only elements for which `keep(x)` is true, preserving order
+//
+// returns the number of kept elements (the new size)
+//
+template<class T, class SIZE, class KEEP>
+SIZE compress(T* data, SIZE size, KEEP&& keep) {
+	static_assert(std::is_trivially_copyable_v<T>);
+	using K = Kernel<T>;
+
+	SIZE out = 0;
+	SIZE i = 0;
+
+	// in-place: the block is loaded before anything is stored, and `out <= i`
+	for(; i + K::Lanes <= size; i += K::Lanes) {
+		auto mask = _block_mask<K>(data + i, keep);
+		out += K::store(data + out, K::load(data + i), mask);
+	}
+
+	for(; i<size; ++i) {
+		T x = data[i];
+		data[out] = x;
+		out += bool( keep(x) );
+	}
+
+	return out;
+}
+
+
+
+//
+// stable partition: elements for which `pred(x)` is true are moved to the front
+//
+// returns the number of such elements
+//
+template<class T, class SIZE, class PRED>
+SIZE partition(T* data, SIZE size, PRED&& pred) {
+	static_assert(std::is_trivially_copyable_v<T>);
+	using K = Kernel<T>;
+	constexpr unsigned full_mask = (1u << K::Lanes) - 1;
+
+	std::allocator<T> allocator;
+	T* rest = allocator.allocate( size );
+
+	SIZE front = 0;
+	SIZE back = 0;
+	SIZE i = 0;
+
+	for(; i + K::Lanes <= size; i += K::Lanes) {
+		auto mask = _block_mask<K>(data + i, pred);
+		auto v = K::load(data + i);
+		front += K::store(data + front, v, mask);
+		back  += K::store(rest + back, v, ~mask & full_mask);
+	}
+
+	for(; i<size; ++i) {
+		T x = data[i];
+		bool p = pred(x);
+		data[front] = x;
+		rest[back] = x;
+		front += p;
+		back += !p;
+	}
+
+	std::memcpy( (void*)(data + front), (const void*)rest, back * sizeof(T) );
+	allocator.deallocate(rest, size);
+
+	return front;
+}
+
+
+
+} // namespace salgo::_::compress_store
@@ -11,9 +11,12 @@
 
 #include "memory-block.inl"
 #include "hash.hpp"
+#include "compress-store.hpp"
 
 #include "subscript-tags.hpp"
 
+#include <utility> // std::as_const
+
 
 #include "helper-macros-on.inc"
 
@@ -22,12 +25,9 @@ namespace salgo::_::dynamic_array {
 
 
 
-using Handle_Int_Type = int;
-
-
 template<class P>
-struct Handle : Int_Handle_Base<Handle<P>, Handle_Int_Type> {
-	using BASE = Int_Handle_Base<Handle<P>, Handle_Int_Type>;
+struct Handle : Int_Handle_Base<Handle<P>, typename P::Handle_Int> {
+	using BASE = Int_Handle_Base<Handle<P>, typename P::Handle_Int>;
 	using BASE::BASE;
 };
 
@@ -63,6 +63,10 @@ struct Params {
 	static constexpr bool Dense          = !Sparse;
 
 	static constexpr bool Iterable = Dense || Exists;
+
+	using Handle_Int = typename MEMORY_BLOCK ::Handle_Int;
+	using Index_Int  = typename MEMORY_BLOCK ::Index_Int;
+	static constexpr Index_Int Max_Domain = MEMORY_BLOCK ::Max_Domain;
 	
 	using Handle       = dynamic_array::Handle<Params>;
 	using Handle_Small = dynamic_array::Handle_Small<Params>;
@@ -149,7 +153,7 @@ private:
 	friend BASE;
 
 	void _increment() {
-		do ++MUT_HANDLE; while( (int)HANDLE != CONT.domain() && ACC.is_not_constructed() );
+		do ++MUT_HANDLE; while( (typename P::Index_Int)HANDLE != CONT.domain() && ACC.is_not_constructed() );
 	}
 
 	void _decrement() {
@@ -203,6 +207,10 @@ public:
 	using typename P::Handle_Small;
 	using typename P::Index;
 
+	using typename P::Handle_Int;
+	using typename P::Index_Int;
+	using P::Max_Domain;
+
 	template<Const_Flag C> using Accessor = dynamic_array::Accessor<P,C>;
 	template<Const_Flag C> using Iterator = dynamic_array::Iterator<P,C>;
 
@@ -214,7 +222,7 @@ private:
 
 private:
 	typename P::Memory_Block _mb;
-	int _size = 0;
+	Index_Int _size = 0;
 
 
 
@@ -223,8 +231,8 @@ public:
 	Dynamic_Array() : _mb( P::Memory_Block::Stack_Buffer ) {}
 
 	template<class... ARGS> // remove this? use named constructor instead?
-	Dynamic_Array(int size, ARGS&&... args) : _mb( std::max(size, P::Memory_Block::Stack_Buffer )), _size(size) {
-		for(int i=0; i<size; ++i) {
+	Dynamic_Array(Index_Int size, ARGS&&... args) : _mb( std::max(size, (Index_Int)P::Memory_Block::Stack_Buffer )), _size(size) {
+		for(Index_Int i=0; i<size; ++i) {
 			_mb(i).construct( args... );
 		}
 	}
@@ -240,7 +248,7 @@ public:
 		static_assert(P::Dense || P::Exists || std::is_trivially_destructible_v<Val>, "no way to know which destructors have to be called");
 
 		if constexpr(P::Dense && !std::is_trivially_destructible_v<Val>) {
-			for(int i=0; i<_size; ++i) {
+			for(Index_Int i=0; i<_size; ++i) {
 				_mb(i).destruct();
 			}
 		}
@@ -258,7 +266,7 @@ public:
 		else {
 			reserve( o._mb.domain() );
 			_size = o._size;
-			for(int i=0; i<_size; ++i) {
+			for(Index_Int i=0; i<_size; ++i) {
 				_mb(i).construct( o._mb[i] );
 			}
 		}
@@ -280,16 +288,16 @@ public:
 
 
 	template<class... ARGS>
-	void resize(int new_size, ARGS&&... args) {
+	void resize(Index_Int new_size, ARGS&&... args) {
 		if constexpr(P::Dense) {
-			_mb.resize( new_size, [this](int i){return i<_size;} );
+			_mb.resize( new_size, [this](Index_Int i){return i<_size;} );
 		}
 		else {
 			_mb.resize( new_size );
 		}
 
 		// construct new elements
-		for(int i=_size; i<_mb.domain(); ++i) {
+		for(Index_Int i=_size; i<_mb.domain(); ++i) {
 			_mb(i).construct( args... );
 		}
 
@@ -302,9 +310,9 @@ public:
 	bool not_empty() const { return !is_empty(); }
 
 
-	void reserve(int capacity) {
+	void reserve(Index_Int capacity) {
 		if constexpr(P::Dense) {
-			_mb.resize( capacity, [this](int i){return i<_size;} );
+			_mb.resize( capacity, [this](Index_Int i){return i<_size;} );
 		}
 		else {
 			_mb.resize( capacity );
@@ -395,11 +403,14 @@ public:
 		static_assert( std::is_move_constructible_v<Val> );
 
 		if(_size == _mb.domain()) {
+			DCHECK_LT(_size, P::Max_Domain) << "Dynamic_Array overflows its HANDLE_INT type";
+			Index_Int new_domain = (Index_Int)std::min( (_mb.domain() + 1LL) * 3/2, (long long)P::Max_Domain );
+
 			if constexpr(P::Dense) {
-				_mb.resize( (_mb.domain() + 1) * 3/2, [](int){ return /*i<_size*/true; } );
+				_mb.resize( new_domain, [](Index_Int){ return /*i<_size*/true; } );
 			}
 			else {
-				_mb.resize( (_mb.domain() + 1) * 3/2 );
+				_mb.resize( new_domain );
 			}
 		}
 
@@ -438,37 +449,37 @@ public:
 
 
 
-	int count() const {
+	Index_Int count() const {
 		if constexpr(P::Dense) return domain();
 		else return _mb.count();
 	}
 
-	int domain() const {
+	Index_Int domain() const {
 		return _size;
 	}
 
-	int size() const {
+	Index_Int size() const {
 		static_assert(P::Dense, "size() for Sparse_Dynamic_Array is a bit ambiguous. Use count() or domain() instead");
 		return _size;
 	}
 
-	int capacity() const {
+	Index_Int capacity() const {
 		return _mb.domain();
 	}
 
 
 	//
-	// FUN is (int old_handle, int new_handle) -> void
+	// FUN is (Index_Int old_handle, Index_Int new_handle) -> void
 	//
 	// returns count()
 	//
 	template<class FUN>
-	int compact(const FUN& fun = [](int,int){}) {
+	Index_Int compact(const FUN& fun = [](Index_Int,Index_Int){}) {
 		static_assert(P::Exists, "can only compact if have CONSTRUCTED_FLAGS flags");
 		static_assert(std::is_move_constructible_v<Val>, "compact() requires move constructible Val type");
 
-		int target = 0;
-		for(int i=0; i<_mb.domain(); ++i) {
+		Index_Int target = 0;
+		for(Index_Int i=0; i<_mb.domain(); ++i) {
 			if(_mb(i).is_constructed() && target != i) {
 
 				_mb(target).construct( std::move( _mb[i] ) );
@@ -488,6 +499,105 @@ public:
 
 
 
+	//
+	// PRED is (const Val&) -> bool
+	//
+	// DENSE: erase matching elements, keeping order of the remaining ones
+	// SPARSE: destruct matching elements, leaving holes
+	//
+	// returns number of erased elements
+	//
+	template<class PRED>
+	Index_Int erase_if(PRED&& pred) {
+		if constexpr(P::Sparse) {
+			static_assert(P::Exists, "erase_if() on SPARSE Dynamic_Array requires CONSTRUCTED_FLAGS");
+
+			Index_Int erased = 0;
+			for(Index_Int i=0; i<_size; ++i) {
+				if(_mb(i).is_constructed() && pred( std::as_const(_mb[i]) )) {
+					_mb(i).destruct();
+					++erased;
+				}
+			}
+			return erased;
+		}
+		else {
+			Index_Int target = 0;
+
+			if constexpr(_can_compress_store()) {
+				target = compress_store::compress( _mb.data(), _size, [&pred](const Val& x){ return !pred(x); } );
+			}
+			else {
+				for(Index_Int i=0; i<_size; ++i) {
+					if(pred( std::as_const(_mb[i]) )) {
+						_mb(i).destruct();
+						continue;
+					}
+
+					if(target != i) {
+						_mb(target).construct( std::move( _mb[i] ) );
+						_mb(i).destruct();
+					}
+					++target;
+				}
+			}
+
+			Index_Int erased = _size - target;
+			_size = target;
+			return erased;
+		}
+	}
+
+
+	//
+	// stable partition: elements matching PRED are moved to the front
+	//
+	// returns number of matching elements
+	//
+	template<class PRED>
+	Index_Int partition(PRED&& pred) {
+		static_assert(P::Dense, "partition() requires DENSE Dynamic_Array");
+
+		if constexpr(_can_compress_store()) {
+			return compress_store::partition( _mb.data(), _size, std::forward<PRED>(pred) );
+		}
+		else {
+			salgo::Dynamic_Array<Val> rest;
+
+			Index_Int target = 0;
+			for(Index_Int i=0; i<_size; ++i) {
+				if(pred( std::as_const(_mb[i]) )) {
+					if(target != i) {
+						_mb(target).construct( std::move( _mb[i] ) );
+						_mb(i).destruct();
+					}
+					++target;
+				}
+				else {
+					rest.emplace_back( std::move( _mb[i] ) );
+					_mb(i).destruct();
+				}
+			}
+
+			for(Index_Int i=0; i<rest.size(); ++i) {
+				_mb(target + i).construct( std::move( rest[i] ) );
+			}
+
+			return target;
+		}
+	}
+
+private:
+	// can filter using SIMD compress-store directly on raw memory block data
+	static constexpr bool _can_compress_store() {
+		if constexpr(P::Dense && !P::Exists && std::is_trivially_copyable_v<Val>) {
+			return P::Memory_Block::is_contiguous();
+		}
+		else return false;
+	}
+
+
+
 
 
 public:
@@ -563,6 +673,12 @@ public:
 
 	using FULL_BLOWN = With_Builder< Params<
 		Val, true, typename Memory_Block::FULL_BLOWN >>;
+
+
+	// integer type used by handles, e.g. `uint16_t` for small arrays
+	template<class X>
+	using HANDLE_INT = With_Builder< Params<
+		Val, Sparse, typename Memory_Block::template HANDLE_INT<X> >>;
 };
 
 
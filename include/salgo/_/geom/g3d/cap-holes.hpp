@@ -6,9 +6,7 @@
 
 #include "../../list.hpp"
 #include "../../hash-table.hpp"
-
-
-#include <map>
+#include "../../heap.hpp"
 
 
 namespace salgo::geom::g3d {
@@ -34,11 +32,19 @@ Cap_Hole_Result cap_hole(const EDGE& edge) {
 
 	typename List< H_PolyEdge > ::COUNTABLE perimeter;
 
-	// iterators to perimeter, ordered by score
-	std::multimap<double, typename decltype(perimeter)::Handle_Small> cands; // todo: replace with salgo heap/tree
+	struct Cand {
+		double score;
+		typename decltype(perimeter)::Handle_Small perim;
+	};
+
+	struct Better_Score {
+		bool operator()(const Cand& a, const Cand& b) const { return a.score > b.score; }
+	};
 
-	//std::unordered_map<H_Poly_Edge, typename decltype(cands)::iterator> where_cands;
-	Hash_Table<H_PolyEdge, typename decltype(cands)::iterator> where_cands;
+	// perimeter edges, best score on top
+	typename Heap<Cand> ::template COMPARE<Better_Score> cands;
+
+	Hash_Table<H_PolyEdge, typename decltype(cands)::Handle> where_cands;
 
 
 	auto get_score = [](auto e0, auto e1){
@@ -75,10 +81,8 @@ Cap_Hole_Result cap_hole(const EDGE& edge) {
 
 		DCHECK_EQ( v0.next_vert(), v1.prev_vert() ) << "verts must be adjacent";
 
-		auto cands_it = cands.insert({get_score(v0, v1), perim_0});
-		where_cands.emplace(v0, cands_it);
-
-		//LOG(INFO) << "where_cands.insert(" << (*it) << ")";
+		auto cand = cands.push( Cand{get_score(v0, v1), perim_0} );
+		where_cands.emplace(v0, cand.handle());
 	};
 
 
@@ -87,7 +91,6 @@ Cap_Hole_Result cap_hole(const EDGE& edge) {
 		auto it = where_cands(e);
 
 		DCHECK(it.found()) << "edge not found in where_cands";
-		DCHECK(it.val() != cands.end()) << "edge not found in cands";
 
 		cands.erase( it.val() );
 		where_cands.erase(it);
@@ -112,11 +115,7 @@ Cap_Hole_Result cap_hole(const EDGE& edge) {
 
 
 	while(perimeter.count() >= 3) {
-		auto iter = cands.end(); --iter;
-
-		auto curr = perimeter( iter->second );
-
-		//LOG(INFO) << "score: " << it->first;
+		auto curr = perimeter( cands.top().perim );
 
 		// get next edge in perimeter
 		auto next = curr.next();
@@ -161,8 +160,8 @@ Cap_Hole_Result cap_hole(const EDGE& edge) {
 		add_cand(prev);
 		add_cand(new_edge);
 
-		DCHECK_EQ(perimeter.count(), cands.size());
-		DCHECK_EQ(where_cands.count(), cands.size());
+		DCHECK_EQ(perimeter.count(), cands.count());
+		DCHECK_EQ(where_cands.count(), cands.count());
 	}
 
 	// add last edge-link
@@ -46,7 +46,7 @@ struct H_PolyEdge {
 	using H_Poly = typename P::H_Poly;
 
 	H_Poly poly = H_Poly();
-	int ith = 3; // 0,1,2 - char would be enough
+	char ith = 3; // 0,1,2 (3 = end)
 
 	H_PolyEdge() = default;
 	H_PolyEdge(H_Poly new_poly, char new_ith) : poly(new_poly), ith(new_ith) {}
@@ -69,7 +69,7 @@ struct H_PolyEdge {
 
 template<class P>
 auto& operator<<(::std::ostream& os, const H_PolyEdge<P>& pe) {
-	return os << "{poly:" << pe.poly << ", edge:" << pe.ith << "}";
+	return os << "{poly:" << pe.poly << ", edge:" << (int)pe.ith << "}";
 }
 
 
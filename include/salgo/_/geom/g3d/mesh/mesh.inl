@@ -208,6 +208,26 @@ public:
 		// }
 	}
 
+	// move vert `v` to handle `new_index[v]`, relinking all polys
+	// (poly handles are unchanged, vert handles are invalidated)
+	template<class NEW_INDEX>
+	void permute_verts(const NEW_INDEX& new_index) {
+		static_assert(P::Verts_Erasable_Mode != ERASABLE_HOLES, "permute_verts() not implemented for ERASABLE_HOLES verts");
+
+		const int n = _vs.domain();
+		Dynamic_Array<int> old_index(n);
+		for(int v=0; v<n; ++v) old_index[ new_index[v] ] = v;
+
+		typename P::Verts vs;
+		vs.reserve(n);
+		for(int v=0; v<n; ++v) vs.emplace_back( std::move( _vs[ old_index[v] ] ) );
+		_vs = std::move(vs);
+
+		for(auto& p : _ps) {
+			for(int i=0; i<3; ++i) p->verts[i].vert = (H_Vert) new_index[ p->verts[i].vert ];
+		}
+	}
+
 }; // class Mesh
 
 
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "../../graph/reorder-vertices.hpp"
+
+namespace salgo::geom::g3d {
+
+
+
+using Vertex_Order = salgo::graph::Vertex_Order;
+
+
+
+//
+// reorder_verts - renumber mesh verts for cache locality (see `graph/reorder-vertices`),
+// the adjacency is given by poly edges; returns `new_index[old_handle]`
+//
+template<class MESH>
+auto reorder_verts(MESH& mesh, Vertex_Order strategy) {
+	namespace det = salgo::graph::_::reorder_vertices;
+
+	det::Adjacency adj(mesh.verts().domain(), [&](auto&& add) {
+		for(auto& p : mesh.polys()) {
+			for(int i=0; i<3; ++i) add( p.vert(i).handle(), p.vert((i+1) % 3).handle() );
+		}
+	});
+
+	auto new_index = det::new_index( det::order(adj, strategy) );
+	mesh.permute_verts(new_index);
+	return new_index;
+}
+
+
+
+} // namespace salgo::geom::g3d
@@ -0,0 +1,467 @@
+#pragma once
+
+/*
+
+Non-recursive (explicit stack) component algorithms for `Graph` and `Csr_Graph`, safe for deep graphs.
+
+* `strongly_connected_components(g)` - Pearce's space-efficient variant of Tarjan's algorithm:
+  one int and one bit per vertex (instead of Tarjan's two ints and one bit).
+  Components are numbered in reverse topological order of the condensation (sinks first).
+
+* `strongly_connected_components_parallel(g, NUM_THREADS=n)` - multi-step (Slota et al.):
+  trimming and forward-backward reachability peel off trivial components and the giant one in parallel,
+  the rest is done by Pearce's algorithm. Needs in-edges (undirected, or ::DIRECTED ::BACKLINKS).
+  Components are numbered arbitrarily.
+
+* `topological_sort(g)` - Kahn's algorithm. If the graph has cycles, vertices on cycles and reachable
+  from them are missing from the result.
+
+* `articulation_points(g)`, `bridges(g)` - for undirected graphs. Parallel edges are never bridges.
+
+*/
+
+#include "named-arguments.hpp"
+#include "traversal.hpp"
+#include "../dynamic-array.inl"
+
+#include <glog/logging.h>
+
+#include <algorithm> // std::min, std::max
+#include <atomic>
+#include <cstdint>
+#include <memory> // std::unique_ptr
+#include <thread>
+#include <type_traits>
+#include <utility> // std::pair
+#include <vector>
+
+namespace salgo::graph {
+
+
+
+struct Components {
+	int count = 0;
+	salgo::Dynamic_Array<int> component; // by vertex handle
+};
+
+
+
+namespace _::components {
+
+using traversal::Bitset;
+
+
+
+template<class G>
+using Outs_Range = decltype( std::declval<G&>().vert(0).outs() );
+
+
+
+// Pearce, "A space-efficient algorithm for finding strongly connected components" (2016)
+//
+// `rindex[v]`: 0 if not visited, DFS index (lowered to the lowest reachable on-stack index) while in progress,
+// and `Done - component` when finished; `root[v]` is cleared when `rindex[v]` gets lowered
+//
+// vertices can be excluded beforehand with `exclude()`
+template<class G>
+class Pearce {
+	using Outs = Outs_Range<G>;
+
+	struct Frame {
+		int vert;
+		decltype( std::declval<Outs>().begin() ) iter;
+		decltype( std::declval<Outs>().end() ) end;
+	};
+
+	G& g;
+	const int domain;
+	const int Done; // larger than any DFS index
+	std::vector<int> rindex;
+	Bitset root;
+
+	std::vector<int> finished; // non-root vertices of unfinished components
+	std::vector<Frame> stack;
+
+	int index = 1;
+	int next_id; // decreasing
+
+public:
+	Pearce(G& graph) : g(graph), domain(graph.verts().domain()), Done(domain + 1),
+		rindex(domain), root(domain), next_id(Done - 1) {}
+
+	void exclude(int v) { rindex[v] = Done; }
+
+	void run() {
+		for(auto& vert : g.verts()) {
+			int v = vert.handle();
+			if(!rindex[v]) _visit(v);
+		}
+	}
+
+	int count() const { return Done - 1 - next_id; }
+
+	// components numbered from 0, in order of completion; -1 for excluded vertices
+	int component(int v) const { return rindex[v] == Done ? -1 : Done - 1 - rindex[v]; }
+
+private:
+	void _begin(int v) {
+		rindex[v] = index++;
+		root.set(v);
+		auto outs = g.vert(v).outs();
+		stack.push_back( Frame{ v, outs.begin(), outs.end() } );
+	}
+
+	void _lower(int v, int w) {
+		if(rindex[w] < rindex[v]) {
+			rindex[v] = rindex[w];
+			root.clear(v);
+		}
+	}
+
+	void _finish(int v) {
+		if(!root[v]) {
+			finished.emplace_back(v);
+			return;
+		}
+
+		--index;
+		while(!finished.empty() && rindex[v] <= rindex[ finished.back() ]) {
+			rindex[ finished.back() ] = next_id;
+			finished.pop_back();
+			--index;
+		}
+		rindex[v] = next_id--;
+	}
+
+	void _visit(int source) {
+		_begin(source);
+
+		while(!stack.empty()) {
+			auto& frame = stack.back();
+			int v = frame.vert;
+
+			if(frame.iter != frame.end) {
+				int w = (*frame.iter).vert().handle();
+				++frame.iter; // before `_begin`, it can reallocate the stack
+
+				if(!rindex[w]) _begin(w);
+				else _lower(v, w);
+				continue;
+			}
+
+			stack.pop_back();
+			_finish(v);
+			if(!stack.empty()) _lower(stack.back().vert, v);
+		}
+	}
+};
+
+
+
+// Tarjan's lowlink DFS on an undirected graph
+template<class G, class ON_ARTICULATION, class ON_BRIDGE>
+void lowlink(G& g, ON_ARTICULATION&& on_articulation, ON_BRIDGE&& on_bridge) {
+	static_assert(!std::remove_const_t<G>::Directed, "requires an undirected graph");
+
+	using Outs = Outs_Range<G>;
+
+	struct Frame {
+		int vert;
+		int parent;
+		bool parent_skipped; // only one edge to the parent is the tree edge, others are parallel edges
+		decltype( std::declval<Outs>().begin() ) iter;
+		decltype( std::declval<Outs>().end() ) end;
+	};
+
+	const int domain = g.verts().domain();
+	std::vector<int> disc(domain); // discovery time, 0 if not visited
+	std::vector<int> low(domain);
+	std::vector<Frame> stack;
+	int time = 0;
+
+	auto begin = [&](int v, int parent) {
+		disc[v] = low[v] = ++time;
+		auto outs = g.vert(v).outs();
+		stack.push_back( Frame{ v, parent, false, outs.begin(), outs.end() } );
+	};
+
+	for(auto& vert : g.verts()) {
+		int root = vert.handle();
+		if(disc[root]) continue;
+
+		int root_children = 0;
+		begin(root, -1);
+
+		while(!stack.empty()) {
+			auto& frame = stack.back();
+			int v = frame.vert;
+
+			if(frame.iter != frame.end) {
+				int u = (*frame.iter).vert().handle();
+				++frame.iter;
+
+				if(u == frame.parent && !frame.parent_skipped) frame.parent_skipped = true;
+				else if(disc[u]) low[v] = std::min(low[v], disc[u]);
+				else begin(u, v);
+				continue;
+			}
+
+			stack.pop_back();
+			if(stack.empty()) break;
+
+			int p = stack.back().vert;
+			low[p] = std::min(low[p], low[v]);
+
+			if(low[v] > disc[p]) on_bridge(p, v);
+
+			if(p == root) ++root_children;
+			else if(low[v] >= disc[p]) on_articulation(p);
+		}
+
+		if(root_children >= 2) on_articulation(root);
+	}
+}
+
+
+
+
+// bitset with atomic test-and-set
+class Atomic_Bitset {
+	std::unique_ptr<std::atomic<uint64_t>[]> _words;
+
+public:
+	Atomic_Bitset(int size) : _words( new std::atomic<uint64_t>[ (size + 63) / 64 ] ) {
+		for(int i=0; i < (size + 63) / 64; ++i) _words[i].store(0, std::memory_order_relaxed);
+	}
+
+	bool operator[](int i) const { return _words[i >> 6].load(std::memory_order_relaxed) & (1ULL << (i & 63)); }
+
+	// returns true if it was not set before
+	bool set(int i) {
+		auto& word = _words[i >> 6];
+		uint64_t bit = 1ULL << (i & 63);
+		if(word.load(std::memory_order_relaxed) & bit) return false;
+		return !(word.fetch_or(bit, std::memory_order_relaxed) & bit);
+	}
+};
+
+
+
+// run `f(begin, end, thread)` on `num_threads` contiguous parts of [0, n)
+template<class F>
+void parallel_for(int num_threads, int n, F&& f) {
+	std::vector<std::thread> threads;
+	for(int t=1; t<num_threads; ++t) {
+		threads.emplace_back( [&f, t, n, num_threads]{ f( (long long)n*t/num_threads, (long long)n*(t+1)/num_threads, t ); } );
+	}
+	f(0, n / num_threads, 0);
+	for(auto& thread : threads) thread.join();
+}
+
+
+
+} // namespace _::components
+
+
+
+
+
+
+
+template<class G>
+Components strongly_connected_components(G& g) {
+	namespace det = _::components;
+
+	det::Pearce<G> pearce(g);
+	pearce.run();
+
+	Components result;
+	result.count = pearce.count();
+	result.component.resize( g.verts().domain(), -1 );
+	for(auto& vert : g.verts()) {
+		int v = vert.handle();
+		result.component[v] = pearce.component(v);
+	}
+	return result;
+}
+
+
+
+
+template<class G, class... ARGS>
+Components strongly_connected_components_parallel(G& g, ARGS&&... _args) {
+	namespace det = _::components;
+	static_assert(_::traversal::Has_In_Edges<std::remove_const_t<G>>, "parallel SCC requires in-edges (undirected, or ::DIRECTED ::BACKLINKS)");
+
+	auto args = Named_Arguments( std::forward<ARGS>(_args)... );
+
+	static constexpr int Min_Verts_Per_Thread = 1<<14;
+	static constexpr int Trim_Rounds = 3;
+
+	const int domain = g.verts().domain();
+	int num_threads = args(NUM_THREADS, (int)std::thread::hardware_concurrency());
+	num_threads = std::max(1, std::min(num_threads, domain / Min_Verts_Per_Thread));
+
+	Components result;
+	result.component.resize(domain, -1);
+	auto& component = result.component;
+
+	std::vector<char> exists(domain);
+	for(auto& vert : g.verts()) exists[ vert.handle() ] = true;
+
+	auto alive = [&](int v) { return exists[v] && component[v] == -1; };
+
+
+	// trim: a vertex without alive in- or out-neighbours is a component on its own
+	std::vector<std::vector<int>> trimmed(num_threads);
+	for(int round=0; round<Trim_Rounds; ++round) {
+		det::parallel_for(num_threads, domain, [&](int begin, int end, int thread) {
+			for(int v=begin; v<end; ++v) {
+				if(!alive(v)) continue;
+
+				bool has_out = false, has_in = false;
+				for(auto& out : g.vert(v).outs()) {
+					int u = out.vert().handle();
+					if(u != v && alive(u)) { has_out = true; break; }
+				}
+				for(auto& in : _::traversal::in_edges(g, v)) {
+					int u = in.vert().handle();
+					if(u != v && alive(u)) { has_in = true; break; }
+				}
+				if(!has_out || !has_in) trimmed[thread].emplace_back(v);
+			}
+		});
+
+		int num_trimmed = 0;
+		for(auto& list : trimmed) {
+			for(int v : list) component[v] = result.count++;
+			num_trimmed += list.size();
+			list.clear();
+		}
+		if(num_trimmed < domain / 100) break;
+	}
+
+
+	// forward-backward from the vertex with most alive edges: the intersection is usually the giant component
+	int pivot = -1;
+	long long best = -1;
+	for(int v=0; v<domain; ++v) {
+		if(!alive(v)) continue;
+		long long degree = (long long)g.vert(v).outs().count() * _::traversal::in_edges(g, v).count();
+		if(degree > best) {
+			best = degree;
+			pivot = v;
+		}
+	}
+
+	if(pivot != -1) {
+		auto reach = [&](det::Atomic_Bitset& visited, bool forward) {
+			std::vector<int> frontier = {pivot};
+			std::vector<std::vector<int>> next(num_threads);
+			visited.set(pivot);
+
+			while(!frontier.empty()) {
+				det::parallel_for(num_threads, frontier.size(), [&](int begin, int end, int thread) {
+					auto relax = [&](auto&& edges) {
+						for(auto& e : edges) {
+							int u = e.vert().handle();
+							if(alive(u) && visited.set(u)) next[thread].emplace_back(u);
+						}
+					};
+
+					for(int i=begin; i<end; ++i) {
+						if(forward) relax( g.vert(frontier[i]).outs() );
+						else relax( _::traversal::in_edges(g, frontier[i]) );
+					}
+				});
+
+				frontier.clear();
+				for(auto& list : next) {
+					frontier.insert(frontier.end(), list.begin(), list.end());
+					list.clear();
+				}
+			}
+		};
+
+		det::Atomic_Bitset fw(domain), bw(domain);
+		reach(fw, true);
+		reach(bw, false);
+
+		const int id = result.count++;
+		det::parallel_for(num_threads, domain, [&](int begin, int end, int) {
+			for(int v=begin; v<end; ++v) if(fw[v] && bw[v]) component[v] = id;
+		});
+	}
+
+
+	// the rest
+	det::Pearce<G> pearce(g);
+	for(int v=0; v<domain; ++v) if(exists[v] && component[v] != -1) pearce.exclude(v);
+	pearce.run();
+
+	for(int v=0; v<domain; ++v) {
+		if(exists[v] && component[v] == -1) component[v] = result.count + pearce.component(v);
+	}
+	result.count += pearce.count();
+
+	return result;
+}
+
+
+
+
+// vertices in topological order
+template<class G>
+auto topological_sort(G& g) {
+	static_assert(std::remove_const_t<G>::Directed, "topological_sort() requires a directed graph");
+	using H_Vert = typename std::remove_const_t<G>::H_Vert;
+
+	std::vector<int> in_degree( g.verts().domain() );
+	for(auto& vert : g.verts()) {
+		for(auto& out : vert.outs()) ++in_degree[ out.vert().handle() ];
+	}
+
+	salgo::Dynamic_Array<H_Vert> order;
+	order.reserve( g.verts().count() );
+
+	for(auto& vert : g.verts()) {
+		if(!in_degree[ vert.handle() ]) order.emplace_back( vert.handle() );
+	}
+
+	// `order` is the queue
+	for(int i=0; i<order.count(); ++i) {
+		for(auto& out : g.vert( order[i] ).outs()) {
+			int u = out.vert().handle();
+			if(!--in_degree[u]) order.emplace_back( H_Vert(u) );
+		}
+	}
+
+	return order;
+}
+
+
+
+
+// `true` for vertices whose removal disconnects their component
+template<class G>
+salgo::Dynamic_Array<bool> articulation_points(G& g) {
+	salgo::Dynamic_Array<bool> result( g.verts().domain(), false );
+	_::components::lowlink(g, [&](int v) { result[v] = true; }, [](int, int) {});
+	return result;
+}
+
+
+
+// edges whose removal disconnects their component, as (parent, child) pairs of the DFS tree
+template<class G>
+auto bridges(G& g) {
+	using H_Vert = typename std::remove_const_t<G>::H_Vert;
+
+	salgo::Dynamic_Array<std::pair<H_Vert,H_Vert>> result;
+	_::components::lowlink(g, [](int) {}, [&](int a, int b) { result.emplace_back( H_Vert(a), H_Vert(b) ); });
+	return result;
+}
+
+
+
+} // namespace salgo::graph
@@ -0,0 +1,403 @@
+#pragma once
+
+/*
+
+Immutable snapshot of a `Graph` in compressed sparse row form - see `Graph::freeze()`.
+
+For each direction (outs, and ins if the graph has BACKLINKS):
+  * `offsets[v] .. offsets[v+1]` is the range of vertex `v` in the per-slot arrays,
+  * `targets[slot]` is the other vertex of the edge,
+  * `edges[slot]` is the edge index (if the graph has edge data),
+  * `vert_edge_data[slot]` (if the graph has vert-edge data).
+
+Vertex and edge data are stored in their own contiguous columns.
+
+All indices are 32-bit. Edges are renumbered densely (erased edges are dropped).
+
+*/
+
+#include "graph.hpp"
+
+#include "../accessors.hpp"
+#include "../add-member.hpp"
+#include "../handles.hpp"
+#include "../subscript-tags.hpp"
+
+#include <glog/logging.h>
+
+#include <array>
+#include <limits>
+#include <vector>
+
+#include "../helper-macros-on.inc"
+
+namespace salgo::graph::_::csr_graph {
+
+
+
+SALGO_ADD_MEMBER(_vert_data);
+SALGO_ADD_MEMBER(_edge_data);
+SALGO_ADD_MEMBER(edges);
+SALGO_ADD_MEMBER(vert_edge_data);
+
+
+
+struct H_Vert : Int_Handle_Base<H_Vert, int> {
+	using BASE = Int_Handle_Base<H_Vert, int>;
+	H_Vert() = default;
+	H_Vert(int i) : BASE(i) {}
+};
+
+struct H_Edge : Int_Handle_Base<H_Edge, int> {
+	using BASE = Int_Handle_Base<H_Edge, int>;
+	H_Edge() = default;
+	H_Edge(int i) : BASE(i) {}
+};
+
+// slot index in the outs (oi == 0) or ins (oi == 1) arrays
+template<int oi>
+struct H_Vert_Edge : Int_Handle_Base<H_Vert_Edge<oi>, int> {
+	using BASE = Int_Handle_Base<H_Vert_Edge<oi>, int>;
+	H_Vert_Edge() = default;
+	H_Vert_Edge(int i) : BASE(i) {}
+};
+
+
+
+
+template<class P>
+class Csr_Graph;
+
+template<class P, Const_Flag C, int oi>
+class A_Vert_Edges;
+
+
+
+
+template<class P>
+struct Verts_Context {
+	using Container = Csr_Graph<P>;
+	using Handle = H_Vert;
+
+	template<Const_Flag C>
+	class Accessor : public Accessor_Base<C,Verts_Context> {
+		using BASE = Accessor_Base<C,Verts_Context>;
+
+	public:
+		using BASE::BASE;
+
+	public:
+		auto& graph() const { return CONT; }
+
+		auto outs() const { return A_Vert_Edges<P,C,0>( CONT, HANDLE ); }
+		auto ins()  const { static_assert(P::Has_Ins); return A_Vert_Edges<P,C,1>( CONT, HANDLE ); }
+
+		template<class X> auto out(const X& x) const { return outs()(x); }
+		template<class X> auto in(const X& x)  const { return ins()(x); }
+	};
+
+
+	struct End_Iterator {};
+
+
+	template<Const_Flag C>
+	class Iterator : public Iterator_Base<C,Verts_Context> {
+		using BASE = Iterator_Base<C,Verts_Context>;
+
+	public:
+		using BASE::BASE;
+
+	private:
+		friend BASE;
+
+		void _increment() { ++MUT_HANDLE; }
+		void _decrement() { --MUT_HANDLE; }
+
+	public:
+		bool operator!=(End_Iterator) const { return HANDLE.a != CONT._num_verts; }
+	};
+};
+
+
+
+
+template<class P>
+struct Edges_Context {
+	using Container = Csr_Graph<P>;
+	using Handle = H_Edge;
+
+	template<Const_Flag C>
+	class Accessor : public Accessor_Base<C,Edges_Context> {
+		using BASE = Accessor_Base<C,Edges_Context>;
+
+	public:
+		using BASE::BASE;
+
+		auto& graph() const { return CONT; }
+	};
+
+	template<Const_Flag C>
+	using Iterator = Accessor<C>; // not iterable
+};
+
+
+
+
+template<class P, int oi>
+struct Vert_Edges_Context {
+	using Container = Csr_Graph<P>;
+	using Handle = H_Vert_Edge<oi>;
+
+	template<Const_Flag C>
+	class Accessor : public Accessor_Base<C,Vert_Edges_Context> {
+		using BASE = Accessor_Base<C,Vert_Edges_Context>;
+
+	public:
+		using BASE::BASE;
+
+	public:
+		auto& graph() const { return CONT; }
+
+		auto vert() const { return CONT.vert( CONT._dirs[oi].targets[HANDLE] ); }
+
+		auto edge() const {
+			static_assert(P::Has_Edge_Data, "edge() requires EDGE_DATA");
+			return CONT.edge( CONT._dirs[oi].edges[HANDLE] );
+		}
+
+		auto& data() const {
+			static_assert(P::Has_Vert_Edge_Data, "data() requires VERT_EDGE_DATA");
+			return CONT._dirs[oi].vert_edge_data[HANDLE];
+		}
+	};
+
+
+	struct End_Iterator { int slot; };
+
+
+	template<Const_Flag C>
+	class Iterator : public Iterator_Base<C,Vert_Edges_Context> {
+		using BASE = Iterator_Base<C,Vert_Edges_Context>;
+
+	public:
+		using BASE::BASE;
+
+	private:
+		friend BASE;
+
+		void _increment() { ++MUT_HANDLE; }
+		void _decrement() { --MUT_HANDLE; }
+
+	public:
+		bool operator!=(End_Iterator end) const { return HANDLE.a != end.slot; }
+	};
+};
+
+
+
+
+template<class P, Const_Flag C, int oi>
+class A_Vert_Edges {
+public:
+	int count() const { return _end() - _begin(); }
+	int domain() const { return count(); }
+
+	bool  is_empty() const { return count() == 0; }
+	bool not_empty() const { return !is_empty(); }
+
+	auto operator()(int i)   const { DCHECK_LT(i, count()); return _accessor( _begin() + i ); }
+	auto operator()(First_Tag) const { DCHECK(not_empty()); return _accessor( _begin() ); }
+	auto operator()(Last_Tag)  const { DCHECK(not_empty()); return _accessor( _end() - 1 ); }
+
+	auto begin() const { return typename Vert_Edges_Context<P,oi>::template Iterator<C>( &_graph, _begin() ); }
+	auto end()   const { return typename Vert_Edges_Context<P,oi>::End_Iterator{ _end() }; }
+
+private:
+	int _begin() const { return _graph._dirs[oi].offsets[_vert]; }
+	int _end()   const { return _graph._dirs[oi].offsets[_vert + 1]; }
+
+	auto _accessor(int slot) const { return typename Vert_Edges_Context<P,oi>::template Accessor<C>( &_graph, slot ); }
+
+public:
+	A_Vert_Edges(Const<Csr_Graph<P>,C>& graph, H_Vert vert) : _graph(graph), _vert(vert) {}
+
+private:
+	Const<Csr_Graph<P>,C>& _graph;
+	H_Vert _vert;
+};
+
+
+
+
+template<class P, Const_Flag C>
+class A_Verts {
+public:
+	int count()  const { return _graph._num_verts; }
+	int domain() const { return _graph._num_verts; }
+
+	bool  is_empty() const { return count() == 0; }
+	bool not_empty() const { return !is_empty(); }
+
+	auto begin() const { return typename Verts_Context<P>::template Iterator<C>( &_graph, 0 ); }
+	auto end()   const { return typename Verts_Context<P>::End_Iterator(); }
+
+public:
+	A_Verts(Const<Csr_Graph<P>,C>& graph) : _graph(graph) {}
+
+private:
+	Const<Csr_Graph<P>,C>& _graph;
+};
+
+
+
+
+template<class P>
+class Csr_Graph :
+		private Add__vert_data<std::vector<typename P::Vert_Data>, P::Has_Vert_Data>,
+		private Add__edge_data<std::vector<typename P::Edge_Data>, P::Has_Edge_Data> {
+
+	using VERT_DATA_BASE = Add__vert_data<std::vector<typename P::Vert_Data>, P::Has_Vert_Data>;
+	using EDGE_DATA_BASE = Add__edge_data<std::vector<typename P::Edge_Data>, P::Has_Edge_Data>;
+
+	template<class> friend struct Verts_Context;
+	template<class, int> friend struct Vert_Edges_Context;
+	template<class, Const_Flag, int> friend class A_Vert_Edges;
+	template<class, Const_Flag> friend class A_Verts;
+
+public:
+	static constexpr bool Directed = P::Directed;
+	static constexpr bool Backlinks = P::Backlinks;
+	static constexpr bool Has_Ins = P::Has_Ins;
+	static constexpr bool Has_Edge_Data = P::Has_Edge_Data;
+
+	using H_Vert = csr_graph::H_Vert;
+	using H_Edge = csr_graph::H_Edge;
+	using H_Out  = H_Vert_Edge<0>;
+	using H_In   = H_Vert_Edge<1>;
+
+private:
+	struct Dir :
+			Add_edges<std::vector<int>, P::Has_Edge_Data>,
+			Add_vert_edge_data<std::vector<typename P::Vert_Edge_Data>, P::Has_Vert_Edge_Data> {
+		std::vector<int> offsets;
+		std::vector<int> targets;
+	};
+
+	std::array<Dir, P::Has_Ins ? 2 : 1> _dirs;
+	int _num_verts = 0;
+
+public:
+	Csr_Graph() = default;
+
+	// see `Graph::freeze()`
+	explicit Csr_Graph(const graph::Graph<P>& g) {
+		static_assert(P::Verts_Erasable == graph::NOT_ERASABLE, "freeze() requires a graph without erasable vertices");
+
+		auto& vs = P::raw_vs(g);
+		_num_verts = vs.domain();
+
+		if constexpr(P::Has_Vert_Data) {
+			VERT_DATA_BASE::_vert_data.reserve(_num_verts);
+			for(int v=0; v<_num_verts; ++v) VERT_DATA_BASE::_vert_data.emplace_back( vs[v].data );
+		}
+
+		// edges are renumbered densely, in order of first appearance
+		std::vector<int> edge_index;
+
+		for(int oi=0; oi<(int)_dirs.size(); ++oi) {
+			auto& dir = _dirs[oi];
+			dir.offsets.reserve(_num_verts + 1);
+			dir.offsets.emplace_back(0);
+
+			for(int v=0; v<_num_verts; ++v) {
+				for(auto& e : vs[v].outs_ins[oi]) {
+					const auto& vert_edge = e();
+
+					if constexpr(graph::Vert_Edge<P>::Links_Vert_Edge) dir.targets.emplace_back( vert_edge.link.a );
+					else dir.targets.emplace_back( vert_edge.link );
+
+					if constexpr(P::Has_Edge_Data) {
+						int old = vert_edge.edge;
+						if(old >= (int)edge_index.size()) edge_index.resize(old + 1, -1);
+						if(edge_index[old] == -1) {
+							edge_index[old] = EDGE_DATA_BASE::_edge_data.size();
+							EDGE_DATA_BASE::_edge_data.emplace_back( P::raw_es(g)[ vert_edge.edge ].data );
+						}
+						dir.edges.emplace_back( edge_index[old] );
+					}
+
+					if constexpr(P::Has_Vert_Edge_Data) dir.vert_edge_data.emplace_back( vert_edge.data );
+				}
+
+				DCHECK_LE(dir.targets.size(), (size_t)std::numeric_limits<int>::max()) << "Csr_Graph uses 32-bit indices";
+				dir.offsets.emplace_back( (int)dir.targets.size() );
+			}
+		}
+	}
+
+
+public:
+	auto vert(H_Vert handle)       { return _vert_accessor<MUTAB>(handle); }
+	auto vert(H_Vert handle) const { return _vert_accessor<CONST>(handle); }
+
+	auto operator()(H_Vert handle)       { return vert(handle); }
+	auto operator()(H_Vert handle) const { return vert(handle); }
+
+	auto edge(H_Edge handle)       { return typename Edges_Context<P>::template Accessor<MUTAB>(this, handle); }
+	auto edge(H_Edge handle) const { return typename Edges_Context<P>::template Accessor<CONST>(this, handle); }
+
+	auto operator()(H_Edge handle)       { return edge(handle); }
+	auto operator()(H_Edge handle) const { return edge(handle); }
+
+
+	template<class PP = P, class = std::enable_if_t< PP::Has_Vert_Data >>
+	auto& operator[](H_Vert handle)       { _check(handle); return VERT_DATA_BASE::_vert_data[handle]; }
+
+	template<class PP = P, class = std::enable_if_t< PP::Has_Vert_Data >>
+	auto& operator[](H_Vert handle) const { _check(handle); return VERT_DATA_BASE::_vert_data[handle]; }
+
+	template<class PP = P, class = std::enable_if_t< PP::Has_Edge_Data >>
+	auto& operator[](H_Edge handle)       { return EDGE_DATA_BASE::_edge_data[handle]; }
+
+	template<class PP = P, class = std::enable_if_t< PP::Has_Edge_Data >>
+	auto& operator[](H_Edge handle) const { return EDGE_DATA_BASE::_edge_data[handle]; }
+
+
+	auto verts()       { return A_Verts<P,MUTAB>(*this); }
+	auto verts() const { return A_Verts<P,CONST>(*this); }
+
+	// number of edges (with edge data), or of out-slots otherwise
+	int num_edges() const {
+		if constexpr(P::Has_Edge_Data) return EDGE_DATA_BASE::_edge_data.size();
+		else return _dirs[0].targets.size();
+	}
+
+
+	//
+	// raw arrays, for hand-written loops
+	//
+	const int* out_offsets() const { return _dirs[0].offsets.data(); }
+	const int* out_targets() const { return _dirs[0].targets.data(); }
+
+	const int* in_offsets() const { static_assert(P::Has_Ins); return _dirs[1].offsets.data(); }
+	const int* in_targets() const { static_assert(P::Has_Ins); return _dirs[1].targets.data(); }
+
+
+private:
+	template<Const_Flag C>
+	auto _vert_accessor(H_Vert handle) const {
+		_check(handle);
+		return typename Verts_Context<P>::template Accessor<C>( const_cast<Const<Csr_Graph,C>*>(this), handle );
+	}
+
+	void _check(H_Vert handle) const {
+		DCHECK_GE(handle, 0) << "vert handle out of bounds";
+		DCHECK_LT(handle, _num_verts) << "vert handle out of bounds";
+	}
+};
+
+
+
+} // namespace salgo::graph::_::csr_graph
+
+#include "../helper-macros-off.inc"
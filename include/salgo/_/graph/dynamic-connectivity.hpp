@@ -0,0 +1,132 @@
+#pragma once
+
+#include "../union-find.inl"
+
+#include <glog/logging.h>
+
+#include <algorithm> // std::sort, std::max, std::min
+#include <numeric> // std::iota
+#include <utility> // std::pair
+#include <vector>
+
+namespace salgo::graph {
+
+
+
+// edge exists at times `from <= time < to`
+struct Lifetime {
+	int from;
+	int to;
+};
+
+// are `a` and `b` connected at `time`?
+struct Connectivity_Query {
+	int time;
+	int a;
+	int b;
+};
+
+
+
+namespace _::dynamic_connectivity {
+
+struct Solver {
+	using Edge = std::pair<int,int>;
+
+	int size; // leaves of the segment tree, power of 2
+	std::vector<std::vector<Edge>> tree_edges;
+
+	const std::vector<Connectivity_Query>& queries;
+	std::vector<int> order; // queries sorted by time
+	int next_query = 0;
+
+	salgo::Union_Find ::ROLLBACK uf;
+	std::vector<bool> result;
+
+	Solver(int num_verts, int num_times, const std::vector<Connectivity_Query>& qs)
+			: queries(qs), uf(num_verts), result(qs.size()) {
+		size = 1;
+		while(size < num_times) size *= 2;
+		tree_edges.resize(2*size);
+
+		order.resize( queries.size() );
+		std::iota(order.begin(), order.end(), 0);
+		std::sort(order.begin(), order.end(), [&](int i, int j){ return queries[i].time < queries[j].time; });
+	}
+
+	// edge exists at times [fr,to)
+	void add(Edge edge, int fr, int to) {
+		for(fr += size, to += size; fr < to; fr /= 2, to /= 2) {
+			if(fr & 1) tree_edges[fr++].emplace_back(edge);
+			if(to & 1) tree_edges[--to].emplace_back(edge);
+		}
+	}
+
+	void solve(int node) {
+		auto checkpoint = uf.checkpoint();
+		for(auto& [a, b] : tree_edges[node]) uf.merge(a, b);
+
+		if(node >= size) {
+			int time = node - size;
+			for(; next_query < (int)order.size() && queries[ order[next_query] ].time == time; ++next_query) {
+				auto& q = queries[ order[next_query] ];
+				result[ order[next_query] ] = uf(q.a) == uf(q.b);
+			}
+		}
+		else {
+			solve(2*node);
+			solve(2*node + 1);
+		}
+
+		uf.rollback(checkpoint);
+	}
+};
+
+} // namespace _::dynamic_connectivity
+
+
+
+//
+// offline dynamic connectivity
+//
+// `graph` is undirected, and edge data has `from` and `to` members - e.g. `Graph ::EDGE_DATA<Lifetime>`
+// (parallel edges with different lifetimes are fine)
+//
+// edge lifetimes are put into a segment tree over time; the tree is traversed depth-first, merging edges of
+// each node on the way down (`Union_Find ::ROLLBACK`) and undoing the merges on the way up
+//
+// O((E log T + Q) log V) for T = 1 + biggest query time
+//
+template<class GRAPH>
+std::vector<bool> offline_connectivity(GRAPH& graph, const std::vector<Connectivity_Query>& queries) {
+	static_assert(!GRAPH::Directed, "offline_connectivity() requires an undirected graph");
+
+	int num_times = 0;
+	for(auto& q : queries) {
+		DCHECK_GE(q.time, 0);
+		num_times = std::max(num_times, q.time + 1);
+	}
+
+	_::dynamic_connectivity::Solver solver( graph.verts().domain(), num_times, queries );
+	if(queries.empty()) return {};
+
+	for(auto& vert : graph.verts()) {
+		int a = vert.handle();
+		for(auto& out : vert.outs()) {
+			int b = out.vert().handle();
+			if(b <= a) continue; // every edge is listed by both endpoints (self-loops don't matter)
+
+			auto& lifetime = out.edge().data();
+			int fr = std::max(lifetime.from, 0);
+			int to = std::min(lifetime.to, num_times);
+			if(fr < to) solver.add({a, b}, fr, to);
+		}
+	}
+
+	solver.solve(1);
+	return std::move(solver.result);
+}
+
+
+
+} // namespace salgo::graph
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "graph.hpp"
+#include "csr-graph.hpp"
 
 #include "../alloc/array-allocator.inl" // default for vs
 #include "../dynamic-array.inl" // default
@@ -533,7 +534,7 @@ public:
 			fr_out().link = H_Vert_Edge_Base{ to, to_in };
 			to_in().link  = H_Vert_Edge_Base{ fr, fr_out };
 			if constexpr(P::Has_Edge_Data || P::Edges_Global) {
-				auto edge = _graph._es.add( fr, to, std::forward<ARGS>(args)... );
+				auto edge = P::raw_es(_graph).add( fr, to, std::forward<ARGS>(args)... );
 				fr_out().edge = edge;
 				to_in().edge = edge;
 			}
@@ -726,6 +727,40 @@ public:
 
 	auto edges()       {  return A_Edges<P,MUTAB>( *this );  }
 	auto edges() const {  return A_Edges<P,CONST>( *this );  }
+
+
+public:
+	using Csr_Graph = csr_graph::Csr_Graph<P>;
+
+	// immutable snapshot with contiguous adjacency arrays, for fast traversals
+	auto freeze() const { return Csr_Graph(*this); }
+
+
+public:
+	// move vertex `v` to handle `new_index[v]`, relinking all vert-edges
+	// (edge handles are unchanged, vertex handles are invalidated)
+	template<class NEW_INDEX>
+	void permute_verts(const NEW_INDEX& new_index) {
+		static_assert(P::Verts_Erasable != ERASABLE_HOLES, "permute_verts() not implemented for ERASABLE_HOLES verts");
+
+		const int n = _vs.domain();
+		Dynamic_Array<int> old_index(n);
+		for(int v=0; v<n; ++v) old_index[ new_index[v] ] = v;
+
+		typename P::Verts vs;
+		vs.reserve(n);
+		for(int v=0; v<n; ++v) vs.emplace_back( std::move( _vs[ old_index[v] ] ) );
+		_vs = std::move(vs);
+
+		for(auto& vert : _vs) {
+			for(auto& vert_edges : vert().outs_ins) {
+				for(auto& vert_edge : vert_edges) {
+					auto& other = vert_edge().vert();
+					other = H_Vert( new_index[ (int)other ] );
+				}
+			}
+		}
+	}
 };
 
 
@@ -742,6 +777,7 @@ struct With_Builder : Graph<P> {
 
 	using P::Directed;
 	using P::Backlinks;
+	using P::Has_Edge_Data;
 	using typename P::Vert_Data;
 	using typename P::Edge_Data;
 	using typename P::Vert_Edge_Data;
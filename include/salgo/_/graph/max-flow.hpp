@@ -0,0 +1,534 @@
+#pragma once
+
+/*
+
+Maximum flow and minimum cut on a directed `Graph` or `Csr_Graph` with edge data.
+
+`capacity(out)` is called once per edge with an out-edge accessor, e.g. `[](auto& out){ return out.edge().data(); }`.
+Its return type is the capacity/flow type. Integer capacities are recommended (floating-point works, but is subject to rounding).
+
+* `max_flow` - Dinic with current-arc optimization
+* `max_flow_push_relabel` - highest-label push-relabel with global relabeling and the gap heuristic
+* `min_cut` - first phase of push-relabel only: the flow value and a minimum cut, without the flow itself
+
+The graph is not modified: residual capacities are kept in a separate array of paired arcs (one forward and one
+backward arc per edge), grouped by vertex.
+
+*/
+
+#include "../dynamic-array.inl"
+
+#include <glog/logging.h>
+
+#include <algorithm> // std::min, std::max
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+namespace salgo::graph {
+
+
+
+template<class CAP, class H_EDGE>
+struct Min_Cut {
+	using Cap = CAP;
+	using H_Edge = H_EDGE;
+
+	Cap value = 0;
+
+	salgo::Dynamic_Array<bool> source_side; // by vertex handle
+	std::vector<H_Edge> edges; // edges from the source side to the sink side (all saturated)
+};
+
+
+template<class CAP, class H_EDGE>
+struct Max_Flow : Min_Cut<CAP,H_EDGE> {
+	salgo::Dynamic_Array<CAP> flow; // by edge handle
+};
+
+
+
+namespace _::max_flow {
+
+
+
+template<class G, class CAPACITY>
+using Cap = std::decay_t<decltype( std::declval<CAPACITY&>()( *std::declval<G&>().vert(0).outs().begin() ) )>;
+
+
+
+// residual network: arcs of vertex `v` are `offsets[v] .. offsets[v+1]`
+template<class CAP>
+struct Residual {
+	int num_verts = 0;
+	int edges_domain = 0;
+
+	std::vector<int> offsets;
+	std::vector<int> head; // arc target
+	std::vector<int> rev; // paired arc
+	std::vector<int> edge; // edge handle for forward arcs, -1 for backward arcs
+	std::vector<CAP> cap; // residual capacity
+
+	int num_arcs() const { return head.size(); }
+	int tail(int arc) const { return head[ rev[arc] ]; }
+};
+
+
+template<class G, class CAPACITY>
+auto build(G& g, CAPACITY& capacity) {
+	static_assert(std::remove_const_t<G>::Directed, "max flow requires a directed graph");
+	static_assert(std::remove_const_t<G>::Has_Edge_Data, "max flow requires EDGE_DATA (flow is indexed by edge handle)");
+
+	using Cap = max_flow::Cap<G,CAPACITY>;
+
+	Residual<Cap> r;
+	const int n = r.num_verts = g.verts().domain();
+
+	r.offsets.assign(n+1, 0);
+	for(auto& vert : g.verts()) {
+		for(auto& out : vert.outs()) {
+			++r.offsets[ (int)vert.handle() + 1 ];
+			++r.offsets[ (int)out.vert().handle() + 1 ];
+		}
+	}
+	for(int v=0; v<n; ++v) r.offsets[v+1] += r.offsets[v];
+
+	const int m = r.offsets[n];
+	r.head.resize(m);
+	r.rev.resize(m);
+	r.edge.resize(m);
+	r.cap.resize(m);
+
+	std::vector<int> pos( r.offsets.begin(), r.offsets.end() - 1 );
+	for(auto& vert : g.verts()) {
+		int v = vert.handle();
+		for(auto& out : vert.outs()) {
+			int u = out.vert().handle();
+			int e = out.edge().handle();
+
+			Cap c = capacity(out);
+			DCHECK_GE(c, 0) << "negative capacity";
+
+			int a = pos[v]++;
+			int b = pos[u]++;
+			r.head[a] = u;  r.rev[a] = b;  r.edge[a] = e;   r.cap[a] = c;
+			r.head[b] = v;  r.rev[b] = a;  r.edge[b] = -1;  r.cap[b] = 0;
+
+			r.edges_domain = std::max(r.edges_domain, e+1);
+		}
+	}
+
+	return r;
+}
+
+
+
+// vertices reachable from `from` in the residual network (or reaching it, if `reverse`)
+template<class CAP>
+std::vector<bool> residual_reach(const Residual<CAP>& r, int from, bool reverse) {
+	std::vector<bool> result(r.num_verts);
+	std::vector<int> queue = {from};
+	result[from] = true;
+
+	for(int i=0; i<(int)queue.size(); ++i) {
+		int v = queue[i];
+		for(int a = r.offsets[v]; a < r.offsets[v+1]; ++a) {
+			int u = r.head[a];
+			if(result[u] || !(r.cap[ reverse ? r.rev[a] : a ] > 0)) continue;
+			result[u] = true;
+			queue.emplace_back(u);
+		}
+	}
+
+	return result;
+}
+
+
+template<class RESULT, class CAP>
+void set_cut(RESULT& result, const Residual<CAP>& r, const std::vector<bool>& source_side) {
+	using H_Edge = typename RESULT::H_Edge;
+
+	result.source_side.resize(r.num_verts, false);
+	for(int v=0; v<r.num_verts; ++v) result.source_side[v] = source_side[v];
+
+	for(int v=0; v<r.num_verts; ++v) if(source_side[v]) {
+		for(int a = r.offsets[v]; a < r.offsets[v+1]; ++a) {
+			if(r.edge[a] != -1 && !source_side[ r.head[a] ]) result.edges.emplace_back( H_Edge(r.edge[a]) );
+		}
+	}
+}
+
+
+// flow of an edge is the residual capacity of its backward arc
+template<class RESULT, class CAP>
+void set_flow(RESULT& result, const Residual<CAP>& r) {
+	result.flow.resize(r.edges_domain, CAP(0));
+	for(int a=0; a<r.num_arcs(); ++a) {
+		if(r.edge[a] != -1) result.flow[ r.edge[a] ] = r.cap[ r.rev[a] ];
+	}
+}
+
+
+
+
+template<class CAP>
+class Dinic {
+	Residual<CAP>& r;
+	const int source;
+	const int sink;
+
+	std::vector<int> level;
+	std::vector<int> current; // first arc not known to be useless, per vertex
+	std::vector<int> queue;
+	std::vector<int> path; // arcs
+
+public:
+	Dinic(Residual<CAP>& residual, int s, int t) : r(residual), source(s), sink(t),
+		level(r.num_verts), current(r.num_verts) {}
+
+	CAP run() {
+		CAP total = 0;
+		while(_bfs()) total += _blocking_flow();
+		return total;
+	}
+
+private:
+	// levels from the source, up to the sink's level
+	bool _bfs() {
+		std::fill(level.begin(), level.end(), -1);
+		queue.clear();
+		queue.emplace_back(source);
+		level[source] = 0;
+
+		for(int i=0; i<(int)queue.size(); ++i) {
+			int v = queue[i];
+			if(level[sink] != -1 && level[v] >= level[sink]) break;
+
+			for(int a = r.offsets[v]; a < r.offsets[v+1]; ++a) {
+				int u = r.head[a];
+				if(level[u] != -1 || !(r.cap[a] > 0)) continue;
+				level[u] = level[v] + 1;
+				queue.emplace_back(u);
+			}
+		}
+
+		return level[sink] != -1;
+	}
+
+	// iterative: advance along current arcs, augment at the sink, retreat from dead ends
+	CAP _blocking_flow() {
+		std::copy(r.offsets.begin(), r.offsets.end() - 1, current.begin());
+
+		CAP total = 0;
+		path.clear();
+		int v = source;
+
+		for(;;) {
+			if(v == sink) {
+				CAP f = std::numeric_limits<CAP>::max();
+				for(int a : path) f = std::min(f, r.cap[a]);
+
+				int saturated = -1;
+				for(int i=0; i<(int)path.size(); ++i) {
+					int a = path[i];
+					r.cap[a] -= f;
+					r.cap[ r.rev[a] ] += f;
+					if(saturated == -1 && !(r.cap[a] > 0)) saturated = i;
+				}
+				total += f;
+
+				// continue from the tail of the first saturated arc
+				v = r.tail( path[saturated] );
+				path.resize(saturated);
+				continue;
+			}
+
+			int& a = current[v];
+			const int end = r.offsets[v+1];
+			while(a < end && !(r.cap[a] > 0 && level[ r.head[a] ] == level[v] + 1)) ++a;
+
+			if(a < end) {
+				path.emplace_back(a);
+				v = r.head[a];
+				continue;
+			}
+
+			// dead end
+			level[v] = -1;
+			if(path.empty()) break;
+			v = r.tail( path.back() );
+			path.pop_back();
+		}
+
+		return total;
+	}
+};
+
+
+
+
+// highest-label push-relabel
+//
+// active vertices and all vertices are kept in lists by height; a vertex at height >= n can't reach the sink
+//
+// `run(source, sink)` moves excess of all other vertices towards `sink` (or to height >= n), keeping `source` at height n
+template<class CAP>
+class Push_Relabel {
+	Residual<CAP>& r;
+	const int n;
+
+	std::vector<CAP> excess;
+	std::vector<int> height;
+	std::vector<int> current;
+
+	std::vector<int> active_head; // by height, singly-linked through `active_next`
+	std::vector<int> active_next;
+
+	std::vector<int> all_head; // by height, doubly-linked through `all_next`, `all_prev`
+	std::vector<int> all_next;
+	std::vector<int> all_prev;
+
+	std::vector<int> queue;
+
+	int max_active = -1;
+	int max_height = -1;
+
+	int source = -1;
+	int sink = -1;
+
+	long long work = 0;
+
+public:
+	explicit Push_Relabel(Residual<CAP>& residual) : r(residual), n(residual.num_verts),
+		excess(n), height(n), current(n),
+		active_head(n, -1), active_next(n, -1),
+		all_head(n, -1), all_next(n, -1), all_prev(n, -1) {}
+
+	// returns the flow value
+	CAP max_preflow(int s, int t) {
+		for(int a = r.offsets[s]; a < r.offsets[s+1]; ++a) {
+			CAP c = r.cap[a];
+			r.cap[a] = 0;
+			r.cap[ r.rev[a] ] += c;
+			excess[ r.head[a] ] += c;
+			excess[s] -= c;
+		}
+
+		_run(s, t);
+		return excess[t];
+	}
+
+	// return the remaining excess to the source
+	void preflow_to_flow(int s, int t) { _run(t, s); }
+
+private:
+	bool _is_active(int v) const { return v != source && v != sink && excess[v] > 0; }
+
+	void _add_active(int v) {
+		int h = height[v];
+		active_next[v] = active_head[h];
+		active_head[h] = v;
+		max_active = std::max(max_active, h);
+	}
+
+	void _add_all(int v) {
+		int h = height[v];
+		all_prev[v] = -1;
+		all_next[v] = all_head[h];
+		if(all_head[h] != -1) all_prev[ all_head[h] ] = v;
+		all_head[h] = v;
+		max_height = std::max(max_height, h);
+	}
+
+	void _remove_all(int v) {
+		if(all_prev[v] != -1) all_next[ all_prev[v] ] = all_next[v];
+		else all_head[ height[v] ] = all_next[v];
+		if(all_next[v] != -1) all_prev[ all_next[v] ] = all_prev[v];
+	}
+
+
+	// exact distances to the sink in the residual network
+	void _global_relabel() {
+		work = 0;
+
+		std::fill(height.begin(), height.end(), n);
+		std::fill(active_head.begin(), active_head.end(), -1);
+		std::fill(all_head.begin(), all_head.end(), -1);
+		max_active = max_height = -1;
+
+		height[sink] = 0;
+		queue.clear();
+		queue.emplace_back(sink);
+
+		for(int i=0; i<(int)queue.size(); ++i) {
+			int v = queue[i];
+			for(int a = r.offsets[v]; a < r.offsets[v+1]; ++a) {
+				int u = r.head[a];
+				if(height[u] != n || u == source || !(r.cap[ r.rev[a] ] > 0)) continue;
+
+				height[u] = height[v] + 1;
+				current[u] = r.offsets[u];
+				queue.emplace_back(u);
+
+				_add_all(u);
+				if(_is_active(u)) _add_active(u);
+			}
+		}
+	}
+
+
+	void _push(int v, int a) {
+		int u = r.head[a];
+		CAP d = std::min(excess[v], r.cap[a]);
+
+		r.cap[a] -= d;
+		r.cap[ r.rev[a] ] += d;
+		excess[v] -= d;
+
+		bool was_active = _is_active(u);
+		excess[u] += d;
+		if(!was_active && _is_active(u)) _add_active(u);
+	}
+
+
+	// all vertices above an empty height can't reach the sink
+	void _gap(int h) {
+		for(int k = h; k <= max_height; ++k) {
+			for(int v = all_head[k]; v != -1; v = all_next[v]) height[v] = n;
+			all_head[k] = -1;
+		}
+		max_height = h - 1;
+	}
+
+
+	void _discharge(int v) {
+		const int end = r.offsets[v+1];
+
+		for(;;) {
+			for(int& a = current[v]; a < end; ++a) {
+				if(r.cap[a] > 0 && height[ r.head[a] ] == height[v] - 1) {
+					_push(v, a);
+					if(!(excess[v] > 0)) return;
+				}
+			}
+
+			// relabel
+			int old = height[v];
+			if(all_head[old] == v && all_next[v] == -1) {
+				_gap(old);
+				return;
+			}
+
+			_remove_all(v);
+
+			int new_height = n;
+			for(int a = r.offsets[v]; a < end; ++a) {
+				if(r.cap[a] > 0 && height[ r.head[a] ] + 1 < new_height) {
+					new_height = height[ r.head[a] ] + 1;
+					current[v] = a;
+				}
+			}
+			work += end - r.offsets[v] + 12;
+
+			height[v] = new_height;
+			if(new_height >= n) return;
+			_add_all(v);
+		}
+	}
+
+
+	void _run(int s, int t) {
+		source = s;
+		sink = t;
+		_global_relabel();
+
+		const long long global_relabel_work = 6LL * n + r.num_arcs();
+
+		while(max_active >= 0) {
+			int v = active_head[max_active];
+			if(v == -1) {
+				--max_active;
+				continue;
+			}
+			active_head[max_active] = active_next[v];
+
+			_discharge(v);
+
+			if(work > global_relabel_work) _global_relabel();
+		}
+	}
+};
+
+
+
+} // namespace _::max_flow
+
+
+
+
+
+
+
+
+// Dinic
+template<class G, class CAPACITY>
+auto max_flow(G& g, int source, int sink, CAPACITY&& capacity) {
+	namespace det = _::max_flow;
+	using Result = Max_Flow< det::Cap<G,CAPACITY>, typename std::remove_const_t<G>::H_Edge >;
+
+	DCHECK_NE(source, sink);
+	auto r = det::build(g, capacity);
+
+	Result result;
+	result.value = det::Dinic(r, source, sink).run();
+	det::set_flow(result, r);
+	det::set_cut(result, r, det::residual_reach(r, source, false));
+	return result;
+}
+
+
+
+// highest-label push-relabel
+template<class G, class CAPACITY>
+auto max_flow_push_relabel(G& g, int source, int sink, CAPACITY&& capacity) {
+	namespace det = _::max_flow;
+	using Result = Max_Flow< det::Cap<G,CAPACITY>, typename std::remove_const_t<G>::H_Edge >;
+
+	DCHECK_NE(source, sink);
+	auto r = det::build(g, capacity);
+
+	Result result;
+	det::Push_Relabel pr(r);
+	result.value = pr.max_preflow(source, sink);
+	pr.preflow_to_flow(source, sink);
+	det::set_flow(result, r);
+	det::set_cut(result, r, det::residual_reach(r, source, false));
+	return result;
+}
+
+
+
+// flow value and a minimum cut, without computing the flow
+//
+// the source side is every vertex that can't reach the sink in the residual network after the first phase of
+// push-relabel (so it can differ from the cut returned by `max_flow`, which is the smallest source side)
+template<class G, class CAPACITY>
+auto min_cut(G& g, int source, int sink, CAPACITY&& capacity) {
+	namespace det = _::max_flow;
+	using Result = Min_Cut< det::Cap<G,CAPACITY>, typename std::remove_const_t<G>::H_Edge >;
+
+	DCHECK_NE(source, sink);
+	auto r = det::build(g, capacity);
+
+	Result result;
+	result.value = det::Push_Relabel(r).max_preflow(source, sink);
+
+	auto sink_side = det::residual_reach(r, sink, true);
+	sink_side.flip();
+	det::set_cut(result, r, sink_side);
+	return result;
+}
+
+
+
+} // namespace salgo::graph
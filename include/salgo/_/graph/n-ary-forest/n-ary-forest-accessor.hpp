@@ -96,7 +96,7 @@ public:
 	auto emplace_child(int ith, Args&&... args) {
 		static_assert(C == MUTAB, "called on CONST accessor");
 		DCHECK( child(ith).not_found() );
-		auto new_node = ALLOC.construct( std::forward<Args>(args)... );
+		auto new_node = ALLOC.construct_near( HANDLE, std::forward<Args>(args)... );
 		link_child(ith, new_node);
 		return child(ith);
 	}
@@ -291,6 +291,9 @@ private:
 public:
 	static_assert(Allocator::Auto_Destruct, "Rooted_Forest requires an Auto_Destruct allocator");
 
+	// read-only, e.g. for `stats()` of an `Instrumented` allocator
+	const auto& allocator() const { return _alloc(); }
+
 	bool  is_empty() const { return _alloc().is_empty(); }
 	bool not_empty() const { return !is_empty(); }
 
@@ -347,6 +350,10 @@ public:
 
 	template<int X>
 	using ALIGN        = With_Builder< Params< N_Ary, Data, Has_Child_Links, Has_Parent_Links, Supplied_Allocator, X > >;
+
+	// integer type of node links (e.g. `uint16_t` for small trees), forwarded to the allocator
+	template<class X>
+	using HANDLE_INT   = ALLOCATOR< typename Supplied_Allocator ::template HANDLE_INT<X> >;
 };
 
 
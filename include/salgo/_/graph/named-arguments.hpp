@@ -0,0 +1,17 @@
+#pragma once
+
+#include "../named-arguments.hpp"
+
+namespace salgo::graph {
+
+// named arguments local to graph algorithms
+// (cannot be re-defined)
+NAMED_ARGUMENT(ON_DISCOVER)
+NAMED_ARGUMENT(ON_FINISH)
+NAMED_ARGUMENT(ON_EDGE)
+NAMED_ARGUMENT(DIRECTION_OPTIMIZING)
+NAMED_ARGUMENT(TARGET)
+NAMED_ARGUMENT(DELTA)
+NAMED_ARGUMENT(NUM_THREADS)
+
+}
@@ -0,0 +1,331 @@
+#pragma once
+
+/*
+
+Cache-locality vertex reordering for `Graph` (and g3d meshes, see `geom/g3d/reorder-verts`).
+
+`reorder_vertices(g, strategy)` renumbers the vertex storage so that vertices visited together are
+stored together, relinks all vert-edges, and returns the permutation: `new_index[old_handle]`.
+Edge handles are unchanged. Reorder before `freeze()` - the CSR snapshot inherits the order.
+
+Strategies (edge directions are ignored):
+
+* `Vertex_Order::BFS` - breadth-first order, components in order of their smallest vertex.
+
+* `Vertex_Order::RCM` - reverse Cuthill-McKee: BFS from a pseudo-peripheral vertex, neighbours
+  by increasing degree, reversed. Minimizes bandwidth - good for meshes and road networks.
+
+* `Vertex_Order::DEGREE` - by decreasing degree: hubs (and their data) are packed together.
+  Cheap, good for power-law graphs.
+
+* `Vertex_Order::GORDER` - Gorder-lite (Wei et al.): greedily picks the vertex with the most
+  neighbours and siblings (common neighbours) among the last `Window` placed ones.
+  Siblings are only counted through vertices of degree <= `Max_Sibling_Degree`, so hubs don't
+  make it quadratic. Slowest to compute, best locality for power-law graphs.
+
+*/
+
+#include "../dynamic-array.inl"
+#include "../heap.hpp"
+
+#include <glog/logging.h>
+
+#include <algorithm> // std::sort, std::stable_sort, std::unique, std::reverse
+#include <utility> // std::pair
+#include <vector>
+
+namespace salgo::graph {
+
+
+
+enum class Vertex_Order { BFS, RCM, DEGREE, GORDER };
+
+
+
+namespace _::reorder_vertices {
+
+
+
+// symmetric adjacency lists, sorted, without duplicates and self-loops
+class Adjacency {
+	std::vector<int> _offsets;
+	std::vector<int> _targets;
+
+public:
+	// `for_each_edge(add)` should call `add(a,b)` for every edge, twice (counting, then filling)
+	template<class FOR_EACH_EDGE>
+	Adjacency(int n, FOR_EACH_EDGE&& for_each_edge) : _offsets(n+1) {
+		for_each_edge([&](int a, int b) {
+			if(a == b) return;
+			++_offsets[a+1];
+			++_offsets[b+1];
+		});
+		for(int v=0; v<n; ++v) _offsets[v+1] += _offsets[v];
+
+		_targets.resize( _offsets[n] );
+		std::vector<int> fill(_offsets.begin(), _offsets.end()-1);
+		for_each_edge([&](int a, int b) {
+			if(a == b) return;
+			_targets[ fill[a]++ ] = b;
+			_targets[ fill[b]++ ] = a;
+		});
+
+		// sort, remove duplicates, compact
+		int size = 0;
+		for(int v=0; v<n; ++v) {
+			auto b = _targets.begin() + _offsets[v];
+			auto e = _targets.begin() + _offsets[v+1];
+			std::sort(b, e);
+			e = std::unique(b, e);
+			_offsets[v] = size;
+			for(auto i = b; i != e; ++i) _targets[size++] = *i;
+		}
+		_offsets[n] = size;
+		_targets.resize(size);
+	}
+
+	int size() const { return (int)_offsets.size() - 1; }
+	int degree(int v) const { return _offsets[v+1] - _offsets[v]; }
+
+	auto begin(int v) const { return _targets.begin() + _offsets[v]; }
+	auto end(int v) const { return _targets.begin() + _offsets[v+1]; }
+};
+
+
+
+template<class G>
+Adjacency adjacency(G& g) {
+	return Adjacency(g.verts().domain(), [&](auto&& add) {
+		for(auto& vert : g.verts()) {
+			for(auto& out : vert.outs()) add( vert.handle(), out.vert().handle() );
+		}
+	});
+}
+
+
+
+// vertices sorted by (degree, handle)
+inline std::vector<int> by_degree(const Adjacency& adj) {
+	std::vector<int> result(adj.size());
+	for(int v=0; v<adj.size(); ++v) result[v] = v;
+	std::stable_sort(result.begin(), result.end(), [&](int a, int b) { return adj.degree(a) < adj.degree(b); });
+	return result;
+}
+
+
+
+inline std::vector<int> bfs_order(const Adjacency& adj) {
+	const int n = adj.size();
+	std::vector<int> order;
+	order.reserve(n);
+	std::vector<bool> placed(n);
+
+	for(int s=0; s<n; ++s) {
+		if(placed[s]) continue;
+		placed[s] = true;
+		order.push_back(s);
+		for(int i = (int)order.size() - 1; i < (int)order.size(); ++i) {
+			for(auto u = adj.begin(order[i]); u != adj.end(order[i]); ++u) {
+				if(placed[*u]) continue;
+				placed[*u] = true;
+				order.push_back(*u);
+			}
+		}
+	}
+
+	return order;
+}
+
+
+
+inline std::vector<int> rcm_order(const Adjacency& adj) {
+	const int n = adj.size();
+	std::vector<int> order;
+	order.reserve(n);
+	std::vector<bool> placed(n);
+
+	// pseudo-peripheral vertex search (George-Liu): BFS levels from `s`, restart from a
+	// min-degree vertex of the last level while the eccentricity grows
+	std::vector<int> stamp(n, -1);
+	std::vector<int> level;
+	int num_searches = 0;
+
+	auto eccentricity = [&](int s, int& last) {
+		const int id = num_searches++;
+		level.assign(1, s);
+		stamp[s] = id;
+		int ecc = 0;
+		for(;;) {
+			last = level[0];
+			for(int v : level) if(adj.degree(v) < adj.degree(last)) last = v;
+
+			std::vector<int> next;
+			for(int v : level) {
+				for(auto u = adj.begin(v); u != adj.end(v); ++u) {
+					if(stamp[*u] == id) continue;
+					stamp[*u] = id;
+					next.push_back(*u);
+				}
+			}
+			if(next.empty()) return ecc;
+			level.swap(next);
+			++ecc;
+		}
+	};
+
+	for(int s : by_degree(adj)) {
+		if(placed[s]) continue;
+
+		int last;
+		int ecc = eccentricity(s, last);
+		for(int iter=0; iter<8 && last != s; ++iter) {
+			int cand_last;
+			int cand_ecc = eccentricity(last, cand_last);
+			if(cand_ecc <= ecc) break;
+			s = last;
+			ecc = cand_ecc;
+			last = cand_last;
+		}
+
+		// Cuthill-McKee
+		placed[s] = true;
+		order.push_back(s);
+		for(int i = (int)order.size() - 1; i < (int)order.size(); ++i) {
+			const int begin = order.size();
+			for(auto u = adj.begin(order[i]); u != adj.end(order[i]); ++u) {
+				if(placed[*u]) continue;
+				placed[*u] = true;
+				order.push_back(*u);
+			}
+			std::stable_sort(order.begin() + begin, order.end(), [&](int a, int b) { return adj.degree(a) < adj.degree(b); });
+		}
+	}
+
+	std::reverse(order.begin(), order.end());
+	return order;
+}
+
+
+
+inline std::vector<int> degree_order(const Adjacency& adj) {
+	std::vector<int> order(adj.size());
+	for(int v=0; v<adj.size(); ++v) order[v] = v;
+	std::stable_sort(order.begin(), order.end(), [&](int a, int b) { return adj.degree(a) > adj.degree(b); });
+	return order;
+}
+
+
+
+constexpr int Window = 5;
+constexpr int Max_Sibling_Degree = 32;
+
+inline std::vector<int> gorder_order(const Adjacency& adj) {
+	const int n = adj.size();
+	std::vector<int> order;
+	order.reserve(n);
+	std::vector<bool> placed(n);
+
+	struct Item {
+		int score;
+		int vert;
+	};
+
+	struct Higher {
+		bool operator()(const Item& a, const Item& b) const { return a.score > b.score || (a.score == b.score && a.vert < b.vert); }
+	};
+
+	using Queue = typename Heap<Item> ::template COMPARE<Higher>;
+	Queue queue;
+	std::vector<typename Queue::Handle> where(n);
+	std::vector<int> score(n);
+
+	auto add = [&](int u, int delta) {
+		if(placed[u]) return;
+		score[u] += delta;
+		DCHECK_GE(score[u], 0);
+
+		if(!where[u].valid()) where[u] = queue.push( Item{score[u], u} ).handle();
+		else if(score[u] > 0) queue.update( where[u], Item{score[u], u} );
+		else {
+			queue.erase( where[u] );
+			where[u] = typename Queue::Handle();
+		}
+	};
+
+	// neighbours of `v`, and siblings through low-degree common neighbours
+	auto touch = [&](int v, int delta) {
+		for(auto u = adj.begin(v); u != adj.end(v); ++u) {
+			add(*u, delta);
+			if(adj.degree(*u) > Max_Sibling_Degree) continue;
+			for(auto x = adj.begin(*u); x != adj.end(*u); ++x) add(*x, delta);
+		}
+	};
+
+	auto place = [&](int v) {
+		placed[v] = true;
+		if(where[v].valid()) {
+			queue.erase( where[v] );
+			where[v] = typename Queue::Handle();
+		}
+		order.push_back(v);
+
+		touch(v, +1);
+		if((int)order.size() > Window) touch( order[ order.size() - 1 - Window ], -1 );
+	};
+
+	auto hubs = degree_order(adj);
+	int next_hub = 0;
+
+	while((int)order.size() < n) {
+		if(queue.not_empty()) place( queue.top().vert );
+		else {
+			while(placed[ hubs[next_hub] ]) ++next_hub;
+			place( hubs[next_hub] );
+		}
+	}
+
+	return order;
+}
+
+
+
+inline std::vector<int> order(const Adjacency& adj, Vertex_Order strategy) {
+	switch(strategy) {
+		case Vertex_Order::BFS: return bfs_order(adj);
+		case Vertex_Order::RCM: return rcm_order(adj);
+		case Vertex_Order::DEGREE: return degree_order(adj);
+		case Vertex_Order::GORDER: return gorder_order(adj);
+	}
+	DCHECK(false) << "unknown Vertex_Order";
+	return {};
+}
+
+
+
+// `order[i]` is the old vertex moved to position `i`
+inline salgo::Dynamic_Array<int> new_index(const std::vector<int>& order) {
+	salgo::Dynamic_Array<int> result( (int)order.size() );
+	for(int i=0; i<(int)order.size(); ++i) result[ order[i] ] = i;
+	return result;
+}
+
+
+
+} // namespace _::reorder_vertices
+
+
+
+
+
+// returns `new_index[old_handle]`
+template<class G>
+auto reorder_vertices(G& g, Vertex_Order strategy) {
+	namespace det = _::reorder_vertices;
+	auto new_index = det::new_index( det::order( det::adjacency(g), strategy ) );
+	g.permute_verts(new_index);
+	return new_index;
+}
+
+
+
+} // namespace salgo::graph
@@ -0,0 +1,461 @@
+#pragma once
+
+/*
+
+Single-source shortest paths over `Graph` and `Csr_Graph`, with non-negative edge weights.
+
+`weight(out)` is called with an out-edge accessor, e.g. `[](auto& out){ return out.edge().data(); }`.
+Its return type is the distance type.
+
+* `shortest_paths` - Dijkstra with `salgo::Heap` and decrease_key
+* `shortest_paths_radix` - Dijkstra with a radix heap, for integer weights
+* `shortest_paths_delta_stepping` - multi-threaded delta-stepping (Meyer, Sanders)
+
+Named arguments:
+	TARGET = v - stop when `v` is settled; only distances of vertices settled before are final
+	DELTA = d - bucket width for delta-stepping (default: average edge weight)
+	NUM_THREADS = n - for delta-stepping (default: hardware concurrency)
+
+*/
+
+#include "named-arguments.hpp"
+#include "../heap.hpp"
+#include "../dynamic-array.inl"
+
+#include <glog/logging.h>
+
+#include <algorithm> // std::min, std::max
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <limits>
+#include <memory> // std::unique_ptr
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility> // std::pair, std::swap
+#include <vector>
+
+namespace salgo::graph {
+
+
+
+// tables indexed by vertex handle
+template<class DIST, class H_VERT>
+struct Shortest_Paths {
+	using Dist = DIST;
+	using H_Vert = H_VERT;
+
+	static constexpr Dist Infinity = std::numeric_limits<Dist>::max();
+
+	salgo::Dynamic_Array<Dist> dist; // `Infinity` if not reached
+	salgo::Dynamic_Array<H_Vert> parent; // invalid for the source and not reached vertices
+
+	bool reached(int v) const { return dist[v] != Infinity; }
+
+	// vertices from the source to `v`, empty if not reached
+	std::vector<H_Vert> path(int v) const {
+		std::vector<H_Vert> result;
+		if(!reached(v)) return result;
+
+		for(H_Vert x(v); x.valid(); x = parent[x]) result.emplace_back(x);
+		std::reverse(result.begin(), result.end());
+		return result;
+	}
+};
+
+
+
+namespace _::shortest_paths {
+
+
+
+template<class G, class WEIGHT>
+using Dist = std::decay_t<decltype( std::declval<WEIGHT&>()( *std::declval<G&>().vert(0).outs().begin() ) )>;
+
+template<class G, class WEIGHT>
+auto init(G& g, int source) {
+	using H_Vert = typename std::remove_const_t<G>::H_Vert;
+	using Result = Shortest_Paths<Dist<G,WEIGHT>, H_Vert>;
+
+	const int domain = g.verts().domain();
+	DCHECK_GE(source, 0);
+	DCHECK_LT(source, domain);
+
+	Result result;
+	result.dist.resize(domain, Result::Infinity);
+	result.parent.resize(domain);
+	result.dist[source] = 0;
+	return result;
+}
+
+
+
+// monotone priority queue for unsigned integer keys: every key pushed must be >= the last popped one
+//
+// an element is in bucket `i` if its key differs from the last popped key first at bit `i-1`
+// (bucket 0: equal keys), so each element is moved at most (bits) times
+template<class KEY>
+class Radix_Heap {
+	static_assert(std::is_integral_v<KEY>, "radix heap requires integer keys");
+	using U = std::make_unsigned_t<KEY>;
+	static constexpr int Bits = sizeof(U) * 8;
+
+	std::array<std::vector<std::pair<KEY,int>>, Bits + 1> _buckets;
+	U _last = 0;
+	int _count = 0;
+
+	static int _bucket(U key, U last) {
+		if(key == last) return 0;
+		return 64 - __builtin_clzll( (unsigned long long)(key ^ last) );
+	}
+
+public:
+	bool is_empty() const { return _count == 0; }
+
+	void push(KEY key, int val) {
+		DCHECK_GE(key, 0) << "radix heap requires non-negative keys";
+		DCHECK_GE((U)key, _last) << "radix heap is monotone";
+		_buckets[ _bucket(key, _last) ].emplace_back(key, val);
+		++_count;
+	}
+
+	std::pair<KEY,int> pop() {
+		DCHECK(!is_empty());
+
+		if(_buckets[0].empty()) {
+			int i = 1;
+			while(_buckets[i].empty()) ++i;
+
+			U new_last = std::numeric_limits<U>::max();
+			for(auto& e : _buckets[i]) new_last = std::min(new_last, (U)e.first);
+			_last = new_last;
+
+			for(auto& e : _buckets[i]) _buckets[ _bucket(e.first, _last) ].emplace_back(e);
+			_buckets[i].clear();
+		}
+
+		--_count;
+		auto result = _buckets[0].back();
+		_buckets[0].pop_back();
+		return result;
+	}
+};
+
+
+
+class Barrier {
+	std::mutex _mutex;
+	std::condition_variable _cv;
+	const int _count;
+	int _waiting = 0;
+	unsigned int _generation = 0;
+
+public:
+	explicit Barrier(int count) : _count(count) {}
+
+	void wait() {
+		std::unique_lock<std::mutex> lock(_mutex);
+		auto generation = _generation;
+		if(++_waiting == _count) {
+			_waiting = 0;
+			++_generation;
+			_cv.notify_all();
+		}
+		else _cv.wait(lock, [&]{ return generation != _generation; });
+	}
+};
+
+
+
+// relax `dist[u]` to `d`, returns true if it was improved
+template<class DIST>
+bool atomic_min(std::atomic<DIST>& dist, DIST d) {
+	DIST old = dist.load(std::memory_order_relaxed);
+	while(d < old) {
+		if(dist.compare_exchange_weak(old, d, std::memory_order_relaxed)) return true;
+	}
+	return false;
+}
+
+
+
+} // namespace _::shortest_paths
+
+
+
+
+
+
+
+
+template<class G, class WEIGHT, class... ARGS>
+auto shortest_paths(G& g, int source, WEIGHT&& weight, ARGS&&... _args) {
+	namespace det = _::shortest_paths;
+	using Dist = det::Dist<G,WEIGHT>;
+	using H_Vert = typename std::remove_const_t<G>::H_Vert;
+
+	auto args = Named_Arguments( std::forward<ARGS>(_args)... );
+	const int target = args(TARGET, -1);
+
+	auto result = det::init<G,WEIGHT>(g, source);
+	auto& dist = result.dist;
+
+	struct Item {
+		Dist dist;
+		int vert;
+	};
+
+	struct Closer {
+		bool operator()(const Item& a, const Item& b) const { return a.dist < b.dist; }
+	};
+
+	using Queue = typename Heap<Item> ::template COMPARE<Closer>;
+	Queue queue;
+	std::vector<typename Queue::Handle> where( dist.domain() );
+
+	where[source] = queue.push( Item{0, source} ).handle();
+
+	while(queue.not_empty()) {
+		int v = queue.top().vert;
+		queue.pop();
+		if(v == target) break;
+
+		for(auto& out : g.vert(v).outs()) {
+			Dist w = weight(out);
+			DCHECK_GE(w, 0) << "negative edge weight";
+
+			int u = out.vert().handle();
+			Dist d = dist[v] + w;
+			if(!(d < dist[u])) continue;
+
+			bool queued = dist[u] != result.Infinity;
+			dist[u] = d;
+			result.parent[u] = H_Vert(v);
+
+			// settled vertices are never improved, so `where[u]` is valid
+			if(queued) queue.decrease_key( where[u], Item{d, u} );
+			else where[u] = queue.push( Item{d, u} ).handle();
+		}
+	}
+
+	return result;
+}
+
+
+
+
+// Dijkstra with a radix heap, for integer weights
+template<class G, class WEIGHT, class... ARGS>
+auto shortest_paths_radix(G& g, int source, WEIGHT&& weight, ARGS&&... _args) {
+	namespace det = _::shortest_paths;
+	using Dist = det::Dist<G,WEIGHT>;
+	using H_Vert = typename std::remove_const_t<G>::H_Vert;
+
+	static_assert(std::is_integral_v<Dist>, "shortest_paths_radix() requires integer weights");
+
+	auto args = Named_Arguments( std::forward<ARGS>(_args)... );
+	const int target = args(TARGET, -1);
+
+	auto result = det::init<G,WEIGHT>(g, source);
+	auto& dist = result.dist;
+
+	// vertices can be in the queue many times, only the entry with the current distance counts
+	det::Radix_Heap<Dist> queue;
+	queue.push(0, source);
+
+	while(!queue.is_empty()) {
+		auto [dv, v] = queue.pop();
+		if(dv != dist[v]) continue;
+		if(v == target) break;
+
+		for(auto& out : g.vert(v).outs()) {
+			Dist w = weight(out);
+			DCHECK_GE(w, 0) << "negative edge weight";
+
+			int u = out.vert().handle();
+			Dist d = dv + w;
+			if(!(d < dist[u])) continue;
+
+			dist[u] = d;
+			result.parent[u] = H_Vert(v);
+			queue.push(d, u);
+		}
+	}
+
+	return result;
+}
+
+
+
+
+// multi-threaded delta-stepping
+//
+// vertices are kept in buckets of width DELTA; a bucket is emptied by relaxing light edges (weight <= DELTA)
+// repeatedly, then heavy edges of all vertices removed from it are relaxed once
+//
+// `weight` is called concurrently
+//
+// parents are reconstructed at the end, by a search from the source along tight edges
+// (`dist[v] + w == dist[u]`), so they form a tree even with zero-weight cycles
+template<class G, class WEIGHT, class... ARGS>
+auto shortest_paths_delta_stepping(G& g, int source, WEIGHT&& weight, ARGS&&... _args) {
+	namespace det = _::shortest_paths;
+	using Dist = det::Dist<G,WEIGHT>;
+	using H_Vert = typename std::remove_const_t<G>::H_Vert;
+
+	auto args = Named_Arguments( std::forward<ARGS>(_args)... );
+	const int target = args(TARGET, -1);
+
+	auto result = det::init<G,WEIGHT>(g, source);
+	const int domain = result.dist.domain();
+	const Dist Infinity = result.Infinity;
+
+	Dist delta = args(DELTA, Dist(0));
+	if(!(delta > 0)) {
+		Dist sum = 0;
+		long long num_outs = 0;
+		for(auto& vert : g.verts()) {
+			for(auto& out : vert.outs()) {
+				sum += weight(out);
+				++num_outs;
+			}
+		}
+		if(num_outs) delta = sum / num_outs;
+		if(!(delta > 0)) delta = 1;
+	}
+
+	static constexpr int Min_Verts_Per_Thread = 1<<12;
+	int num_threads = args(NUM_THREADS, (int)std::thread::hardware_concurrency());
+	num_threads = std::max(1, std::min(num_threads, domain / Min_Verts_Per_Thread));
+
+	std::unique_ptr<std::atomic<Dist>[]> dist( new std::atomic<Dist>[domain] );
+	for(int i=0; i<domain; ++i) dist[i].store(Infinity, std::memory_order_relaxed);
+	dist[source].store(0, std::memory_order_relaxed);
+
+	auto bucket_of = [&](Dist d) { return (int)(d / delta); };
+
+
+	//
+	// shared state, modified only by `schedule()` (between barriers)
+	//
+	enum class Phase { LIGHT, HEAVY, DONE };
+	Phase phase = Phase::LIGHT;
+
+	std::vector<std::vector<int>> buckets(1, {source});
+	int current = 0;
+
+	std::vector<int> frontier; // vertices to relax in this phase
+	std::vector<int> removed; // removed from the current bucket, for the heavy phase
+	std::vector<Dist> relaxed_at( domain, Infinity ); // distance when vertex was last relaxed (light)
+	std::vector<int> removed_in( domain, -1 ); // bucket
+
+	std::vector<std::vector<int>> improved( num_threads ); // per thread
+
+	auto schedule = [&]() {
+		for(auto& list : improved) {
+			for(int u : list) {
+				int b = bucket_of( dist[u].load(std::memory_order_relaxed) );
+				if(b >= (int)buckets.size()) buckets.resize(b+1);
+				buckets[b].emplace_back(u);
+			}
+			list.clear();
+		}
+
+		for(;;) {
+			// light phases, until the current bucket is empty
+			if(current < (int)buckets.size() && !buckets[current].empty()) {
+				frontier.clear();
+				for(int v : buckets[current]) {
+					Dist d = dist[v].load(std::memory_order_relaxed);
+					if(bucket_of(d) != current || !(d < relaxed_at[v])) continue; // moved, or duplicate
+					relaxed_at[v] = d;
+					frontier.emplace_back(v);
+
+					if(removed_in[v] != current) {
+						removed_in[v] = current;
+						removed.emplace_back(v);
+					}
+				}
+				buckets[current].clear();
+
+				if(!frontier.empty()) { phase = Phase::LIGHT; return; }
+				continue;
+			}
+
+			// then one heavy phase
+			if(!removed.empty()) {
+				frontier.swap(removed);
+				removed.clear();
+				phase = Phase::HEAVY;
+				return;
+			}
+
+			// next non-empty bucket
+			++current;
+			while(current < (int)buckets.size() && buckets[current].empty()) ++current;
+
+			bool target_settled = target != -1 && bucket_of( dist[target].load(std::memory_order_relaxed) ) < current;
+			if(current >= (int)buckets.size() || target_settled) { phase = Phase::DONE; return; }
+		}
+	};
+
+
+	det::Barrier barrier(num_threads);
+
+	auto worker = [&](int thread) {
+		for(;;) {
+			barrier.wait();
+			if(phase == Phase::DONE) return;
+
+			const bool light = phase == Phase::LIGHT;
+			auto& my_improved = improved[thread];
+
+			for(int i = thread; i < (int)frontier.size(); i += num_threads) {
+				int v = frontier[i];
+				Dist dv = dist[v].load(std::memory_order_relaxed);
+
+				for(auto& out : g.vert(v).outs()) {
+					Dist w = weight(out);
+					DCHECK_GE(w, 0) << "negative edge weight";
+					if(light != (w <= delta)) continue;
+
+					int u = out.vert().handle();
+					if(det::atomic_min(dist[u], dv + w)) my_improved.emplace_back(u);
+				}
+			}
+
+			barrier.wait();
+			if(thread == 0) schedule();
+		}
+	};
+
+	schedule();
+
+	std::vector<std::thread> threads;
+	for(int t=1; t<num_threads; ++t) threads.emplace_back(worker, t);
+	worker(0);
+	for(auto& t : threads) t.join();
+
+
+	for(int v=0; v<domain; ++v) result.dist[v] = dist[v].load(std::memory_order_relaxed);
+
+	// each vertex takes its parent from the already connected ones
+	std::vector<int> queue(1, source);
+	for(int i=0; i<(int)queue.size(); ++i) {
+		int v = queue[i];
+		for(auto& out : g.vert(v).outs()) {
+			int u = out.vert().handle();
+			if(u == source || result.parent[u].valid()) continue;
+			if(result.dist[v] + weight(out) != result.dist[u]) continue;
+			result.parent[u] = H_Vert(v);
+			queue.emplace_back(u);
+		}
+	}
+
+	return result;
+}
+
+
+
+} // namespace salgo::graph
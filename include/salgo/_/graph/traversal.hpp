@@ -0,0 +1,312 @@
+#pragma once
+
+/*
+
+Iterative BFS and DFS over `Graph` and `Csr_Graph` (from `Graph::freeze()`).
+
+No recursion, so deep graphs (e.g. long paths) don't overflow the stack.
+
+Callbacks are optional named arguments. Each is called with up to 3 arguments - as many as it accepts:
+	ON_DISCOVER(vert, parent, depth) - `parent` is an invalid handle for the source
+	ON_FINISH(vert, parent, depth)
+	ON_EDGE(vert, out, depth) - `out` is the out-edge accessor; for every examined edge, also non-tree ones
+
+A callback can return BREAK (or CONTINUE) to stop the traversal early.
+
+
+BFS is direction-optimizing (Beamer et al.): when the frontier gets large, instead of scanning frontier's out-edges
+("top-down"), every unvisited vertex scans its in-edges until it finds a parent in the frontier ("bottom-up").
+
+* Needs in-edges: undirected graph, or ::DIRECTED ::BACKLINKS.
+* Not used with ON_EDGE, because bottom-up steps skip edges.
+* Can be disabled with DIRECTION_OPTIMIZING=false.
+
+Depths (and BFS layers) are the same either way, but order of discovery and parents inside a layer can differ.
+
+*/
+
+#include "named-arguments.hpp"
+#include "../iteration-callback.hpp"
+#include "../has-member.hpp"
+
+#include <glog/logging.h>
+
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace salgo::graph::_::traversal {
+
+
+
+// plain bitset, one bit per vertex
+class Bitset {
+	std::vector<uint64_t> _words;
+
+public:
+	Bitset(int size = 0) : _words( (size + 63) / 64 ) {}
+
+	bool operator[](int i) const { return _words[i >> 6] & (1ULL << (i & 63)); }
+
+	void set(int i) { _words[i >> 6] |= 1ULL << (i & 63); }
+	void clear(int i) { _words[i >> 6] &= ~(1ULL << (i & 63)); }
+
+	void clear() { for(auto& w : _words) w = 0; }
+};
+
+
+
+
+// call `f` with as many leading arguments as it accepts
+// returns false if `f` returned BREAK
+template<class F, class... XS>
+bool _invoke(F&& f, XS&&... xs) {
+	if constexpr(std::is_same_v<std::invoke_result_t<F, XS...>, Iteration_Callback_Result>) {
+		auto r = f( std::forward<XS>(xs)... );
+		DCHECK(r == CONTINUE || r == BREAK) << "make sure you return value in every path of the callback";
+		return r == CONTINUE;
+	}
+	else {
+		f( std::forward<XS>(xs)... );
+		return true;
+	}
+}
+
+template<class F, class A, class B, class C>
+bool callback(F&& f, A&& a, B&& b, C&& c) {
+	if constexpr(std::is_invocable_v<F, A, B, C>) return _invoke(f, std::forward<A>(a), std::forward<B>(b), std::forward<C>(c));
+	else if constexpr(std::is_invocable_v<F, A, B>) return _invoke(f, std::forward<A>(a), std::forward<B>(b));
+	else return _invoke(f, std::forward<A>(a));
+}
+
+
+
+
+SALGO_GENERATE_HAS_MEMBER(out_offsets)
+
+// number of out-edge slots (each undirected edge counts twice)
+template<class G>
+long long num_outs(G& g) {
+	if constexpr(has_member__out_offsets<std::remove_const_t<G>>) {
+		return g.out_offsets()[ g.verts().domain() ]; // Csr_Graph
+	}
+	else {
+		long long result = 0;
+		for(auto& v : g.verts()) result += v.outs().count();
+		return result;
+	}
+}
+
+
+
+template<class G>
+static constexpr bool Has_In_Edges = !G::Directed || G::Backlinks;
+
+template<class G>
+auto in_edges(G& g, int v) {
+	if constexpr(G::Directed) return g.vert(v).ins();
+	else return g.vert(v).outs();
+}
+
+
+
+} // namespace salgo::graph::_::traversal
+
+
+
+
+
+
+
+
+namespace salgo::graph {
+
+
+
+// returns the number of visited vertices
+template<class G, class... ARGS>
+int bfs(G& g, int source, ARGS&&... _args) {
+	namespace det = _::traversal;
+	using GG = std::remove_const_t<G>;
+	using H_Vert = typename GG::H_Vert;
+
+	auto args = Named_Arguments( std::forward<ARGS>(_args)... );
+
+	// switch to bottom-up when frontier's edges > unexplored edges / Alpha
+	// switch back when frontier's verts < all verts / Beta
+	static constexpr int Alpha = 14;
+	static constexpr int Beta = 24;
+
+	constexpr bool Has_On_Discover = args.has(ON_DISCOVER);
+	constexpr bool Has_On_Finish = args.has(ON_FINISH);
+
+	constexpr bool Can_Bottom_Up = det::Has_In_Edges<GG> && !args.has(ON_EDGE);
+	const bool direction_optimizing = Can_Bottom_Up && args(DIRECTION_OPTIMIZING, true);
+
+	const int domain = g.verts().domain();
+	DCHECK_GE(source, 0);
+	DCHECK_LT(source, domain);
+
+	det::Bitset visited(domain);
+	det::Bitset frontier; // bottom-up only
+	if(direction_optimizing) frontier = det::Bitset(domain);
+
+	std::vector<int> queue; // all discovered vertices, layer after layer
+	std::vector<H_Vert> parents; // ON_FINISH only
+
+	long long edges_to_check = direction_optimizing ? det::num_outs(g) : 0;
+	long long frontier_edges = 0; // of the next layer
+
+	auto discover = [&](int v, H_Vert parent, int depth) {
+		visited.set(v);
+		queue.emplace_back(v);
+		if(direction_optimizing) frontier_edges += g.vert(v).outs().count();
+		if constexpr(Has_On_Finish) parents.emplace_back(parent);
+		if constexpr(Has_On_Discover) return det::callback(args(ON_DISCOVER), H_Vert(v), parent, depth);
+		else return true;
+	};
+
+	if(!discover(source, H_Vert(), 0)) return queue.size();
+
+	bool bottom_up = false;
+	int layer_begin = 0;
+
+	for(int depth = 0; layer_begin < (int)queue.size(); ++depth) {
+		const int layer_end = queue.size();
+
+		if(direction_optimizing) {
+			// a bottom-up step scans all vertices, so the frontier must be big in both cases
+			// (near the end of a high-diameter graph, frontier's edges can be many of the few unexplored ones)
+			edges_to_check -= frontier_edges;
+			bool big_frontier = (long long)(layer_end - layer_begin) * Beta >= domain;
+			if(!bottom_up) bottom_up = big_frontier && frontier_edges > edges_to_check / Alpha;
+			else bottom_up = big_frontier;
+			frontier_edges = 0;
+		}
+
+		if constexpr(Can_Bottom_Up) if(bottom_up) {
+			frontier.clear();
+			for(int i=layer_begin; i<layer_end; ++i) frontier.set( queue[i] );
+
+			for(auto& vert : g.verts()) {
+				int v = vert.handle();
+				if(visited[v]) continue;
+
+				for(auto& in : det::in_edges(g, v)) {
+					int u = in.vert().handle();
+					if(!frontier[u]) continue;
+
+					if(!discover(v, H_Vert(u), depth+1)) return queue.size();
+					break;
+				}
+			}
+		}
+
+		if(!bottom_up) {
+			for(int i=layer_begin; i<layer_end; ++i) {
+				int v = queue[i];
+
+				for(auto& out : g.vert(v).outs()) {
+					if constexpr(args.has(ON_EDGE)) {
+						if(!det::callback(args(ON_EDGE), H_Vert(v), out, depth)) return queue.size();
+					}
+
+					int u = out.vert().handle();
+					if(visited[u]) continue;
+
+					if(!discover(u, H_Vert(v), depth+1)) return queue.size();
+				}
+			}
+		}
+
+		if constexpr(Has_On_Finish) {
+			for(int i=layer_begin; i<layer_end; ++i) {
+				if(!det::callback(args(ON_FINISH), H_Vert(queue[i]), parents[i], depth)) return queue.size();
+			}
+		}
+
+		layer_begin = layer_end;
+	}
+
+	return queue.size();
+}
+
+
+
+
+// returns the number of visited vertices
+template<class G, class... ARGS>
+int dfs(G& g, int source, ARGS&&... _args) {
+	namespace det = _::traversal;
+	using GG = std::remove_const_t<G>;
+	using H_Vert = typename GG::H_Vert;
+
+	auto args = Named_Arguments( std::forward<ARGS>(_args)... );
+
+	constexpr bool Has_On_Discover = args.has(ON_DISCOVER);
+
+	const int domain = g.verts().domain();
+	DCHECK_GE(source, 0);
+	DCHECK_LT(source, domain);
+
+	det::Bitset visited(domain);
+	int num_visited = 0;
+
+	using Outs = decltype( g.vert(source).outs() );
+
+	struct Frame {
+		int vert;
+		decltype( std::declval<Outs>().begin() ) iter;
+		decltype( std::declval<Outs>().end() ) end;
+	};
+
+	std::vector<Frame> stack;
+
+	auto discover = [&](int v, H_Vert parent) {
+		visited.set(v);
+		++num_visited;
+
+		auto outs = g.vert(v).outs();
+		stack.push_back( Frame{ v, outs.begin(), outs.end() } );
+
+		if constexpr(Has_On_Discover) return det::callback(args(ON_DISCOVER), H_Vert(v), parent, (int)stack.size()-1);
+		else return true;
+	};
+
+	if(!discover(source, H_Vert())) return num_visited;
+
+	while(!stack.empty()) {
+		auto& frame = stack.back();
+
+		if(frame.iter != frame.end) {
+			auto&& out = *frame.iter;
+			int v = frame.vert;
+			int depth = stack.size() - 1;
+
+			if constexpr(args.has(ON_EDGE)) {
+				if(!det::callback(args(ON_EDGE), H_Vert(v), out, depth)) return num_visited;
+			}
+
+			int u = out.vert().handle();
+			++frame.iter; // before `discover`, it can reallocate the stack
+
+			if(!visited[u]) {
+				if(!discover(u, H_Vert(v))) return num_visited;
+			}
+		}
+		else {
+			if constexpr(args.has(ON_FINISH)) {
+				int depth = stack.size() - 1;
+				H_Vert parent = depth ? H_Vert(stack[depth-1].vert) : H_Vert();
+				if(!det::callback(args(ON_FINISH), H_Vert(frame.vert), parent, depth)) return num_visited;
+			}
+			stack.pop_back();
+		}
+	}
+
+	return num_visited;
+}
+
+
+
+} // namespace salgo::graph
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "alloc/array-allocator.hpp"
+#include "alloc/pmr-allocator.hpp" // ::PMR
 #include "hash.hpp"
 #include "const-flag.hpp"
 
@@ -11,6 +11,7 @@
 #include "key-val.hpp"
 
 #include "type-traits.hpp"
+#include "has-member.hpp"
 
 #include "helper-macros-on.inc"
 
@@ -19,6 +20,8 @@ namespace salgo::_::hash_table {
 
 // ADD_MEMBER(cached_key);
 
+SALGO_GENERATE_HAS_MEMBER(Is_Monotonic);
+
 
 //
 // accessor
@@ -73,6 +76,13 @@ struct Params {
 
 	using Rebound_Allocator = typename Supplied_Allocator ::template VAL<Key_Val>;
 
+	// external elements are reclaimed by the allocator all at once - no need to destruct trivial ones
+	static constexpr bool Skip_Destruct = [](){
+		if constexpr(Inplace) return false;
+		else if constexpr(has_member__Is_Monotonic<Rebound_Allocator>) return Rebound_Allocator::Is_Monotonic && std::is_trivially_destructible_v<Key_Val>;
+		else return false;
+	}();
+
 	using Node = std::conditional_t<
 		Inplace,
 		Key_Val,
@@ -246,7 +256,7 @@ public:
 
 	// variadic template constructor - an alternative to initializer_list that works with move-only types
 	template<class... LIST,
-		class = std::enable_if_t< is_constructible_from_all<Key_Val, LIST...>::value >
+		class = std::enable_if_t< is_constructible_from_all<Key_Val, LIST...>::value && !std::is_constructible_v<Rebound_Allocator, LIST...> >
 	>
 	Hash_Table(LIST&&... list) : _buckets( sizeof...(list) ) {
 		_list_init( std::forward<LIST>(list)... );
@@ -262,7 +272,7 @@ private:
 
 public:
 	~Hash_Table() {
-		if constexpr(!P::Inplace) {
+		if constexpr(!P::Inplace && !P::Skip_Destruct) {
 			for(auto e : *this) {
 				auto handle = e.handle();
 				_alloc()( _buckets[handle.a][handle.b] ).destruct();
@@ -270,6 +280,9 @@ public:
 		}
 	}
 
+	// e.g. `std::pmr::memory_resource*` for `::PMR`
+	explicit Hash_Table(const Rebound_Allocator& alloc) : Rebound_Allocator(alloc) {}
+
 	Hash_Table(const Hash_Table&) = default;
 	Hash_Table(Hash_Table&&) = default;
 
@@ -289,6 +302,10 @@ private:
 	auto& _alloc()       { return *static_cast<      Rebound_Allocator*>(this); }
 	auto& _alloc() const { return *static_cast<const Rebound_Allocator*>(this); }
 
+public:
+	// read-only, e.g. for `stats()` of an `Instrumented` allocator
+	const auto& allocator() const { return _alloc(); }
+
 	//
 	// interface: manipulate element - can be accessed via the Accessor
 	//
@@ -540,6 +557,9 @@ public:
 	using ALLOCATOR = With_Builder< Params<Key, Val, Hash, NEW_ALLOCATOR, Inplace>>;
 
 	using EXTERNAL = With_Builder< Params<Key, Val, Hash, Supplied_Allocator, false>>;
+
+	// elements are allocated from a `std::pmr::memory_resource` given on construction (implies ::EXTERNAL)
+	using PMR = With_Builder< Params<Key, Val, Hash, salgo::Pmr_Allocator<int>, false>>;
 };
 
 } // namespace salgo::_::hash_table
@@ -0,0 +1,394 @@
+#pragma once
+
+/*
+
+Addressable d-ary heap.
+
+Values are kept in a single array in heap order, together with their slot numbers.
+Handles are slots - they stay valid while the value moves inside the array.
+
+With `std::less` (default) the top is the smallest value. Use ::COMPARE<std::greater<>> for a max-heap.
+
+4-ary by default: the tree is half as deep as a binary one, and the 4 children usually share a cache line.
+
+*/
+
+#include "const-flag.hpp"
+#include "accessors.hpp"
+#include "handles.hpp"
+#include "subscript-tags.hpp"
+#include "iterable-base.inl"
+
+#include <glog/logging.h>
+
+#include <functional> // std::less
+#include <utility> // std::forward, std::move
+#include <vector>
+
+#include "helper-macros-on.inc"
+
+namespace salgo::_::heap {
+
+
+
+// slot index
+//
+// parametrized by unused context X, to make Handles from different Contexts incompatible
+template<class X>
+struct Handle : Int_Handle_Base<Handle<X>, int> {
+	using BASE = Int_Handle_Base<Handle<X>, int>;
+
+	Handle() = default;
+	explicit Handle(int i) : BASE(i) {}
+};
+
+
+
+
+template<
+	class _VAL,
+	class _CMP,
+	int _ARITY
+>
+struct Context {
+
+	//
+	// forward declarations
+	//
+	template<Const_Flag C> class Accessor;
+	template<Const_Flag C> class Iterator;
+	class Heap;
+	using Container = Heap;
+
+	struct End_Iterator {};
+
+
+
+	//
+	// template arguments
+	//
+	using Val = _VAL;
+	using Compare = _CMP;
+	static constexpr int Arity = _ARITY;
+
+	static_assert(Arity >= 2, "heap arity must be at least 2");
+
+
+	using       Handle = heap::Handle<Context>;
+	using Handle_Small = Handle;
+
+
+	struct Node {
+		Val val;
+		int slot;
+	};
+
+
+
+
+	//
+	// accessor
+	//
+	template<Const_Flag C>
+	class Accessor : public Accessor_Base<C,Context> {
+		using BASE = Accessor_Base<C,Context>;
+
+	public:
+		using BASE::BASE;
+
+		void erase() {
+			static_assert(C == MUTAB, "called erase() on CONST accessor");
+			CONT.erase( HANDLE );
+		}
+
+		// assign a new value (or keep the value modified through this accessor), and restore heap order
+		template<class... ARGS>
+		void update(ARGS&&... args) {
+			static_assert(C == MUTAB, "called update() on CONST accessor");
+			CONT.update( HANDLE, std::forward<ARGS>(args)... );
+		}
+
+		// same as `update()`, but the value can only move towards the top
+		template<class... ARGS>
+		void decrease_key(ARGS&&... args) {
+			static_assert(C == MUTAB, "called decrease_key() on CONST accessor");
+			CONT.decrease_key( HANDLE, std::forward<ARGS>(args)... );
+		}
+	};
+
+
+
+
+	//
+	// iterator: array order (not sorted)
+	//
+	template<Const_Flag C>
+	class Iterator : public Iterator_Base<C,Context> {
+		using BASE = Iterator_Base<C,Context>;
+
+	public:
+		using BASE::BASE;
+
+	private:
+		friend Iterator_Base<C,Context>;
+
+		void _increment() { MUT_HANDLE = CONT._handle_at( CONT._pos[HANDLE] + 1 ); }
+		void _decrement() { MUT_HANDLE = CONT._handle_at( CONT._pos[HANDLE] - 1 ); }
+
+	public:
+		bool operator!=(End_Iterator) const { return HANDLE.valid(); }
+	};
+
+
+
+
+
+	class Heap : public Iterable_Base<Heap>, private Compare {
+	public:
+		using Val = Context::Val;
+		using       Handle = Context::      Handle;
+		using Handle_Small = Context::Handle_Small;
+
+		template<Const_Flag C> using Accessor = Context::Accessor<C>;
+		template<Const_Flag C> using Iterator = Context::Iterator<C>;
+
+	private:
+		friend Iterator<MUTAB>;
+		friend Iterator<CONST>;
+
+
+		//
+		// data
+		//
+	private:
+		std::vector<Node> _nodes; // heap order
+		std::vector<int> _pos; // position of each slot in `_nodes`, or the next free slot
+
+		int _free_head = -1;
+
+
+		//
+		// construction
+		//
+	public:
+		Heap() = default;
+		explicit Heap(const Compare& compare) : Compare(compare) {}
+
+
+
+		//
+		// element access
+		//
+	public:
+		// modifying the value requires `update(handle)` afterwards
+		auto& operator[](Handle handle)       { return _nodes[ _pos_of(handle) ].val; }
+		auto& operator[](Handle handle) const { return _nodes[ _pos_of(handle) ].val; }
+
+		auto operator()(Handle handle)       { _pos_of(handle); return Accessor<MUTAB>(this, handle); }
+		auto operator()(Handle handle) const { _pos_of(handle); return Accessor<CONST>(this, handle); }
+
+		// top
+		auto operator()(First_Tag)       { DCHECK(not_empty()); return Accessor<MUTAB>(this, _handle_at(0)); }
+		auto operator()(First_Tag) const { DCHECK(not_empty()); return Accessor<CONST>(this, _handle_at(0)); }
+
+		auto& operator[](First_Tag)       { DCHECK(not_empty()); return _nodes[0].val; }
+		auto& operator[](First_Tag) const { DCHECK(not_empty()); return _nodes[0].val; }
+
+		const Val& top() const { DCHECK(not_empty()); return _nodes[0].val; }
+
+
+
+		//
+		// modifiers
+		//
+	public:
+		template<class... ARGS>
+		auto emplace(ARGS&&... args) {
+			int slot = _free_head;
+			if(slot != -1) _free_head = _pos[slot];
+			else {
+				slot = _pos.size();
+				_pos.emplace_back();
+			}
+
+			_nodes.push_back( Node{ Val( std::forward<ARGS>(args)... ), slot } );
+			_pos[slot] = _nodes.size() - 1;
+			_sift_up( _nodes.size() - 1 );
+
+			return Accessor<MUTAB>(this, Handle(slot));
+		}
+
+		template<class... ARGS>
+		auto push(ARGS&&... args) { return emplace( std::forward<ARGS>(args)... ); } // alias
+
+
+		void pop() {
+			DCHECK(not_empty()) << "pop() on empty heap";
+			_erase_at(0);
+		}
+
+		void erase(Handle handle) { _erase_at( _pos_of(handle) ); }
+
+
+		template<class... ARGS>
+		void update(Handle handle, ARGS&&... args) {
+			int pos = _pos_of(handle);
+			if constexpr(sizeof...(ARGS) > 0) _nodes[pos].val = Val( std::forward<ARGS>(args)... );
+
+			if(pos > 0 && _less( _nodes[pos].val, _nodes[ _parent(pos) ].val )) _sift_up(pos);
+			else _sift_down(pos);
+		}
+
+		template<class... ARGS>
+		void decrease_key(Handle handle, ARGS&&... args) {
+			int pos = _pos_of(handle);
+			if constexpr(sizeof...(ARGS) > 0) {
+				Val val( std::forward<ARGS>(args)... );
+				DCHECK( !_less(_nodes[pos].val, val) ) << "decrease_key() increased the key";
+				_nodes[pos].val = std::move(val);
+			}
+			_sift_up(pos);
+		}
+
+
+		// handles are invalidated
+		void clear() {
+			_nodes.clear();
+			_pos.clear();
+			_free_head = -1;
+		}
+
+		void reserve(int capacity) {
+			_nodes.reserve(capacity);
+			_pos.reserve(capacity);
+		}
+
+
+
+	public:
+		int count() const { return _nodes.size(); }
+
+		bool  is_empty() const { return count() == 0; }
+		bool not_empty() const { return !is_empty(); }
+
+		// number of slots (alive and free)
+		int domain() const { return _pos.size(); }
+
+
+
+	public:
+		auto begin()       { return Iterator<MUTAB>(this, _handle_at(0)); }
+		auto begin() const { return Iterator<CONST>(this, _handle_at(0)); }
+
+		auto end() const { return End_Iterator(); }
+
+
+
+	private:
+		bool _less(const Val& a, const Val& b) const { return static_cast<const Compare&>(*this)(a, b); }
+
+		static int _parent(int pos) { return (pos - 1) / Arity; }
+		static int _first_child(int pos) { return pos * Arity + 1; }
+
+		Handle _handle_at(int pos) const {
+			if(pos < 0 || pos >= count()) return Handle();
+			return Handle( _nodes[pos].slot );
+		}
+
+		int _pos_of(Handle handle) const {
+			DCHECK( handle.valid() && handle.a < domain() ) << "invalid Heap handle";
+			int pos = _pos[handle];
+			DCHECK( pos >= 0 && pos < count() && _nodes[pos].slot == handle.a ) << "erased Heap handle " << handle;
+			return pos;
+		}
+
+		void _place(int pos, Node&& node) {
+			_pos[node.slot] = pos;
+			_nodes[pos] = std::move(node);
+		}
+
+		// move the hole up instead of swapping
+		void _sift_up(int pos) {
+			Node node = std::move( _nodes[pos] );
+			while(pos > 0) {
+				int parent = _parent(pos);
+				if(!_less(node.val, _nodes[parent].val)) break;
+				_place(pos, std::move( _nodes[parent] ));
+				pos = parent;
+			}
+			_place(pos, std::move(node));
+		}
+
+		void _sift_down(int pos) {
+			Node node = std::move( _nodes[pos] );
+			const int n = count();
+			for(;;) {
+				int first = _first_child(pos);
+				if(first >= n) break;
+
+				int best = first;
+				int last = first + Arity < n ? first + Arity : n;
+				for(int c = first+1; c < last; ++c) {
+					if(_less(_nodes[c].val, _nodes[best].val)) best = c;
+				}
+
+				if(!_less(_nodes[best].val, node.val)) break;
+				_place(pos, std::move( _nodes[best] ));
+				pos = best;
+			}
+			_place(pos, std::move(node));
+		}
+
+		void _erase_at(int pos) {
+			int slot = _nodes[pos].slot;
+			int last = count() - 1;
+
+			if(pos != last) {
+				_place(pos, std::move( _nodes[last] ));
+				_nodes.pop_back();
+
+				if(pos > 0 && _less( _nodes[pos].val, _nodes[ _parent(pos) ].val )) _sift_up(pos);
+				else _sift_down(pos);
+			}
+			else _nodes.pop_back();
+
+			_pos[slot] = _free_head;
+			_free_head = slot;
+		}
+	};
+
+
+
+
+	struct With_Builder : Heap {
+		using BASE = Heap;
+		using BASE::BASE;
+
+		template<class NEW_COMPARE>
+		using COMPARE = typename Context<Val, NEW_COMPARE, Arity> :: With_Builder;
+
+		template<int NEW_ARITY>
+		using ARITY = typename Context<Val, Compare, NEW_ARITY> :: With_Builder;
+	};
+
+
+}; // struct Context
+
+} // namespace salgo::_::heap
+
+#include "helper-macros-off.inc"
+
+
+
+
+
+namespace salgo {
+
+template<class T>
+using Heap = typename _::heap::Context<
+	T,
+	std::less<T>,
+	4 // arity
+> :: With_Builder;
+
+} // namespace salgo
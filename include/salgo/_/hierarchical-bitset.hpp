@@ -0,0 +1,186 @@
+#pragma once
+
+/*
+
+Bitset with a summary tree on top of it, for fast "find next set bit" queries.
+
+Level 0 stores the bits. Bit `i` of level `k+1` is set iff word `i` of level `k` is non-zero.
+
+With 64-bit words, `find_next` is O(log_64 N) - at most 5 levels for 2^30 bits.
+
+Bit indices are `INDEX` (`int` by default), e.g. `int64_t` for more than 2^31 bits.
+
+*/
+
+#include <glog/logging.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace salgo::_::hierarchical_bitset {
+
+
+
+template<class INDEX = int>
+class Hierarchical_Bitset {
+public:
+	using Index = INDEX;
+
+private:
+	using Word = uint64_t;
+	static constexpr int Word_Bits = 64;
+	static constexpr int Max_Levels = sizeof(Index) > 4 ? 11 : 6; // enough for 2^63 or 2^31 bits
+
+	static constexpr Index _words(Index bits) { return (bits + Word_Bits - 1) / Word_Bits; }
+	static constexpr Word _bit(Index i) { return Word(1) << (i % Word_Bits); }
+
+	//
+	// data
+	//
+private:
+	// all levels, starting with level 0
+	std::vector<Word> _data;
+
+	// level `k` is stored at `_data[ _offsets[k] .. _offsets[k+1] )`
+	Index _offsets[Max_Levels + 1] = {};
+	int _num_levels = 0;
+
+	Index _size = 0;
+
+
+public:
+	Hierarchical_Bitset() = default;
+	Hierarchical_Bitset(Index size, bool value = false) { resize(size, value); }
+
+
+	Index size() const { return _size; }
+
+
+	bool operator[](Index i) const {
+		_check_bounds(i);
+		return _data[ i / Word_Bits ] & _bit(i);
+	}
+
+
+	void set(Index i) {
+		_check_bounds(i);
+		for(int level=0; level<_num_levels; ++level) {
+			auto& word = _data[ _offsets[level] + i / Word_Bits ];
+			bool was_empty = !word;
+			word |= _bit(i);
+			if(!was_empty) break;
+			i /= Word_Bits;
+		}
+	}
+
+	void reset(Index i) {
+		_check_bounds(i);
+		for(int level=0; level<_num_levels; ++level) {
+			auto& word = _data[ _offsets[level] + i / Word_Bits ];
+			word &= ~_bit(i);
+			if(word) break;
+			i /= Word_Bits;
+		}
+	}
+
+
+	//
+	// index of first set bit at position `i` or later, or -1 if none
+	//
+	Index find_next(Index i) const {
+		if(i >= _size) return -1;
+		DCHECK_GE(i, 0);
+
+		// go up, until a set bit is found
+		int level = 0;
+		for(;;) {
+			if(level == _num_levels) return -1;
+
+			Index w = i / Word_Bits;
+			if(_offsets[level] + w >= _offsets[level+1]) return -1;
+
+			Word masked = _data[ _offsets[level] + w ] & (~Word(0) << (i % Word_Bits));
+			if(masked) {
+				i = w * Word_Bits + __builtin_ctzll(masked);
+				break;
+			}
+
+			i = w + 1;
+			++level;
+		}
+
+		// go down, following lowest set bits
+		while(level > 0) {
+			--level;
+			i = i * Word_Bits + __builtin_ctzll( _data[ _offsets[level] + i ] );
+		}
+
+		return i;
+	}
+
+	Index find_first() const { return find_next(0); }
+
+
+	//
+	// new bits are set to `value`
+	//
+	void resize(Index new_size, bool value = false) {
+		DCHECK_GE(new_size, 0);
+
+		Index old_size = _size;
+		_data.resize( _words(old_size) ); // drop summary levels
+		_data.resize( _words(new_size) );
+
+		if(value) for(Index i=old_size; i<new_size; ++i) {
+			if(i % Word_Bits == 0 && i + Word_Bits <= new_size) {
+				_data[ i / Word_Bits ] = ~Word(0);
+				i += Word_Bits - 1;
+			}
+			else _data[ i / Word_Bits ] |= _bit(i);
+		}
+
+		// clear bits past the end
+		if(new_size % Word_Bits) _data.back() &= _bit(new_size) - 1;
+
+		_size = new_size;
+		_rebuild_summary();
+	}
+
+
+private:
+	void _rebuild_summary() {
+		_num_levels = 1;
+		_offsets[0] = 0;
+		_offsets[1] = _data.size();
+
+		while(_offsets[_num_levels] - _offsets[_num_levels-1] > 1) {
+			DCHECK_LT(_num_levels, Max_Levels);
+
+			Index prev_begin = _offsets[_num_levels-1];
+			Index prev_words = _offsets[_num_levels] - prev_begin;
+
+			_data.resize( _data.size() + _words(prev_words) );
+			for(Index i=0; i<prev_words; ++i) {
+				if(_data[prev_begin + i]) _data[ _offsets[_num_levels] + i / Word_Bits ] |= _bit(i);
+			}
+
+			++_num_levels;
+			_offsets[_num_levels] = _data.size();
+		}
+	}
+
+	void _check_bounds(Index i) const {
+		DCHECK_GE(i, 0) << "index out of bounds";
+		DCHECK_LT(i, _size) << "index out of bounds";
+	}
+};
+
+
+
+} // namespace salgo::_::hierarchical_bitset
+
+
+namespace salgo::_ {
+	template<class INDEX = int>
+	using Hierarchical_Bitset = hierarchical_bitset::Hierarchical_Bitset<INDEX>;
+}
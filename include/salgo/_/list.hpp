@@ -1,14 +1,20 @@
 #pragma once
 
 #include "alloc/array-allocator.hpp"
+#include "alloc/pmr-allocator.hpp" // ::PMR
+#include "unrolled-list.hpp"
 
 #include "add-member.hpp"
+#include "has-member.hpp"
 #include "inplace-storage.hpp"
 #include "accessors.hpp"
 #include "const-flag.hpp"
 #include "subscript-tags.hpp"
 #include "iterable-base.hpp"
 
+#include <functional> // std::less
+#include <type_traits>
+#include <utility> // std::as_const
 
 #ifndef NDEBUG
 #include <unordered_set>
@@ -21,6 +27,9 @@ namespace salgo::_::List {
 
 
 SALGO_ADD_MEMBER(num_existing);
+SALGO_GENERATE_HAS_MEMBER(Is_Shared);
+SALGO_GENERATE_HAS_MEMBER(Is_Monotonic);
+SALGO_GENERATE_HAS_MEMBER(resource);
 
 
 
@@ -61,6 +70,18 @@ struct Context {
 	using       Handle = typename Allocator ::       Handle;
 	using Handle_Small = typename Allocator :: Handle_Small;
 
+	// nodes can be relinked between different lists
+	static constexpr bool Shared_Allocator = [](){
+		if constexpr(has_member__Is_Shared<Allocator>) return Allocator::Is_Shared;
+		else return false;
+	}();
+
+	// memory is reclaimed by the allocator all at once - no need to destruct trivial nodes one by one
+	static constexpr bool Skip_Destruct = [](){
+		if constexpr(has_member__Is_Monotonic<Allocator>) return Allocator::Is_Monotonic && std::is_trivially_destructible_v<Val>;
+		else return false;
+	}();
+
 
 
 
@@ -142,7 +163,7 @@ struct Context {
 			static_assert(C == MUTAB, "called on CONST accessor");
 			DCHECK( HANDLE.valid() && !BASE::just_erased());
 
-			auto new_node = ALLOC.construct( std::forward<ARGS>(args)... );
+			auto new_node = ALLOC.construct_near( HANDLE, std::forward<ARGS>(args)... );
 
 			new_node().prev = BASE::get_prev();
 			if(new_node().prev.valid()) ALLOC[ new_node().prev ].next = new_node.handle();
@@ -161,7 +182,7 @@ struct Context {
 			static_assert(C == MUTAB, "called on CONST accessor");
 			DCHECK( HANDLE.valid() && !BASE::just_erased());
 
-			auto new_node = ALLOC.construct( std::forward<ARGS>(args)... );
+			auto new_node = ALLOC.construct_near( HANDLE, std::forward<ARGS>(args)... );
 
 			new_node().next = BASE::get_next();
 			if(new_node().next.valid()) ALLOC[ new_node().next ].prev = new_node.handle();
@@ -317,6 +338,10 @@ struct Context {
 		auto& _alloc()       { return *static_cast<      Allocator*>(this); }
 		auto& _alloc() const { return *static_cast<const Allocator*>(this); }
 
+	public:
+		// read-only, e.g. for `stats()` of an `Instrumented` allocator
+		const auto& allocator() const { return _alloc(); }
+
 
 
 		//
@@ -335,12 +360,22 @@ struct Context {
 			for(auto& e : il) emplace_back(e);
 		}
 
+		// e.g. `std::pmr::memory_resource*` for `::PMR`
+		explicit List(const Allocator& alloc) : Allocator(alloc) {}
+
 		~List() {
-			for(auto& e : *this) e.erase(); // todo: erase faster, without managing links
+			if constexpr(!Skip_Destruct) {
+				for(auto& e : *this) e.erase(); // todo: erase faster, without managing links
+			}
 		}
 
 		void clear() {
-			for(auto& e : *this) e.erase(); // todo: erase faster, without managing links
+			if constexpr(Skip_Destruct) {
+				if constexpr(Countable) NUM_EXISTING_BASE::num_existing = 0;
+			}
+			else {
+				for(auto& e : *this) e.erase(); // todo: erase faster, without managing links
+			}
 
 			_front.reset();
 			_back.reset();
@@ -431,6 +466,238 @@ struct Context {
 
 
 
+		//
+		// move elements [first, last) of `other` before `pos`
+		//
+		// invalid `pos` means end of this list, invalid `last` means end of `other`
+		//
+		// `other` can be this list, or a list sharing the allocator (e.g. `::SINGLETON` allocators):
+		// nodes are only relinked and handles stay valid
+		//
+		// otherwise elements are move-constructed into this list's allocator (handles change)
+		//
+	public:
+		void splice(Handle pos, List& other, Handle first, Handle last = Handle()) {
+			if(first == last) return;
+			DCHECK( first.valid() );
+
+			if constexpr(!Shared_Allocator) if(&other != this) {
+				for(Handle h = first; h != last; ) {
+					Handle next = other._node(h).next;
+					if(pos.valid()) (*this)(pos).emplace_before( std::move( other[h] ) );
+					else emplace_back( std::move( other[h] ) );
+					other.erase(h);
+					h = next;
+				}
+				return;
+			}
+
+			Handle_Small back = last.valid() ? other._node(last).prev : _small( other._back );
+
+			#ifndef NDEBUG
+			if(&other == this) {
+				for(Handle h = first; h != last; h = _node(h).next) DCHECK( h != pos ) << "splice position inside spliced range";
+			}
+			#endif
+
+			if constexpr(Countable) if(&other != this) {
+				int n = 1;
+				for(Handle h = first; h != back; h = _node(h).next) ++n;
+				other.NUM_EXISTING_BASE::num_existing -= n;
+				NUM_EXISTING_BASE::num_existing += n;
+			}
+
+			other._unlink(first, back);
+			_link_before(_small(pos), first, back);
+		}
+
+		// move all elements of `other` before `pos`
+		void splice(Handle pos, List& other) { splice(pos, other, other._front); }
+
+
+
+		//
+		// merge sorted `other` into this sorted list, leaving `other` empty
+		//
+		// stable: of equal elements, these from this list come first
+		//
+		template<class CMP = std::less<>>
+		void merge(List& other, CMP&& cmp = {}) {
+			if(&other == this) return;
+
+			Handle a = _front;
+			while(other.not_empty()) {
+				Handle b = other._front;
+				if(a.valid() && !cmp( std::as_const(other[b]), std::as_const((*this)[a]) )) {
+					a = _node(a).next;
+					continue;
+				}
+
+				// take run of elements from `other` that go before `a`
+				Handle last = other._node(b).next;
+				while(a.valid() && last.valid() && cmp( std::as_const(other[last]), std::as_const((*this)[a]) )) {
+					last = other._node(last).next;
+				}
+
+				if(!a.valid()) last.reset();
+				splice(a, other, b, last);
+			}
+		}
+
+
+
+		//
+		// stable bottom-up merge sort
+		//
+		// only relinks nodes - handles stay valid
+		//
+		template<class CMP = std::less<>>
+		void sort(CMP&& cmp = {}) {
+			// bins[i] is a sorted run of 2^i elements, or empty
+			// higher bins hold elements from earlier in the list
+			Handle_Small bins[ sizeof(int) * 8 ];
+			int num_bins = 0;
+
+			for(Handle_Small h = _small(_front); h.valid(); ) {
+				Handle_Small carry = h;
+				h = _node(h).next;
+				_node(carry).next.reset();
+
+				int i = 0;
+				for(; i < num_bins && bins[i].valid(); ++i) {
+					carry = _merge_runs(bins[i], carry, cmp);
+					bins[i].reset();
+				}
+
+				if(i == num_bins) ++num_bins;
+				bins[i] = carry;
+			}
+
+			Handle_Small head;
+			for(int i=0; i<num_bins; ++i) {
+				if(bins[i].valid()) head = _merge_runs(bins[i], head, cmp);
+			}
+
+			// restore `prev` links
+			Handle_Small prev;
+			for(Handle_Small h = head; h.valid(); h = _node(h).next) {
+				_node(h).prev = prev;
+				prev = h;
+			}
+
+			_front = head;
+			_back = prev;
+		}
+
+
+
+		//
+		// relocate nodes, so they are stored in list order
+		// (with Array_Allocator, i-th element ends up at index i)
+		//
+		// handles change: `cb(old_handle, new_handle)` is called for each element
+		//
+		// nodes are moved into a new allocator instance, so peak memory usage is doubled
+		//
+		template<class CALLBACK>
+		void linearize(CALLBACK&& cb) {
+			Allocator new_alloc = _empty_alloc();
+
+			Handle h = _front;
+			Handle_Small prev;
+			while(h.valid()) {
+				auto& node = _node(h);
+				Handle_Small nh = new_alloc.construct( std::move(node.val) ).handle();
+
+				new_alloc[nh].prev = prev;
+				if(prev.valid()) new_alloc[prev].next = nh;
+				else _front = nh;
+				prev = nh;
+
+				cb(h, Handle(nh));
+
+				Handle next = node.next;
+				_alloc()(h).destruct();
+				h = next;
+			}
+			_back = prev;
+
+			std::swap(_alloc(), new_alloc);
+		}
+
+		void linearize() { linearize( [](auto&&, auto&&){} ); }
+
+
+
+	private:
+		// new allocator instance, using the same memory resource (if any)
+		Allocator _empty_alloc() const {
+			if constexpr(has_member__resource<Allocator>) return Allocator( _alloc().resource() );
+			else return Allocator();
+		}
+
+		auto& _node(Handle h)       { return _alloc()[h]; }
+		auto& _node(Handle h) const { return _alloc()[h]; }
+
+		// not every allocator supports converting an invalid Handle to Handle_Small
+		static Handle_Small _small(Handle h) { return h.valid() ? Handle_Small(h) : Handle_Small(); }
+
+		// merge sorted runs linked by `next` only
+		// stable: on ties, elements of `a` come first
+		template<class CMP>
+		Handle_Small _merge_runs(Handle_Small a, Handle_Small b, CMP& cmp) {
+			if(!a.valid()) return b;
+			if(!b.valid()) return a;
+
+			auto take = [&]() {
+				Handle_Small& from = cmp( std::as_const((*this)[b]), std::as_const((*this)[a]) ) ? b : a;
+				Handle_Small e = from;
+				from = _node(e).next;
+				return e;
+			};
+
+			Handle_Small head = take();
+			Handle_Small tail = head;
+
+			while(a.valid() && b.valid()) {
+				Handle_Small e = take();
+				_node(tail).next = e;
+				tail = e;
+			}
+
+			_node(tail).next = a.valid() ? a : b;
+			return head;
+		}
+
+		// unlink nodes [first, back] without destructing them
+		void _unlink(Handle_Small first, Handle_Small back) {
+			Handle_Small prv = _node(first).prev;
+			Handle_Small nxt = _node(back).next;
+
+			if(prv.valid()) _node(prv).next = nxt;
+			else _front = nxt;
+
+			if(nxt.valid()) _node(nxt).prev = prv;
+			else _back = prv;
+		}
+
+		// link unlinked nodes [first, back] before `pos`
+		void _link_before(Handle_Small pos, Handle_Small first, Handle_Small back) {
+			Handle_Small prv = pos.valid() ? _node(pos).prev : _small(_back);
+
+			_node(first).prev = prv;
+			_node(back).next = pos;
+
+			if(prv.valid()) _node(prv).next = first;
+			else _front = first;
+
+			if(pos.valid()) _node(pos).prev = back;
+			else _back = back;
+		}
+
+
+
+
 	public:
 		auto begin() {
 			return Iterator<MUTAB>(this, _front);
@@ -467,6 +734,15 @@ struct Context {
 
 		using FULL_BLOWN =
 			typename Context<Val, Allocator, true> :: With_Builder;
+
+		// nodes are allocated from a `std::pmr::memory_resource` given on construction
+		using PMR =
+			typename Context<Val, salgo::Pmr_Allocator<Val>, Countable> :: With_Builder;
+
+		// up to K elements per node
+		template<int K>
+		using UNROLLED =
+			typename unrolled_list::Context<Val, Allocator, Countable, K> :: With_Builder;
 	};
 
 
@@ -17,7 +17,7 @@ struct Index;
 
 
 template<class VAL, class ALLOCATOR, int STACK_BUFFER, bool DENSE,
-		bool CONSTRUCTED_FLAGS_INPLACE, bool CONSTRUCTED_FLAGS_BITSET, bool COUNT, int ALIGN>
+		bool CONSTRUCTED_FLAGS_INPLACE, bool CONSTRUCTED_FLAGS_BITSET, bool COUNT, int ALIGN, class HANDLE_INT>
 struct Params;
 
 
@@ -61,7 +61,8 @@ using Memory_Block = typename _::memory_block::With_Builder< _::memory_block::Pa
 		false, // CONSTRUCTED_FLAGS_INPLACE
 		false, // CONSTRUCTED_FLAGS_BITSET
 		false, // COUNT
-		0 // ALIGN
+		0, // ALIGN
+		int // HANDLE_INT
 >>;
 
 
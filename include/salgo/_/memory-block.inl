@@ -10,6 +10,8 @@
 #include "add-member.hpp"
 
 #include <cstring> // memcpy
+#include <limits>
+#include <type_traits>
 
 #include "helper-macros-on.inc"
 
@@ -25,11 +27,9 @@ template<bool> struct Add_exists_bitset {
 template<> struct Add_exists_bitset<false> {};
 
 
-using Handle_Int_Type = int;
-
 template<class P>
-struct Handle : Int_Handle_Base<Handle<P>, Handle_Int_Type> {
-	using BASE = Int_Handle_Base<Handle<P>, Handle_Int_Type>;
+struct Handle : Int_Handle_Base<Handle<P>, typename P::Handle_Int> {
+	using BASE = Int_Handle_Base<Handle<P>, typename P::Handle_Int>;
 	using BASE::BASE;
 };
 
@@ -47,7 +47,7 @@ struct Index : Handle<P> {
 
 
 template<class VAL, class ALLOCATOR, int STACK_BUFFER, bool DENSE,
-		bool CONSTRUCTED_FLAGS_INPLACE, bool CONSTRUCTED_FLAGS_BITSET, bool COUNT, int ALIGN>
+		bool CONSTRUCTED_FLAGS_INPLACE, bool CONSTRUCTED_FLAGS_BITSET, bool COUNT, int ALIGN, class HANDLE_INT>
 struct Params {
 	using Val = VAL;
 	using Supplied_Allocator = ALLOCATOR;
@@ -64,6 +64,15 @@ struct Params {
 	static constexpr bool Iterable = Exists || Dense;
 	static constexpr bool Countable = Count || Dense;
 
+	// integer type stored in handles - max value is reserved for invalid handles
+	using Handle_Int = HANDLE_INT;
+	static_assert(std::is_integral_v<Handle_Int>);
+
+	// integer type of domains, sizes and indices - `int`, or signed `Handle_Int` if that is wider
+	using Index_Int = std::conditional_t<(sizeof(Handle_Int) > sizeof(int)), std::make_signed_t<Handle_Int>, int>;
+	static constexpr Index_Int Max_Domain =
+		(unsigned long long)std::numeric_limits<Handle_Int>::max() < (unsigned long long)std::numeric_limits<Index_Int>::max() ?
+		(Index_Int)std::numeric_limits<Handle_Int>::max() : std::numeric_limits<Index_Int>::max();
 
 
 	using Handle       = memory_block::Handle<Params>;
@@ -140,6 +149,12 @@ public:
 
 	bool is_not_constructed() const { return ! is_constructed(); }
 
+	// raw memory of the element (`sizeof(Val)` bytes), also valid when it's not constructed
+	auto raw_storage() const {
+		_check_bounds();
+		return (Const<char,C>*)(&_get());
+	}
+
 	// same as `is_constructed()` but also checks bounds
 	// bool exists_SLOW() const {
 	// 	if(!_is_in_bounds()) return false;
@@ -180,7 +195,7 @@ private:
 
 	void _increment() {
 		if constexpr(P::Dense) ++MUT_HANDLE;
-		else do ++MUT_HANDLE; while( (int)HANDLE != CONT.domain() && !BASE::accessor().is_constructed() );
+		else do ++MUT_HANDLE; while( (typename P::Index_Int)HANDLE != CONT.domain() && !BASE::accessor().is_constructed() );
 	}
 
 	void _decrement() {
@@ -220,12 +235,12 @@ struct Context {
 template<class P>
 class Memory_Block :
 		private P::Rebound_Allocator,
-		private Add_num_existing<int, P::Count>,
+		private Add_num_existing<typename P::Index_Int, P::Count>,
 		//private Add_exists<std::vector<bool>, P::Exists_Bitset>,
 		private Add_exists_bitset<P::Exists_Bitset>,
 		protected P {
 
-	using NUM_EXISTING_BASE = Add_num_existing<int, P::Count>;
+	using NUM_EXISTING_BASE = Add_num_existing<typename P::Index_Int, P::Count>;
 	using CONSTRUCTED_FLAGS_BITSET_BASE = Add_exists_bitset<P::Exists_Bitset>;//Add_exists<std::vector<bool>, P::Exists_Bitset>;
 
 	using typename P::Node;
@@ -245,6 +260,10 @@ public:
 	using Handle_Small = typename P::Handle_Small;
 	using Index        = typename P::Index;
 
+	using typename P::Handle_Int;
+	using typename P::Index_Int;
+	using P::Max_Domain;
+
 private:
 	friend Accessor<P,MUTAB>;
 	friend Accessor<P,CONST>;
@@ -267,7 +286,7 @@ private:
 	Node* _data = _get_stack_buffer();
 	char _stack_buffer[ _stack_buffer_sizeof() ];
 
-	int _size = 0; // not Stack_Buffer? if so, need to also construct elements if DENSE
+	Index_Int _size = 0; // not Stack_Buffer? if so, need to also construct elements if DENSE
 
 	auto _get_stack_buffer() {
 		return (Node*)_stack_buffer;
@@ -299,7 +318,7 @@ public:
 			_data = _get_stack_buffer();
 		}
 
-		for(int i=0; i<_size; ++i) {
+		for(Index_Int i=0; i<_size; ++i) {
 			std::allocator_traits<Allocator>::construct(_allocator(), _data+i);
 			if( o(i).is_constructed() ) {
 				_get(i).construct( o[i] );
@@ -351,8 +370,9 @@ public:
 	}
 
 	template<class... ARGS>
-	Memory_Block(int size, ARGS&&... args) : _size(size) {
+	Memory_Block(Index_Int size, ARGS&&... args) : _size(size) {
 		static_assert(P::Dense || sizeof...(ARGS) == 0, "only DENSE memory_blocks can supply construction args");
+		DCHECK_LE(size, P::Max_Domain) << "Memory_Block size overflows its HANDLE_INT type";
 
 		if(_size > Stack_Buffer) {
 			_data = std::allocator_traits<Allocator>::allocate(_allocator(), _size);
@@ -362,7 +382,7 @@ public:
 			_data = _get_stack_buffer();
 		}
 
-		for(int i=0; i<_size; ++i) {
+		for(Index_Int i=0; i<_size; ++i) {
 			std::allocator_traits<Allocator>::construct(_allocator(), _data+i);
 			if constexpr(P::Dense) {
 				_get(i).construct( args... );
@@ -389,44 +409,44 @@ private:
 
 
 private:
-	void _destruct_block(Node* data, int size) {
+	void _destruct_block(Node* data, Index_Int size) {
 		static_assert(P::Dense || P::Exists || std::is_trivially_destructible_v<Val>,
 						"can't destroy non-POD container if no CONSTRUCTED_FLAGS or DENSE flags");
 
-		_destruct_block(data, size, [this](int i){ return (*this)(i).is_constructed(); });
+		_destruct_block(data, size, [this](Index_Int i){ return (*this)(i).is_constructed(); });
 	}
 
 	// destruct nodes+values
 	template<class CONSTRUCTED_FLAGS_FUN>
-	void _destruct_block(Node* data, int size, CONSTRUCTED_FLAGS_FUN&& exists_fun) {
+	void _destruct_block(Node* data, Index_Int size, CONSTRUCTED_FLAGS_FUN&& exists_fun) {
 		(void)data;
 		if constexpr(!std::is_trivially_destructible_v<Val>) {
 
 			// destruct values
-			for(int i=0; i<size; ++i) if(exists_fun(i)) {
+			for(Index_Int i=0; i<size; ++i) if(exists_fun(i)) {
 					_get(i).destruct();
 				}
 		}
 
 		// destruct nodes
-		for(int i=0; i<size; ++i) {
+		for(Index_Int i=0; i<size; ++i) {
 			std::allocator_traits<Allocator>::destroy(_allocator(), data+i);
 		}
 	}
 
 public:
-	void resize(int new_size) {
+	void resize(Index_Int new_size) {
 		static_assert(P::Dense || P::Exists || std::is_trivially_move_constructible_v<Val>,
 						"can't resize non-POD container if no CONSTRUCTED_FLAGS or DENSE flags");
 
 		if constexpr(std::is_trivially_move_constructible_v<Val>) {
-			_resize(new_size, [](int){ return true; });
+			_resize(new_size, [](Index_Int){ return true; });
 		}
-		else _resize(new_size, [this](int i){ return (*this)(i).is_constructed(); });
+		else _resize(new_size, [this](Index_Int i){ return (*this)(i).is_constructed(); });
 	}
 
 	template<class CONSTRUCTED_FLAGS_FUN>
-	void resize(int new_size, CONSTRUCTED_FLAGS_FUN&& exists_fun) {
+	void resize(Index_Int new_size, CONSTRUCTED_FLAGS_FUN&& exists_fun) {
 		static_assert(!P::Dense && !P::Exists, "can only supply CONSTRUCTED_FLAGS_FUN if not Dense and Exists");
 
 		_resize(new_size, std::forward<CONSTRUCTED_FLAGS_FUN>(exists_fun));
@@ -434,7 +454,8 @@ public:
 
 private:
 	template<class CONSTRUCTED_FLAGS_FUN>
-	void _resize(int new_size, CONSTRUCTED_FLAGS_FUN&& exists_fun) {
+	void _resize(Index_Int new_size, CONSTRUCTED_FLAGS_FUN&& exists_fun) {
+		DCHECK_LE(new_size, P::Max_Domain) << "Memory_Block size overflows its HANDLE_INT type";
 
 		decltype(_data) new_data;
 
@@ -445,13 +466,13 @@ private:
 			new_data = _get_stack_buffer();
 		}
 
-		int n = std::min(_size, new_size);
+		Index_Int n = std::min(_size, new_size);
 
 		// new memory location?
 		if(new_data != _data) {
 
 			if constexpr(!std::is_trivially_move_constructible_v<Val>) {
-				for(int i=0; i<n; ++i) {
+				for(Index_Int i=0; i<n; ++i) {
 					if(exists_fun(i)) {
 						// move-construct node+value
 
@@ -487,7 +508,7 @@ private:
 		}
 
 		// construct new nodes
-		for(int i=_size; i<new_size; ++i) {
+		for(Index_Int i=_size; i<new_size; ++i) {
 			std::allocator_traits<Allocator>::construct(_allocator(), new_data+i);
 			if constexpr(P::Dense) {
 				new_data[i].construct(); // todo: supply args
@@ -516,6 +537,23 @@ public:
 	}
 
 
+	// true if nodes hold nothing but values (no inplace flags, debug info or padding)
+	// then `data()` can be used as a plain array of values
+	static constexpr bool is_contiguous() {
+		return sizeof(Node) == sizeof(Val);
+	}
+
+	Val* data() {
+		static_assert(is_contiguous(), "data() requires nodes without extra fields");
+		return reinterpret_cast<Val*>(_data);
+	}
+
+	const Val* data() const {
+		static_assert(is_contiguous(), "data() requires nodes without extra fields");
+		return reinterpret_cast<const Val*>(_data);
+	}
+
+
 
 
 	// direct access
@@ -593,7 +631,7 @@ public:
 	void construct_all(const ARGS&... args) {
 		static_assert(!P::Dense, "construct_all() not supported for DENSE memory-blocks");
 
-		for(int i=0; i<_size; ++i) {
+		for(Index_Int i=0; i<_size; ++i) {
 			if constexpr(P::Exists) {
 				DCHECK( !(*this)(i).is_constructed() ) << "can't construct_all() if some elements already exist";
 			}
@@ -604,7 +642,7 @@ public:
 
 private:
 	bool _is_in_bounds(Index key) const {
-		return key >= 0 && key < domain();
+		return Index_Int(key) >= 0 && Index_Int(key) < domain();
 	}
 
 	void _check_bounds(Index key) const {
@@ -614,7 +652,7 @@ private:
 
 
 public:
-	int count() const {
+	Index_Int count() const {
 		static_assert(P::Countable);
 		if constexpr(P::Dense) return domain();
 		else return NUM_EXISTING_BASE::num_existing;
@@ -631,9 +669,9 @@ public:
 
 public:
 	template<class CALLBACK>
-	int compact(CALLBACK&& cb) {
-		int idx = 0;
-		for(int i=0; i<domain(); ++i) {
+	Index_Int compact(CALLBACK&& cb) {
+		Index_Int idx = 0;
+		for(Index_Int i=0; i<domain(); ++i) {
 			if((*this)(i).is_constructed()) {
 				if(idx < i) {
 					(*this)(idx).construct( std::move( _get(i).get() ) );
@@ -648,7 +686,7 @@ public:
 		return idx;
 	}
 
-	int compact() {
+	Index_Int compact() {
 		return compact( [](auto&&, auto&&){} );
 	}
 
@@ -712,41 +750,47 @@ public:
 	using P::Exists_Bitset;
 	using P::Count;
 	using P::Align;
+	using typename P::Handle_Int;
 
 
 	template<class NEW_ALLOCATOR>
 	using ALLOCATOR =
-		With_Builder< Params< Val, NEW_ALLOCATOR, Stack_Buffer, Dense, Exists_Inplace, Exists_Bitset, Count, Align >>;
+		With_Builder< Params< Val, NEW_ALLOCATOR, Stack_Buffer, Dense, Exists_Inplace, Exists_Bitset, Count, Align, Handle_Int >>;
 
 	template<int NEW_STACK_BUFFER>
 	using INPLACE_BUFFER =
-		With_Builder< Params< Val, Supplied_Allocator, NEW_STACK_BUFFER, Dense, Exists_Inplace, Exists_Bitset, Count, Align >>;
+		With_Builder< Params< Val, Supplied_Allocator, NEW_STACK_BUFFER, Dense, Exists_Inplace, Exists_Bitset, Count, Align, Handle_Int >>;
 
 
 	using DENSE =
-		With_Builder< Params< Val, Supplied_Allocator, Stack_Buffer, true, Exists_Inplace, Exists_Bitset, Count, Align >>;
+		With_Builder< Params< Val, Supplied_Allocator, Stack_Buffer, true, Exists_Inplace, Exists_Bitset, Count, Align, Handle_Int >>;
 
 	using SPARSE = // (default)
-		With_Builder< Params< Val, Supplied_Allocator, Stack_Buffer, false, Exists_Inplace, Exists_Bitset, Count, Align >>;
+		With_Builder< Params< Val, Supplied_Allocator, Stack_Buffer, false, Exists_Inplace, Exists_Bitset, Count, Align, Handle_Int >>;
 
 
 	using CONSTRUCTED_FLAGS_INPLACE =
-		With_Builder< Params< Val, Supplied_Allocator, Stack_Buffer, Dense, true, false, Count, Align >>;
+		With_Builder< Params< Val, Supplied_Allocator, Stack_Buffer, Dense, true, false, Count, Align, Handle_Int >>;
 
 	using CONSTRUCTED_FLAGS_BITSET =
-		With_Builder< Params< Val, Supplied_Allocator, Stack_Buffer, Dense, false, true, Count, Align >>;
+		With_Builder< Params< Val, Supplied_Allocator, Stack_Buffer, Dense, false, true, Count, Align, Handle_Int >>;
 
 	using CONSTRUCTED_FLAGS = CONSTRUCTED_FLAGS_BITSET; // seems to be faster than inplace version - also much more memory efficient for large aligned types
 
 	using COUNT =
-		With_Builder< Params< Val, Supplied_Allocator, Stack_Buffer, Dense, Exists_Inplace, Exists_Bitset, true, Align >>;
+		With_Builder< Params< Val, Supplied_Allocator, Stack_Buffer, Dense, Exists_Inplace, Exists_Bitset, true, Align, Handle_Int >>;
 
 	template<int X>
 	using ALIGN =
-		With_Builder< Params< Val, Supplied_Allocator, Stack_Buffer, Dense, Exists_Inplace, Exists_Bitset, Count, X >>;
+		With_Builder< Params< Val, Supplied_Allocator, Stack_Buffer, Dense, Exists_Inplace, Exists_Bitset, Count, X, Handle_Int >>;
+
+	// integer type used by handles, e.g. `uint16_t` for small blocks
+	template<class X>
+	using HANDLE_INT =
+		With_Builder< Params< Val, Supplied_Allocator, Stack_Buffer, Dense, Exists_Inplace, Exists_Bitset, Count, Align, X >>;
 
 	using FULL_BLOWN =
-		With_Builder< Params< Val, Supplied_Allocator, Stack_Buffer, Dense, false, true, true, Align >>; // by default bitset-exists
+		With_Builder< Params< Val, Supplied_Allocator, Stack_Buffer, Dense, false, true, true, Align, Handle_Int >>; // by default bitset-exists
 };
 
 
@@ -761,9 +805,8 @@ public:
 template<class X>
 struct std::hash<salgo::_::memory_block::Handle<X>> {
 	size_t operator()(const salgo::_::memory_block::Handle<X>& h) const {
-		return std::hash<salgo::_::memory_block::Handle_Int_Type>()(
-			salgo::_::memory_block::Handle_Int_Type(h)
-		);
+		using Int = typename X::Handle_Int;
+		return std::hash<Int>()( Int(h) );
 	}
 };
 
@@ -0,0 +1,420 @@
+#pragma once
+
+/*
+
+Addressable pairing heap.
+
+Nodes never move, handles are node indices. Children of a node form a doubly-linked list.
+
+* `push`, `top`, `decrease_key` - O(1)
+* `pop`, `erase`, `update` - O(log N) amortized (two-pass merge of the children)
+
+Asymptotically cheaper decrease_key than `Heap`, but nodes are scattered, so in practice (bench/heap.cpp)
+`Heap` is faster for both pop-heavy and decrease_key-heavy workloads of up to millions of elements.
+
+With `std::less` (default) the top is the smallest value. Use ::COMPARE<std::greater<>> for a max-heap.
+
+*/
+
+#include "const-flag.hpp"
+#include "accessors.hpp"
+#include "handles.hpp"
+#include "subscript-tags.hpp"
+
+#include <glog/logging.h>
+
+#include <functional> // std::less
+#include <utility> // std::forward, std::move
+#include <vector>
+
+#include "helper-macros-on.inc"
+
+namespace salgo::_::pairing_heap {
+
+
+
+// node index
+//
+// parametrized by unused context X, to make Handles from different Contexts incompatible
+template<class X>
+struct Handle : Int_Handle_Base<Handle<X>, int> {
+	using BASE = Int_Handle_Base<Handle<X>, int>;
+
+	Handle() = default;
+	explicit Handle(int i) : BASE(i) {}
+};
+
+
+
+
+template<
+	class _VAL,
+	class _CMP
+>
+struct Context {
+
+	//
+	// forward declarations
+	//
+	template<Const_Flag C> class Accessor;
+	template<Const_Flag C> class Iterator;
+	class Pairing_Heap;
+	using Container = Pairing_Heap;
+
+	struct End_Iterator {};
+
+
+
+	//
+	// template arguments
+	//
+	using Val = _VAL;
+	using Compare = _CMP;
+
+
+	using       Handle = pairing_heap::Handle<Context>;
+	using Handle_Small = Handle;
+
+
+	struct Node {
+		Val val;
+		int child = -1;
+		int next = -1; // next sibling, or next free node
+		int prev = -1; // previous sibling, or parent if first child; -1 for the root
+
+		bool alive = false;
+	};
+
+
+
+
+	//
+	// accessor
+	//
+	template<Const_Flag C>
+	class Accessor : public Accessor_Base<C,Context> {
+		using BASE = Accessor_Base<C,Context>;
+
+	public:
+		using BASE::BASE;
+
+		void erase() {
+			static_assert(C == MUTAB, "called erase() on CONST accessor");
+			CONT.erase( HANDLE );
+		}
+
+		// assign a new value (or keep the value modified through this accessor), and restore heap order
+		template<class... ARGS>
+		void update(ARGS&&... args) {
+			static_assert(C == MUTAB, "called update() on CONST accessor");
+			CONT.update( HANDLE, std::forward<ARGS>(args)... );
+		}
+
+		// same as `update()`, but the value can only move towards the top
+		template<class... ARGS>
+		void decrease_key(ARGS&&... args) {
+			static_assert(C == MUTAB, "called decrease_key() on CONST accessor");
+			CONT.decrease_key( HANDLE, std::forward<ARGS>(args)... );
+		}
+	};
+
+
+
+
+	//
+	// iterator: node order (not sorted)
+	//
+	template<Const_Flag C>
+	class Iterator : public Iterator_Base<C,Context> {
+		using BASE = Iterator_Base<C,Context>;
+
+	public:
+		using BASE::BASE;
+
+	private:
+		friend Iterator_Base<C,Context>;
+
+		void _increment() { MUT_HANDLE = CONT._alive_from( HANDLE.a + 1, +1 ); }
+		void _decrement() { MUT_HANDLE = CONT._alive_from( HANDLE.a - 1, -1 ); }
+
+	public:
+		bool operator!=(End_Iterator) const { return HANDLE.valid(); }
+	};
+
+
+
+
+
+	class Pairing_Heap : private Compare {
+	public:
+		using Val = Context::Val;
+		using       Handle = Context::      Handle;
+		using Handle_Small = Context::Handle_Small;
+
+		template<Const_Flag C> using Accessor = Context::Accessor<C>;
+		template<Const_Flag C> using Iterator = Context::Iterator<C>;
+
+	private:
+		friend Iterator<MUTAB>;
+		friend Iterator<CONST>;
+
+
+		//
+		// data
+		//
+	private:
+		std::vector<Node> _nodes;
+		std::vector<int> _pairs; // scratch space for `_merge_siblings`
+
+		int _root = -1;
+		int _free_head = -1;
+		int _count = 0;
+
+
+		//
+		// construction
+		//
+	public:
+		Pairing_Heap() = default;
+		explicit Pairing_Heap(const Compare& compare) : Compare(compare) {}
+
+
+
+		//
+		// element access
+		//
+	public:
+		// modifying the value requires `update(handle)` afterwards
+		auto& operator[](Handle handle)       { _check(handle); return _nodes[handle].val; }
+		auto& operator[](Handle handle) const { _check(handle); return _nodes[handle].val; }
+
+		auto operator()(Handle handle)       { _check(handle); return Accessor<MUTAB>(this, handle); }
+		auto operator()(Handle handle) const { _check(handle); return Accessor<CONST>(this, handle); }
+
+		// top
+		auto operator()(First_Tag)       { DCHECK(not_empty()); return Accessor<MUTAB>(this, Handle(_root)); }
+		auto operator()(First_Tag) const { DCHECK(not_empty()); return Accessor<CONST>(this, Handle(_root)); }
+
+		auto& operator[](First_Tag)       { DCHECK(not_empty()); return _nodes[_root].val; }
+		auto& operator[](First_Tag) const { DCHECK(not_empty()); return _nodes[_root].val; }
+
+		const Val& top() const { DCHECK(not_empty()); return _nodes[_root].val; }
+
+
+
+		//
+		// modifiers
+		//
+	public:
+		template<class... ARGS>
+		auto emplace(ARGS&&... args) {
+			int n = _free_head;
+			if(n != -1) {
+				_free_head = _nodes[n].next;
+				_nodes[n].val = Val( std::forward<ARGS>(args)... );
+			}
+			else {
+				n = _nodes.size();
+				_nodes.push_back( Node{ Val( std::forward<ARGS>(args)... ) } );
+			}
+
+			auto& node = _nodes[n];
+			node.child = node.next = node.prev = -1;
+			node.alive = true;
+			++_count;
+
+			_root = _meld(_root, n);
+			return Accessor<MUTAB>(this, Handle(n));
+		}
+
+		template<class... ARGS>
+		auto push(ARGS&&... args) { return emplace( std::forward<ARGS>(args)... ); } // alias
+
+
+		void pop() {
+			DCHECK(not_empty()) << "pop() on empty heap";
+			erase( Handle(_root) );
+		}
+
+		void erase(Handle handle) {
+			_check(handle);
+			int n = handle;
+
+			if(n == _root) _root = _merge_siblings( _nodes[n].child );
+			else {
+				_cut(n);
+				_root = _meld( _root, _merge_siblings( _nodes[n].child ) );
+			}
+
+			auto& node = _nodes[n];
+			node.alive = false;
+			node.next = _free_head;
+			_free_head = n;
+			--_count;
+		}
+
+
+		template<class... ARGS>
+		void update(Handle handle, ARGS&&... args) {
+			_check(handle);
+			int n = handle;
+			if constexpr(sizeof...(ARGS) > 0) _nodes[n].val = Val( std::forward<ARGS>(args)... );
+
+			// detach the node from its children, and re-insert it
+			int children = _nodes[n].child;
+			_nodes[n].child = -1;
+
+			if(n == _root) _root = -1;
+			else _cut(n);
+
+			_root = _meld( _root, _merge_siblings(children) );
+			_root = _meld( _root, n );
+		}
+
+		template<class... ARGS>
+		void decrease_key(Handle handle, ARGS&&... args) {
+			_check(handle);
+			int n = handle;
+			if constexpr(sizeof...(ARGS) > 0) {
+				Val val( std::forward<ARGS>(args)... );
+				DCHECK( !_less(_nodes[n].val, val) ) << "decrease_key() increased the key";
+				_nodes[n].val = std::move(val);
+			}
+
+			if(n == _root) return;
+			_cut(n);
+			_root = _meld(_root, n);
+		}
+
+
+		// handles are invalidated
+		void clear() {
+			_nodes.clear();
+			_root = _free_head = -1;
+			_count = 0;
+		}
+
+		void reserve(int capacity) { _nodes.reserve(capacity); }
+
+
+
+	public:
+		int count() const { return _count; }
+
+		bool  is_empty() const { return count() == 0; }
+		bool not_empty() const { return !is_empty(); }
+
+		// number of nodes (alive and free)
+		int domain() const { return _nodes.size(); }
+
+
+
+	public:
+		auto begin()       { return Iterator<MUTAB>(this, _alive_from(0, +1)); }
+		auto begin() const { return Iterator<CONST>(this, _alive_from(0, +1)); }
+
+		auto end() const { return End_Iterator(); }
+
+
+
+	private:
+		bool _less(const Val& a, const Val& b) const { return static_cast<const Compare&>(*this)(a, b); }
+
+		void _check(Handle handle) const {
+			DCHECK( handle.valid() && handle.a < domain() && _nodes[handle].alive ) << "invalid or erased Pairing_Heap handle " << handle;
+			(void)handle;
+		}
+
+		Handle _alive_from(int i, int step) const {
+			while(i >= 0 && i < domain() && !_nodes[i].alive) i += step;
+			if(i < 0 || i >= domain()) return Handle();
+			return Handle(i);
+		}
+
+
+		// both are roots (or -1)
+		int _meld(int a, int b) {
+			if(a == -1) return b;
+			if(b == -1) return a;
+			if(_less(_nodes[b].val, _nodes[a].val)) std::swap(a, b);
+
+			// b becomes the first child of a
+			auto& na = _nodes[a];
+			auto& nb = _nodes[b];
+			nb.next = na.child;
+			nb.prev = a;
+			if(na.child != -1) _nodes[na.child].prev = b;
+			na.child = b;
+			return a;
+		}
+
+		// detach the subtree of a non-root node
+		void _cut(int n) {
+			auto& node = _nodes[n];
+			DCHECK_NE(node.prev, -1);
+
+			auto& prev = _nodes[node.prev];
+			if(prev.child == n) prev.child = node.next; // first child
+			else prev.next = node.next;
+
+			if(node.next != -1) _nodes[node.next].prev = node.prev;
+			node.next = node.prev = -1;
+		}
+
+		// two-pass pairing: meld pairs left to right, then the results right to left
+		int _merge_siblings(int first) {
+			if(first == -1) return -1;
+
+			_pairs.clear();
+			for(int a = first; a != -1; ) {
+				int b = _nodes[a].next;
+				if(b == -1) {
+					_nodes[a].prev = -1;
+					_pairs.push_back(a);
+					break;
+				}
+
+				int rest = _nodes[b].next;
+				_nodes[a].next = _nodes[a].prev = -1;
+				_nodes[b].next = _nodes[b].prev = -1;
+				_pairs.push_back( _meld(a, b) );
+				a = rest;
+			}
+
+			int result = _pairs.back();
+			for(int i = (int)_pairs.size()-2; i >= 0; --i) result = _meld(_pairs[i], result);
+			return result;
+		}
+	};
+
+
+
+
+	struct With_Builder : Pairing_Heap {
+		using BASE = Pairing_Heap;
+		using BASE::BASE;
+
+		template<class NEW_COMPARE>
+		using COMPARE = typename Context<Val, NEW_COMPARE> :: With_Builder;
+	};
+
+
+}; // struct Context
+
+} // namespace salgo::_::pairing_heap
+
+#include "helper-macros-off.inc"
+
+
+
+
+
+namespace salgo {
+
+template<class T>
+using Pairing_Heap = typename _::pairing_heap::Context<
+	T,
+	std::less<T>
+> :: With_Builder;
+
+} // namespace salgo
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 
 namespace salgo {
 
@@ -56,6 +57,44 @@ namespace xoroshiro128x {
 } // namespace
 
 
+//
+// same generator, with its own state - for reproducible sequences per object
+//
+class Xoroshiro128 {
+public:
+	explicit Xoroshiro128(uint64_t seed = 1) { this->seed(seed); }
+
+	// state is filled using splitmix64, so it's never all zeros
+	void seed(uint64_t seed) {
+		for(auto& e : _s) {
+			uint64_t z = (seed += 0x9e3779b97f4a7c15);
+			z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+			z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+			e = z ^ (z >> 31);
+		}
+	}
+
+	uint64_t operator()() {
+		const uint64_t s0 = _s[0];
+		uint64_t s1 = _s[1];
+		const uint64_t result = s0 + s1;
+
+		s1 ^= s0;
+		_s[0] = xoroshiro128x::rotl(s0, 55) ^ s1 ^ (s1 << 14);
+		_s[1] = xoroshiro128x::rotl(s1, 36);
+
+		return result;
+	}
+
+	uint32_t rand_32() { return (*this)() & 0xffffffffu; }
+
+private:
+	uint64_t _s[2];
+};
+
+
+
+
 inline uint32_t rand_32() {
 	auto x = xoroshiro128x::next() & 0xffffffffu;
 	//std::cout << x << std::endl;
@@ -0,0 +1,392 @@
+#pragma once
+
+/*
+
+Values are kept in a dense array - iteration touches only contiguous memory.
+
+Handles are (slot, generation) pairs. Slots are reused, but every erase bumps the slot's generation,
+so stale handles are detected in O(1) (`exists(handle)`), instead of silently aliasing new elements.
+
+Insert and erase are O(1): erase moves the last value into the hole (swap-remove),
+so iteration order is not preserved and values move in memory.
+
+*/
+
+#include "const-flag.hpp"
+#include "accessors.hpp"
+#include "handles.hpp"
+#include "subscript-tags.hpp"
+#include "iterable-base.hpp"
+
+#include "dynamic-array.inl"
+
+#include <glog/logging.h>
+
+#include <cstdint> // uint64_t
+#include <new> // placement new
+#include <utility> // std::forward, std::move
+
+#include "helper-macros-on.inc"
+
+namespace salgo::_::slot_map {
+
+
+
+using H0 = Int_Handle<int>;
+
+// slot index and generation
+//
+// parametrized by unused context X, to make Handles from different Contexts incompatible
+template<class X>
+struct Handle : Pair_Handle_Base<Handle<X>, H0, unsigned int> {
+	using BASE = Pair_Handle_Base<Handle<X>, H0, unsigned int>;
+
+	Handle() = default;
+
+	template<class A, class B>
+	Handle(A aa, B bb) : BASE(aa,bb) {}
+};
+
+
+
+
+template<class _VAL>
+struct Context {
+
+	//
+	// forward declarations
+	//
+	template<Const_Flag C> class Reference;
+	template<Const_Flag C> class Accessor;
+	template<Const_Flag C> class Iterator;
+	class Slot_Map;
+	using Container = Slot_Map;
+
+	struct End_Iterator {};
+
+
+
+	//
+	// template arguments
+	//
+	using Val = _VAL;
+
+
+	using       Handle = slot_map::Handle<Context>;
+	using Handle_Small = Handle;
+
+
+	// `index` is the dense index if the slot is alive, or the next free slot otherwise
+	// odd `generation` means alive
+	struct Slot {
+		int index = -1;
+		unsigned int generation = 0;
+	};
+
+
+
+
+	//
+	// reference: caches the dense index of the element
+	//
+	template<Const_Flag C>
+	class Reference : public Reference_Base<C,Context> {
+		using BASE = Reference_Base<C,Context>;
+		friend Reference_Base<C,Context>;
+		friend Slot_Map;
+
+	public:
+		using BASE::BASE;
+
+	private:
+		bool _just_erased = false;
+
+		// cached dense index, valid if `_epoch` matches container's
+		mutable int _index = -1;
+		mutable uint64_t _epoch = 0;
+
+	protected:
+		bool just_erased() const { return _just_erased; }
+
+		int index() const {
+			if(_epoch != CONT._epoch || _index == -1) {
+				_index = CONT._slots[ HANDLE.a ].index;
+				_epoch = CONT._epoch;
+			}
+			return _index;
+		}
+
+		void set_index(int i) {
+			_index = i;
+			_epoch = CONT._epoch;
+			if(i < CONT.count()) MUT_HANDLE = CONT._handles[i];
+			else MUT_HANDLE.reset();
+		}
+
+		void on_erase() {
+			int i = index();
+			CONT.erase( HANDLE );
+			set_index(i); // now it's the element moved into the hole
+			_just_erased = true;
+		}
+
+		void step(int delta) {
+			set_index( _just_erased ? index() : index() + delta );
+			_just_erased = false;
+		}
+
+		auto& _get_data() const {
+			CONT._check( HANDLE );
+			return CONT._values[ index() ];
+		}
+	};
+
+
+
+
+	//
+	// accessor
+	//
+	template<Const_Flag C>
+	class Accessor : public Accessor_Base<C,Context> {
+		using BASE = Accessor_Base<C,Context>;
+
+	public:
+		using BASE::BASE;
+
+		void erase() {
+			static_assert(C == MUTAB, "called erase() on CONST accessor");
+			DCHECK( !BASE::just_erased() );
+			BASE::on_erase();
+		}
+
+		// O(1) check if the handle is still alive
+		bool exists() const { return CONT.exists( HANDLE ); }
+	};
+
+
+
+
+	//
+	// iterator: dense order
+	//
+	template<Const_Flag C>
+	class Iterator : public Iterator_Base<C,Context> {
+		using BASE = Iterator_Base<C,Context>;
+
+	public:
+		using BASE::BASE;
+
+	private:
+		friend Iterator_Base<C,Context>;
+
+		void _increment() { BASE::step(+1); }
+		void _decrement() { BASE::step(-1); }
+
+	public:
+		bool operator!=(End_Iterator) const { return HANDLE.valid(); }
+	};
+
+
+
+
+
+	class Slot_Map : public Iterable_Base<Slot_Map> {
+	public:
+		using Val = Context::Val;
+		using       Handle = Context::      Handle;
+		using Handle_Small = Context::Handle_Small;
+
+		template<Const_Flag C> using Accessor = Context::Accessor<C>;
+		template<Const_Flag C> using Iterator = Context::Iterator<C>;
+
+	private:
+		friend Reference<MUTAB>;
+		friend Reference<CONST>;
+
+
+		//
+		// data
+		//
+	private:
+		salgo::Dynamic_Array<Val> _values;
+		salgo::Dynamic_Array<Handle> _handles; // handle of each dense element
+		salgo::Dynamic_Array<Slot> _slots;
+
+		int _free_head = -1;
+
+		// bumped when values move (erase), to invalidate cached dense indices
+		uint64_t _epoch = 0;
+
+
+		//
+		// construction
+		//
+	public:
+		Slot_Map() = default;
+
+		Slot_Map(std::initializer_list<Val> il) {
+			reserve( il.size() );
+			for(auto& e : il) emplace(e);
+		}
+
+
+
+		//
+		// element access
+		//
+	public:
+		auto& operator[](Handle handle)       { _check(handle); return _values[ _slots[handle.a].index ]; }
+		auto& operator[](Handle handle) const { _check(handle); return _values[ _slots[handle.a].index ]; }
+
+		auto operator()(Handle handle)       { _check(handle); return Accessor<MUTAB>(this, handle); }
+		auto operator()(Handle handle) const { _check(handle); return Accessor<CONST>(this, handle); }
+
+		auto operator()(First_Tag)       { return _accessor_at(0); }
+		auto operator()(First_Tag) const { return _accessor_at(0); }
+
+		auto operator()(Last_Tag)       { return _accessor_at( count()-1 ); }
+		auto operator()(Last_Tag) const { return _accessor_at( count()-1 ); }
+
+		auto& operator[](First_Tag)       { return _values[0]; }
+		auto& operator[](First_Tag) const { return _values[0]; }
+
+		auto& operator[](Last_Tag)       { return _values[ count()-1 ]; }
+		auto& operator[](Last_Tag) const { return _values[ count()-1 ]; }
+
+		// O(1): false if the element was erased (even if its slot was reused since then)
+		bool exists(Handle handle) const {
+			return handle.valid()  &&  handle.a < _slots.size()  &&  _slots[handle.a].generation == handle.b;
+		}
+
+
+
+		//
+		// modifiers
+		//
+	public:
+		template<class... ARGS>
+		auto emplace(ARGS&&... args) {
+			int slot = _free_head;
+			if(slot != -1) _free_head = _slots[slot].index;
+			else {
+				slot = _slots.size();
+				_slots.emplace_back();
+			}
+
+			auto& s = _slots[slot];
+			++s.generation; // now odd - alive
+			s.index = _values.size();
+
+			Handle handle( H0(slot), s.generation );
+			_values.emplace_back( std::forward<ARGS>(args)... );
+			_handles.emplace_back( handle );
+
+			return Accessor<MUTAB>(this, handle);
+		}
+
+		template<class... ARGS>
+		auto add(ARGS&&... args) { return emplace( std::forward<ARGS>(args)... ); } // alias
+
+
+		// swap-remove: the last value is moved into the hole
+		void erase(Handle handle) {
+			_check(handle);
+
+			int i = _slots[handle.a].index;
+			int last = count() - 1;
+
+			if(i != last) {
+				_values[i].~Val();
+				new(&_values[i]) Val( std::move( _values[last] ) );
+
+				_handles[i] = _handles[last];
+				_slots[ _handles[i].a ].index = i;
+				++_epoch;
+			}
+
+			_values.pop_back();
+			_handles.pop_back();
+
+			auto& s = _slots[handle.a];
+			++s.generation; // now even - dead
+			s.index = _free_head;
+			_free_head = handle.a;
+		}
+
+		// slots are kept, so old handles stay detectable
+		void clear() {
+			while(not_empty()) erase( _handles[ count()-1 ] );
+		}
+
+		void reserve(int capacity) {
+			_values.reserve(capacity);
+			_handles.reserve(capacity);
+			_slots.reserve(capacity);
+		}
+
+
+
+	public:
+		int count() const { return _values.size(); }
+
+		bool  is_empty() const { return count() == 0; }
+		bool not_empty() const { return !is_empty(); }
+
+		// number of slots (alive and free)
+		int domain() const { return _slots.size(); }
+
+
+
+	public:
+		auto begin()       { return _accessor_at(0).iterator(); }
+		auto begin() const { return _accessor_at(0).iterator(); }
+
+		auto end() const { return End_Iterator(); }
+
+
+
+	private:
+		auto _accessor_at(int i) {
+			auto r = Accessor<MUTAB>(this, Handle());
+			r.set_index(i);
+			return r;
+		}
+
+		auto _accessor_at(int i) const {
+			auto r = Accessor<CONST>(this, Handle());
+			r.set_index(i);
+			return r;
+		}
+
+		void _check(Handle handle) const {
+			DCHECK( exists(handle) ) << "stale or invalid Slot_Map handle " << handle;
+			(void)handle;
+		}
+	};
+
+
+
+
+	struct With_Builder : Slot_Map {
+		using BASE = Slot_Map;
+		using BASE::BASE;
+	};
+
+
+}; // struct Context
+
+} // namespace salgo::_::slot_map
+
+#include "helper-macros-off.inc"
+
+
+
+
+
+namespace salgo {
+
+template<class T>
+using Slot_Map = typename _::slot_map::Context<T> :: With_Builder;
+
+} // namespace salgo
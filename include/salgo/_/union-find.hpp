@@ -5,13 +5,16 @@
 namespace salgo::_::union_find {
 
 
-template<class DATA, bool COUNTABLE, bool COUNTABLE_SETS>
+template<class DATA, bool COUNTABLE, bool COUNTABLE_SETS, bool CONCURRENT, bool ROLLBACK>
 struct Params;
 
 
 template<class P>
 struct Node;
 
+template<class P>
+struct Undo_Record;
+
 
 
 template<class P, Const_Flag C>
@@ -30,6 +33,9 @@ struct Context;
 template<class P>
 class Union_Find;
 
+template<class P>
+class Concurrent_Union_Find;
+
 template<class P>
 class With_Builder;
 
@@ -46,7 +52,9 @@ namespace salgo {
 using Union_Find = _::union_find::With_Builder< _::union_find::Params<
 	void, // DATA
 	false, // COUNTABLE
-	false // COUNTABLE_SETS
+	false, // COUNTABLE_SETS
+	false, // CONCURRENT
+	false // ROLLBACK
 >>;
 
 } // namespace salgo
@@ -7,6 +7,12 @@
 #include "add-member.hpp"
 #include "inplace-storage.hpp"
 
+#include <algorithm> // std::min
+#include <atomic>
+#include <memory> // std::unique_ptr
+#include <thread>
+#include <vector>
+
 #include "helper-macros-on.inc"
 
 namespace salgo::_::union_find {
@@ -15,14 +21,19 @@ namespace salgo::_::union_find {
 SALGO_GENERATE_HAS_MEMBER(merge_with);
 
 
-template<class DATA, bool COUNTABLE, bool COUNTABLE_SETS>
+template<class DATA, bool COUNTABLE, bool COUNTABLE_SETS, bool CONCURRENT, bool ROLLBACK>
 struct Params {
 	using Data = DATA;
 	static constexpr bool Countable = COUNTABLE;
 	static constexpr bool Countable_Sets = COUNTABLE_SETS;
+	static constexpr bool Concurrent = CONCURRENT;
+	static constexpr bool Rollback = ROLLBACK;
 
 	static constexpr bool Has_Data = !std::is_same_v<Data, void>;
 
+	// ::ROLLBACK has no path compression, so it always merges by size
+	static constexpr bool Has_Set_Sizes = Countable_Sets || Rollback;
+
 	using Node = union_find::Node<Params>;
 
 	using Allocator = salgo::Dynamic_Array<Node>;
@@ -36,18 +47,23 @@ struct Params {
 
 SALGO_ADD_MEMBER_STORAGE(data);
 SALGO_ADD_MEMBER(_count);
+SALGO_ADD_MEMBER(old_data);
+SALGO_ADD_MEMBER(_undo);
 
 
 
 template<class P>
 struct Node :
 		Add_Storage_data<typename P::Data, P::Has_Data>,
-		Add__count<int, P::Countable_Sets> {
+		Add__count<int, P::Has_Set_Sizes> {
 
 	using DATA_BASE = Add_Storage_data<typename P::Data, P::Has_Data>;
-	using COUNT_BASE = Add__count<int, P::Countable_Sets>;
+	using COUNT_BASE = Add__count<int, P::Has_Set_Sizes>;
 
-	Node() { if constexpr(P::Has_Data) DATA_BASE::data.construct(); }
+	Node() {
+		if constexpr(P::Has_Data) DATA_BASE::data.construct();
+		if constexpr(P::Has_Set_Sizes) COUNT_BASE::_count = 1;
+	}
 
 	Node(Node&& o) = default;
 
@@ -55,14 +71,15 @@ struct Node :
 	Node(ARGS&&... args) {
 		static_assert(P::Has_Data, "if no data, only 0-argument constructor can be used");
 		DATA_BASE::data.construct( std::forward<ARGS>(args)... );
-		if constexpr(P::Countable_Sets) COUNT_BASE::count = 1;
+		if constexpr(P::Has_Set_Sizes) COUNT_BASE::_count = 1;
 	}
 
 	mutable typename P::Handle_Small parent;
 
 	~Node() {
 		if constexpr(P::Has_Data) {
-			if(!parent.valid()) DATA_BASE::data.destruct();
+			// ::ROLLBACK keeps data of merged sets, to restore it on rollback()
+			if(!parent.valid() || P::Rollback) DATA_BASE::data.destruct();
 		}
 	}
 
@@ -78,16 +95,30 @@ struct Node :
 				b.data.get() += DATA_BASE::data.get();
 			}
 
-			DATA_BASE::data.destruct();
+			if constexpr(!P::Rollback) DATA_BASE::data.destruct();
 		}
 
-		if constexpr(P::Countable_Sets) b.count += COUNT_BASE::count;
+		if constexpr(P::Has_Set_Sizes) b._count += COUNT_BASE::_count;
 	}
 };
 
 
 
 
+// ::ROLLBACK - one merge: the old root, and the data of the new root before merging
+template<class P>
+struct Undo_Record : Add_old_data<typename P::Data, P::Has_Data> {
+	using BASE = Add_old_data<typename P::Data, P::Has_Data>;
+
+	template<class... ARGS>
+	Undo_Record(typename P::Handle_Small c, ARGS&&... args) : BASE(std::forward<ARGS>(args)...), child(c) {}
+
+	typename P::Handle_Small child;
+};
+
+
+
+
 template<class P, Const_Flag C>
 class Accessor : public Accessor_Base<C,Context<P>> {
 	using BASE = Accessor_Base<C,Context<P>>;
@@ -111,13 +142,18 @@ public:
 
 		NODE.parent = b;
 
-		if constexpr(P::Countable_Sets) {
-			DCHECK_LE(NODE.count, b.count()) <<
+		if constexpr(P::Has_Set_Sizes) {
+			DCHECK_LE(NODE._count, b.count()) <<
 				"a.merge_with(b): can't merge bigger to smaller. "
 				"either use b.merge_with(a), or use Union_Find::merge(a,b) "
 				"to check for sizes during runtime (if have Countable_Sets flag)";
 		}
 
+		if constexpr(P::Rollback) {
+			if constexpr(P::Has_Data) CONT._undo.emplace_back( HANDLE, ALLOC[ b.handle() ].data.get() );
+			else CONT._undo.emplace_back( HANDLE );
+		}
+
 		NODE.merge_with( ALLOC[ b.handle() ] );
 
 		//ALLOC( HANDLE ).erase();
@@ -131,6 +167,13 @@ public:
 		return *this;
 	}
 
+	// number of elements in the set
+	int count() const {
+		static_assert(P::Has_Set_Sizes, "set sizes unknown if not Countable_Sets");
+		_update();
+		return NODE._count;
+	}
+
 	template<Const_Flag CC>
 	bool operator==(const Accessor<P,CC>& o) const { _update(); o._update(); return BASE::operator==(o); }
 
@@ -191,9 +234,11 @@ struct Context {
 template<class P>
 class Union_Find : protected P,
 		private P::Allocator,
-		private Add__count<int, P::Countable> {
+		private Add__count<int, P::Countable>,
+		private Add__undo<salgo::Dynamic_Array<Undo_Record<P>>, P::Rollback> {
 
 	using COUNT_BASE = Add__count<int, P::Countable>;
+	using UNDO_BASE = Add__undo<salgo::Dynamic_Array<Undo_Record<P>>, P::Rollback>;
 
 	using typename P::Index;
 	using typename P::Handle;
@@ -243,19 +288,50 @@ public:
 		return Accessor<MUTAB>(this, handle);
 	}
 
-	auto merge(Index _a, Index b) {
-		auto a = operator()(_a);
-
-		if constexpr(P::Countable_Sets) {
-			if(_alloc()[a].count > _alloc()[b].count) std::swap(a,b);
+	auto merge(Index a, Index b) {
+		if constexpr(P::Has_Set_Sizes) {
+			if(_alloc()[ _find(a) ]._count > _alloc()[ _find(b) ]._count) std::swap(a,b);
 		}
 
-		a.merge_with( b );
+		operator()(a).merge_with( b );
 
 		return Accessor<MUTAB>(this, b);
 	}
 
 
+	//
+	// ::ROLLBACK - undo merges in LIFO order:
+	//
+	//   auto cp = uf.checkpoint();
+	//   uf.merge(a, b); ...
+	//   uf.rollback(cp);
+	//
+	int checkpoint() const {
+		static_assert(P::Rollback, "enable with ::ROLLBACK");
+		return UNDO_BASE::_undo.size();
+	}
+
+	void rollback(int checkpoint) {
+		static_assert(P::Rollback, "enable with ::ROLLBACK");
+		DCHECK_GE(checkpoint, 0);
+		DCHECK_LE(checkpoint, UNDO_BASE::_undo.size()) << "rollback() to a checkpoint that was already rolled back";
+
+		auto& undo = UNDO_BASE::_undo;
+		while(undo.size() > checkpoint) {
+			auto& record = undo[LAST];
+			auto& child = _alloc()[ record.child ];
+			auto& root = _alloc()[ child.parent ];
+
+			child.parent.reset();
+			root._count -= child._count;
+			if constexpr(P::Has_Data) root.data.get() = std::move( record.old_data );
+			if constexpr(P::Countable) ++COUNT_BASE::_count;
+
+			undo.pop_back();
+		}
+	}
+
+
 	auto domain() const { return _alloc().domain(); }
 	auto count()  const {
 		static_assert(P::Countable, "count unknown if not Countable");
@@ -269,6 +345,9 @@ private:
 		Handle root = handle;
 		while(_alloc()[root].parent.valid()) root = _alloc()[root].parent;
 
+		// no path compression, so merges can be undone
+		if constexpr(P::Rollback) return root;
+
 		while(handle != root) {
 			auto parent = _alloc()[handle].parent;
 			_alloc()[handle].parent = root;
@@ -296,9 +375,115 @@ private:
 
 
 
+//
+// fixed number of elements, `find()`, `merge()` and `same()` can be called from many threads at once
+//
+// each element is a single atomic parent index (roots point to themselves):
+// * roots are linked by index - the bigger one under the smaller one, using CAS (retried if a root changed meanwhile)
+// * `find()` does path splitting - every visited element is CAS-ed to its grandparent, failed CAS is just ignored
+//
+// the parent of an element always has a smaller index, so there are no cycles even during concurrent merges
+//
 template<class P>
-class With_Builder : public Union_Find<P> {
-	using BASE = Union_Find<P>;
+class Concurrent_Union_Find : protected P {
+	static_assert(!P::Has_Data, "::CONCURRENT does not support ::DATA");
+	static_assert(!P::Countable && !P::Countable_Sets, "::CONCURRENT does not support ::COUNTABLE or ::COUNTABLE_SETS");
+	static_assert(!P::Rollback, "::CONCURRENT does not support ::ROLLBACK");
+
+private:
+	std::unique_ptr<std::atomic<int>[]> _parent;
+	int _domain = 0;
+
+public:
+	Concurrent_Union_Find() = default;
+
+	explicit Concurrent_Union_Find(int initial_size)
+			: _parent( new std::atomic<int>[initial_size] ), _domain( initial_size ) {
+		for(int i=0; i<initial_size; ++i) _parent[i].store(i, std::memory_order_relaxed);
+	}
+
+
+public:
+	int find(int i) const {
+		_check_bounds(i);
+		for(;;) {
+			int parent = _parent[i].load(std::memory_order_acquire);
+			int grandparent = _parent[parent].load(std::memory_order_acquire);
+			if(parent == grandparent) return parent;
+
+			int expected = parent;
+			_parent[i].compare_exchange_weak(expected, grandparent, std::memory_order_release, std::memory_order_relaxed);
+			i = parent;
+		}
+	}
+
+	// false if already in the same set
+	bool merge(int a, int b) {
+		for(;;) {
+			a = find(a);
+			b = find(b);
+			if(a == b) return false;
+
+			if(a < b) std::swap(a,b);
+
+			int expected = a;
+			if(_parent[a].compare_exchange_strong(expected, b, std::memory_order_acq_rel)) return true;
+		}
+	}
+
+	bool same(int a, int b) const {
+		for(;;) {
+			a = find(a);
+			b = find(b);
+			if(a == b) return true;
+
+			// `a` still a root - the sets were different at this point
+			if(_parent[a].load(std::memory_order_acquire) == a) return false;
+		}
+	}
+
+
+	//
+	// merge endpoints of all `edges` (random-access range of pairs), using `num_threads` threads
+	//
+	template<class EDGES>
+	void merge_edges(const EDGES& edges, int num_threads = std::thread::hardware_concurrency()) {
+		int num_edges = (int)edges.size();
+		num_threads = std::max(1, std::min(num_threads, num_edges / Min_Edges_Per_Thread));
+
+		auto run = [&](int begin, int end) {
+			for(int i=begin; i<end; ++i) merge( edges[i].first, edges[i].second );
+		};
+
+		std::vector<std::thread> threads;
+		for(int t=1; t<num_threads; ++t) {
+			threads.emplace_back( run, (long long)num_edges * t / num_threads, (long long)num_edges * (t+1) / num_threads );
+		}
+		run(0, num_edges / num_threads);
+
+		for(auto& thread : threads) thread.join();
+	}
+
+	static constexpr int Min_Edges_Per_Thread = 1<<12;
+
+
+	int domain() const { return _domain; }
+
+
+private:
+	void _check_bounds(int i) const {
+		DCHECK_GE(i, 0) << "index out of bounds";
+		DCHECK_LT(i, _domain) << "index out of bounds";
+	}
+};
+
+
+
+
+
+template<class P>
+class With_Builder : public std::conditional_t<P::Concurrent, Concurrent_Union_Find<P>, Union_Find<P>> {
+	using BASE = std::conditional_t<P::Concurrent, Concurrent_Union_Find<P>, Union_Find<P>>;
 
 public:
 	using BASE::BASE;
@@ -306,13 +491,21 @@ public:
 	using typename P::Data;
 	using P::Countable;
 	using P::Countable_Sets;
+	using P::Concurrent;
+	using P::Rollback;
 
 	template<class X>
-	using DATA = With_Builder< Params<X, Countable, Countable_Sets>>;
+	using DATA = With_Builder< Params<X, Countable, Countable_Sets, Concurrent, Rollback>>;
+
+	using COUNTABLE = With_Builder< Params<Data, true, Countable_Sets, Concurrent, Rollback>>;
+
+	using COUNTABLE_SETS = With_Builder< Params<Data, Countable, true, Concurrent, Rollback>>;
 
-	using COUNTABLE = With_Builder< Params<Data, true, Countable_Sets>>;
+	// thread-safe, fixed size - see Concurrent_Union_Find
+	using CONCURRENT = With_Builder< Params<Data, Countable, Countable_Sets, true, Rollback>>;
 
-	using COUNTABLE_SETS = With_Builder< Params<Data, Countable, true>>;
+	// no path compression, merges can be undone with checkpoint() / rollback()
+	using ROLLBACK = With_Builder< Params<Data, Countable, Countable_Sets, Concurrent, true>>;
 };
 
 
@@ -10,6 +10,8 @@
 
 #include <glog/logging.h>
 
+#include <utility> // std::as_const
+
 #include "helper-macros-on.inc"
 
 namespace salgo::_::unordered_array {
@@ -242,6 +244,65 @@ public:
 
 
 
+	//
+	// PRED is (const Val&) -> bool
+	//
+	// erase matching elements; order of remaining elements is not preserved
+	//
+	// returns number of erased elements
+	//
+	template<class PRED>
+	int erase_if(PRED&& pred) {
+		if constexpr(std::is_trivially_copyable_v<Val>) {
+			// stream compaction is fastest and happens to keep order
+			return v.erase_if( std::forward<PRED>(pred) );
+		}
+		else {
+			int erased = 0;
+			for(int i=0; i<size(); ) {
+				if(!pred( std::as_const(v[i]) )) {
+					++i;
+					continue;
+				}
+
+				// fill the hole with last element
+				if(i != size()-1) {
+					v[i].~Val();
+					new(&v[i]) Val( std::move( v[ size()-1 ] ) );
+				}
+				v.pop_back();
+				++erased;
+			}
+			return erased;
+		}
+	}
+
+
+	//
+	// move matching elements to the front
+	//
+	// returns number of matching elements
+	//
+	template<class PRED>
+	int partition(PRED&& pred) {
+		if constexpr(std::is_trivially_copyable_v<Val>) {
+			return v.partition( std::forward<PRED>(pred) );
+		}
+		else {
+			int fr = 0;
+			int to = size();
+			for(;;) {
+				while(fr < to && pred( std::as_const(v[fr]) )) ++fr;
+				while(fr < to && !pred( std::as_const(v[to-1]) )) --to;
+				if(fr >= to) break;
+				_swap( fr++, --to );
+			}
+			return fr;
+		}
+	}
+
+
+
 public:
 	auto before_begin() const { return Before_Begin_Iterator<P>(); }
 
@@ -255,6 +316,15 @@ private:
 	auto _accessor(Index handle)       { return Accessor<MUTAB>(this, handle); }
 	auto _accessor(Index handle) const { return Accessor<CONST>(this, handle); }
 
+	// only requires move-construction
+	void _swap(int a, int b) {
+		Val tmp( std::move(v[a]) );
+		v[a].~Val();
+		new(&v[a]) Val( std::move(v[b]) );
+		v[b].~Val();
+		new(&v[b]) Val( std::move(tmp) );
+	}
+
 private:
 	void _check(Handle handle) const {
 		DCHECK( 0 <= handle && handle < v.size() ) << "index " << handle << " out of bounds";
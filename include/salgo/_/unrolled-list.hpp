@@ -0,0 +1,767 @@
+#pragma once
+
+/*
+
+Unrolled doubly-linked list: each node holds up to K elements.
+
+Inside a node, elements don't move - their logical order is kept in a small `order` array,
+and free slots are tracked using an occupancy bitmask.
+
+Elements are moved between nodes only when a full node is split, or when neighboring
+underfull nodes are merged. Because of that, handles are element IDs allocated separately,
+pointing to the current element location (node, slot).
+
+Accessors and iterators cache the location, so traversal doesn't touch the ID table.
+The cache is invalidated when any element moves between nodes.
+
+*/
+
+#include "add-member.hpp"
+#include "inplace-storage.hpp"
+#include "accessors.hpp"
+#include "const-flag.hpp"
+#include "subscript-tags.hpp"
+#include "iterable-base.hpp"
+
+#include <cstdint>
+#include <type_traits>
+
+
+#include "helper-macros-on.inc"
+
+namespace salgo::_::unrolled_list {
+
+
+SALGO_ADD_MEMBER(num_existing);
+
+
+
+
+
+
+
+
+
+template<class _VAL, class _ALLOCATOR, bool _COUNTABLE, int _K>
+struct Context {
+
+	//
+	// forward declarations
+	//
+	struct Node;
+	struct Location;
+	template<Const_Flag C> class Accessor;
+	template<Const_Flag C> class Iterator;
+	class List;
+	using Container = List;
+
+
+
+
+	//
+	// template arguments
+	//
+	using Val = _VAL;
+	static constexpr bool Countable = _COUNTABLE;
+	static constexpr int K = _K;
+
+	static_assert(K >= 2 && K <= 64, "UNROLLED<K> requires 2 <= K <= 64");
+
+
+
+
+	using Node_Allocator     = typename _ALLOCATOR :: template VAL<Node>;
+	using Location_Allocator = typename _ALLOCATOR :: template VAL<Location>;
+
+	using       Handle = typename Location_Allocator ::       Handle;
+	using Handle_Small = typename Location_Allocator :: Handle_Small;
+
+	using Node_Handle = typename Node_Allocator :: Handle_Small;
+
+	using Mask = std::conditional_t<(K > 32), uint64_t, uint32_t>;
+	using Slot = uint8_t;
+
+	static constexpr Mask bit(int slot) { return Mask(1) << slot; }
+
+	// returns free slot in a non-full node
+	static int free_slot(Mask mask) { return __builtin_ctzll( ~uint64_t(mask) ); }
+
+
+
+
+	struct Location {
+		Node_Handle node;
+		Slot slot = 0;
+	};
+
+
+
+
+	template<Const_Flag C>
+	class Reference : public Reference_Base<C,Context> {
+		using BASE = Reference_Base<C,Context>;
+		friend Reference_Base<C,Context>;
+		friend List;
+
+	public:
+		using BASE::BASE;
+
+	private:
+		Handle_Small _prev;
+		Handle_Small _next;
+		bool _just_erased = false;
+
+		// cached element location, valid if `_epoch` matches container's
+		mutable Location _loc;
+		mutable uint64_t _epoch = 0;
+
+	protected:
+		bool just_erased() const { return _just_erased; }
+
+		void on_erase() {
+			_next = CONT._next_id( HANDLE );
+			_prev = CONT._prev_id( HANDLE );
+			_just_erased = true;
+		}
+
+		void reset() {
+			_prev.reset();
+			_next.reset();
+			_just_erased = false;
+		}
+
+		auto get_next() {
+			if(_just_erased) return _next;
+			return CONT._next_id( location().node, location().slot );
+		}
+
+		auto get_prev() {
+			if(_just_erased) return _prev;
+			return CONT._prev_id( location().node, location().slot );
+		}
+
+		// iterate, keeping location cache up to date
+		void step_next() {
+			if(_just_erased) {
+				MUT_HANDLE = _next;
+				_loc.node.reset();
+			}
+			else MUT_HANDLE = CONT._next_id( location().node, location().slot, &_loc );
+			reset();
+		}
+
+		void step_prev() {
+			if(_just_erased) {
+				MUT_HANDLE = _prev;
+				_loc.node.reset();
+			}
+			else MUT_HANDLE = CONT._prev_id( location().node, location().slot, &_loc );
+			reset();
+		}
+
+		const Location& location() const {
+			if(_epoch != CONT._epoch || !_loc.node.valid()) {
+				_loc = CONT._locs()[ HANDLE ];
+				_epoch = CONT._epoch;
+			}
+			return _loc;
+		}
+
+		void set_location(const Location& loc) {
+			_loc = loc;
+			_epoch = CONT._epoch;
+		}
+
+		auto& _get_data() const {
+			auto& loc = location();
+			return CONT._nodes()[ loc.node ].vals[ loc.slot ].get();
+		}
+	};
+
+
+
+
+	//
+	// accessor
+	//
+	template<Const_Flag C>
+	class Accessor : public Accessor_Base<C,Context> {
+		using BASE = Accessor_Base<C,Context>;
+
+	public:
+		using BASE::BASE;
+
+		void erase() {
+			static_assert(C == MUTAB, "called erase() on CONST accessor");
+			DCHECK( HANDLE.valid() && !BASE::just_erased() );
+			BASE::on_erase();
+			CONT._erase( HANDLE );
+		}
+
+		template<class... ARGS>
+		auto emplace_before(ARGS&&... args) {
+			static_assert(C == MUTAB, "called on CONST accessor");
+			DCHECK( HANDLE.valid() && !BASE::just_erased() );
+
+			auto loc = BASE::location();
+			int pos = CONT._nodes()[ loc.node ].rank[ loc.slot ];
+			return CONT._emplace( loc.node, pos, std::forward<ARGS>(args)... );
+		}
+
+		template<class... ARGS>
+		auto emplace_after(ARGS&&... args) {
+			static_assert(C == MUTAB, "called on CONST accessor");
+			DCHECK( HANDLE.valid() && !BASE::just_erased() );
+
+			auto loc = BASE::location();
+			int pos = CONT._nodes()[ loc.node ].rank[ loc.slot ] + 1;
+			return CONT._emplace( loc.node, pos, std::forward<ARGS>(args)... );
+		}
+
+
+		auto next()       { return CONT( BASE::get_next() ); }
+		auto next() const { return CONT( BASE::get_next() ); }
+
+		auto prev()       { return CONT( BASE::get_prev() ); }
+		auto prev() const { return CONT( BASE::get_prev() ); }
+
+
+		auto next_in_cycle()       {
+			auto r = CONT( BASE::get_next() );
+			return r.found() ? r : CONT(FIRST);
+		}
+
+		auto next_in_cycle() const {
+			auto r = CONT( BASE::get_next() );
+			return r.found() ? r : CONT(FIRST);
+		}
+
+		auto prev_in_cycle()       {
+			auto r = CONT( BASE::get_prev() );
+			return r.found() ? r : CONT(LAST);
+		}
+
+		auto prev_in_cycle() const {
+			auto r = CONT( BASE::get_prev() );
+			return r.found() ? r : CONT(LAST);
+		}
+
+
+		bool valid() const { return HANDLE.valid(); }
+		bool not_valid() const { return ! valid(); }
+	};
+
+
+
+
+	class End_Iterator {};
+
+
+
+	//
+	// iterator
+	//
+	template<Const_Flag C>
+	class Iterator : public Iterator_Base<C,Context> {
+		using BASE = Iterator_Base<C,Context>;
+
+	public:
+		using BASE::BASE;
+
+	private:
+		friend BASE;
+
+		void _increment() {
+			DCHECK( HANDLE.valid() ) << "followed broken list link";
+			BASE::step_next();
+		}
+
+		void _decrement() {
+			DCHECK( HANDLE.valid() ) << "followed broken list link";
+			BASE::step_prev();
+		}
+
+	public:
+		bool operator!=(End_Iterator) const { return HANDLE.valid(); }
+	};
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+	struct Node {
+		Mask mask = 0; // occupied slots
+		Slot count = 0;
+
+		Slot order[K]; // slots in list order (first `count` are valid)
+		Slot rank[K];  // position of each occupied slot in `order`
+
+		Handle_Small ids[K];
+
+		Node_Handle next;
+		Node_Handle prev;
+
+		salgo::Inplace_Storage<Val> vals[K];
+
+		Node() = default;
+
+		Node(const Node& o) : mask(o.mask), count(o.count), next(o.next), prev(o.prev) {
+			_copy_meta(o);
+			for(int i=0; i<count; ++i) vals[ order[i] ].construct( o.vals[ order[i] ].get() );
+		}
+
+		Node(Node&& o) : mask(o.mask), count(o.count), next(o.next), prev(o.prev) {
+			_copy_meta(o);
+			for(int i=0; i<count; ++i) vals[ order[i] ].construct( std::move( o.vals[ order[i] ].get() ) );
+		}
+
+		~Node() {
+			for(int i=0; i<count; ++i) vals[ order[i] ].destruct();
+		}
+
+	private:
+		void _copy_meta(const Node& o) {
+			for(int i=0; i<count; ++i) {
+				auto s = o.order[i];
+				order[i] = s;
+				rank[s] = i;
+				ids[s] = o.ids[s];
+			}
+		}
+	};
+
+
+
+
+
+
+
+
+	class List :
+			private Add_num_existing<int, Countable>,
+			public Iterable_Base<List> {
+
+		using NUM_EXISTING_BASE = Add_num_existing<int, Countable>;
+
+	public:
+		using Val = Context::Val;
+		static constexpr bool Is_Countable = Context::Countable;
+		static constexpr int Unrolled = K;
+
+		using       Handle = Context::      Handle;
+		using Handle_Small = Context::Handle_Small;
+
+		template<Const_Flag C> using Accessor = Context::Accessor<C>;
+		template<Const_Flag C> using Iterator = Context::Iterator<C>;
+
+
+	private:
+		friend Accessor<MUTAB>;
+		friend Accessor<CONST>;
+
+		friend Iterator<MUTAB>;
+		friend Iterator<CONST>;
+
+		friend Reference<MUTAB>;
+		friend Reference<CONST>;
+
+
+		//
+		// data
+		//
+	private:
+		Node_Allocator _node_alloc;
+		Location_Allocator _loc_alloc;
+
+		Node_Handle _front;
+		Node_Handle _back;
+
+		// incremented each time elements are moved between nodes
+		uint64_t _epoch = 1;
+
+	private:
+		auto& _nodes()       { return _node_alloc; }
+		auto& _nodes() const { return _node_alloc; }
+
+		auto& _locs()       { return _loc_alloc; }
+		auto& _locs() const { return _loc_alloc; }
+
+
+
+		//
+		// construction
+		//
+	public:
+		List() = default;
+
+		List(int size) {
+			for(int i=0; i<size; ++i) {
+				emplace_back();
+			}
+		}
+
+		List(std::initializer_list<Val> il) {
+			for(auto& e : il) emplace_back(e);
+		}
+
+		~List() {
+			_destruct_all();
+		}
+
+		void clear() {
+			_destruct_all();
+
+			_front.reset();
+			_back.reset();
+			if constexpr(Countable) NUM_EXISTING_BASE::num_existing = 0;
+		}
+
+
+
+	public:
+		auto operator()(Handle handle)       { return Accessor<MUTAB>(this, handle); }
+		auto operator()(Handle handle) const { return Accessor<CONST>(this, handle); }
+
+		auto& operator[](Handle handle)       { auto& loc = _locs()[handle]; return _nodes()[loc.node].vals[loc.slot].get(); }
+		auto& operator[](Handle handle) const { auto& loc = _locs()[handle]; return _nodes()[loc.node].vals[loc.slot].get(); }
+
+		auto operator()(First_Tag)       { return operator()( _first_id() ); }
+		auto operator()(First_Tag) const { return operator()( _first_id() ); }
+		auto& operator[](First_Tag)       { return operator[]( _first_id() ); }
+		auto& operator[](First_Tag) const { return operator[]( _first_id() ); }
+
+		auto operator()(Last_Tag)       { return operator()( _last_id() ); }
+		auto operator()(Last_Tag) const { return operator()( _last_id() ); }
+		auto& operator[](Last_Tag)       { return operator[]( _last_id() ); }
+		auto& operator[](Last_Tag) const { return operator[]( _last_id() ); }
+
+		auto operator()(Any_Tag)       { return operator()(FIRST); }
+		auto operator()(Any_Tag) const { return operator()(FIRST); }
+		auto& operator[](Any_Tag)       { return operator[](FIRST); }
+		auto& operator[](Any_Tag) const { return operator[](FIRST); }
+
+		void erase(Handle handle) { operator()(handle).erase(); }
+
+
+
+	public:
+		template<class... ARGS>
+		auto emplace_front(ARGS&&... args) {
+			if(is_empty()) return _emplace_into_empty( std::forward<ARGS>(args)... );
+			return _emplace( _front, 0, std::forward<ARGS>(args)... );
+		}
+
+		template<class... ARGS>
+		auto emplace_back(ARGS&&... args) {
+			if(is_empty()) return _emplace_into_empty( std::forward<ARGS>(args)... );
+			return _emplace( _back, _nodes()[_back].count, std::forward<ARGS>(args)... );
+		}
+
+
+
+	public:
+		int count() const {
+			static_assert(Countable, "count() called on non-countable List");
+			return NUM_EXISTING_BASE::num_existing;
+		}
+
+		bool is_empty() const { return !_front.valid(); }
+		bool not_empty() const { return !is_empty(); }
+
+
+
+	public:
+		auto begin() {
+			return Iterator<MUTAB>(this, _first_id());
+		}
+
+		auto begin() const {
+			return Iterator<CONST>(this, _first_id());
+		}
+
+		auto end() const { return End_Iterator(); }
+
+
+
+
+		//
+		// implementation
+		//
+	private:
+		Handle_Small _first_id() const {
+			if(!_front.valid()) return {};
+			auto& n = _nodes()[_front];
+			return n.ids[ n.order[0] ];
+		}
+
+		Handle_Small _last_id() const {
+			if(!_back.valid()) return {};
+			auto& n = _nodes()[_back];
+			return n.ids[ n.order[ n.count-1 ] ];
+		}
+
+
+		// optionally updates `loc` to the location of the result
+		Handle_Small _next_id(Node_Handle nh, Slot slot, Location* loc = nullptr) const {
+			auto* n = &_nodes()[nh];
+			int pos = n->rank[slot] + 1;
+			if(pos == n->count) {
+				nh = n->next;
+				if(!nh.valid()) return {};
+				n = &_nodes()[nh];
+				pos = 0;
+			}
+			slot = n->order[pos];
+			if(loc) *loc = Location{nh, slot};
+			return n->ids[slot];
+		}
+
+		Handle_Small _prev_id(Node_Handle nh, Slot slot, Location* loc = nullptr) const {
+			auto* n = &_nodes()[nh];
+			int pos = n->rank[slot] - 1;
+			if(pos < 0) {
+				nh = n->prev;
+				if(!nh.valid()) return {};
+				n = &_nodes()[nh];
+				pos = n->count - 1;
+			}
+			slot = n->order[pos];
+			if(loc) *loc = Location{nh, slot};
+			return n->ids[slot];
+		}
+
+		Handle_Small _next_id(Handle h) const { auto& loc = _locs()[h]; return _next_id(loc.node, loc.slot); }
+		Handle_Small _prev_id(Handle h) const { auto& loc = _locs()[h]; return _prev_id(loc.node, loc.slot); }
+
+
+
+		template<class... ARGS>
+		auto _emplace_into_empty(ARGS&&... args) {
+			DCHECK(!_front.valid());
+			DCHECK(!_back.valid());
+			_front = _back = _nodes().construct().handle();
+			return _emplace( _front, 0, std::forward<ARGS>(args)... );
+		}
+
+
+		// construct new element at position `pos` in node `nh`
+		template<class... ARGS>
+		auto _emplace(Node_Handle nh, int pos, ARGS&&... args) {
+			if(_nodes()[nh].count == K) {
+				auto& n = _nodes()[nh];
+
+				if(pos == K) {
+					// append: use next node, or create a new one
+					if(n.next.valid() && _nodes()[n.next].count < K) nh = n.next;
+					else nh = _new_node_after(nh);
+					pos = 0;
+				}
+				else if(pos == 0) {
+					// prepend: use previous node, or create a new one
+					if(n.prev.valid() && _nodes()[n.prev].count < K) {
+						nh = n.prev;
+						pos = _nodes()[nh].count;
+					}
+					else nh = _new_node_before(nh);
+				}
+				else {
+					// split
+					auto mh = _new_node_after(nh);
+					_move_tail(nh, K/2, mh);
+					if(pos > K/2) {
+						nh = mh;
+						pos -= K/2;
+					}
+				}
+			}
+
+			auto& n = _nodes()[nh];
+			DCHECK_LT(n.count, K);
+			DCHECK_LE(pos, n.count);
+
+			int slot = free_slot(n.mask);
+			n.vals[slot].construct( std::forward<ARGS>(args)... );
+			n.mask |= bit(slot);
+
+			for(int i=n.count; i>pos; --i) {
+				n.order[i] = n.order[i-1];
+				n.rank[ n.order[i] ] = i;
+			}
+			n.order[pos] = slot;
+			n.rank[slot] = pos;
+			++n.count;
+
+			Handle id = _locs().construct( Location{nh, (Slot)slot} ).handle();
+			n.ids[slot] = id;
+
+			if constexpr(Countable) ++NUM_EXISTING_BASE::num_existing;
+
+			auto r = Accessor<MUTAB>(this, id);
+			static_cast<Reference<MUTAB>&>(r).set_location( Location{nh, (Slot)slot} );
+			return r;
+		}
+
+
+		void _erase(Handle h) {
+			auto loc = _locs()[h];
+			auto& n = _nodes()[loc.node];
+
+			n.vals[loc.slot].destruct();
+			n.mask &= ~bit(loc.slot);
+
+			for(int i=n.rank[loc.slot]; i+1<n.count; ++i) {
+				n.order[i] = n.order[i+1];
+				n.rank[ n.order[i] ] = i;
+			}
+			--n.count;
+
+			_locs()(h).destruct();
+
+			if constexpr(Countable) --NUM_EXISTING_BASE::num_existing;
+
+			if(n.count == 0) _unlink(loc.node);
+			else _merge_neighbors(loc.node);
+		}
+
+
+		// keep nodes at least ~1/4 full on average
+		void _merge_neighbors(Node_Handle nh) {
+			auto& n = _nodes()[nh];
+
+			if(n.next.valid() && n.count + _nodes()[n.next].count <= K/2) {
+				auto mh = n.next;
+				_move_tail(mh, 0, nh);
+				_unlink(mh);
+			}
+			else if(n.prev.valid() && _nodes()[n.prev].count + n.count <= K/2) {
+				_move_tail(nh, 0, n.prev);
+				_unlink(nh);
+			}
+		}
+
+
+		// move elements from positions [from, count) of `src` to the end of `dst`
+		void _move_tail(Node_Handle src_handle, int from, Node_Handle dst_handle) {
+			auto& src = _nodes()[src_handle];
+			auto& dst = _nodes()[dst_handle];
+			DCHECK_LE(dst.count + src.count - from, K);
+
+			for(int i=from; i<src.count; ++i) {
+				int s = src.order[i];
+				int d = free_slot(dst.mask);
+
+				dst.vals[d].construct( std::move( src.vals[s].get() ) );
+				src.vals[s].destruct();
+
+				src.mask &= ~bit(s);
+				dst.mask |= bit(d);
+
+				dst.order[ dst.count ] = d;
+				dst.rank[d] = dst.count++;
+
+				dst.ids[d] = src.ids[s];
+				_locs()[ dst.ids[d] ] = Location{dst_handle, (Slot)d};
+			}
+
+			src.count = from;
+			++_epoch;
+		}
+
+
+		Node_Handle _new_node_after(Node_Handle nh) {
+			Node_Handle mh = _nodes().construct_near(nh).handle();
+			auto& n = _nodes()[nh];
+			auto& m = _nodes()[mh];
+
+			m.prev = nh;
+			m.next = n.next;
+			if(n.next.valid()) _nodes()[n.next].prev = mh;
+			else _back = mh;
+			n.next = mh;
+
+			return mh;
+		}
+
+		Node_Handle _new_node_before(Node_Handle nh) {
+			auto prv = _nodes()[nh].prev;
+			if(prv.valid()) return _new_node_after(prv);
+
+			Node_Handle mh = _nodes().construct_near(nh).handle();
+			_nodes()[mh].next = nh;
+			_nodes()[nh].prev = mh;
+			_front = mh;
+			return mh;
+		}
+
+		void _unlink(Node_Handle nh) {
+			auto& n = _nodes()[nh];
+			DCHECK_EQ(0, n.count);
+
+			if(n.prev.valid()) _nodes()[n.prev].next = n.next;
+			else _front = n.next;
+
+			if(n.next.valid()) _nodes()[n.next].prev = n.prev;
+			else _back = n.prev;
+
+			_nodes()(nh).destruct();
+		}
+
+
+		void _destruct_all() {
+			for(auto nh = _front; nh.valid(); ) {
+				auto& n = _nodes()[nh];
+				for(int i=0; i<n.count; ++i) _locs()( n.ids[ n.order[i] ] ).destruct();
+				auto next = n.next;
+				_nodes()(nh).destruct();
+				nh = next;
+			}
+		}
+	};
+
+
+
+
+
+
+
+	struct With_Builder : List {
+		using BASE = List;
+		using BASE::BASE;
+
+		template<class NEW_ALLOCATOR>
+		using ALLOCATOR =
+			typename Context<Val, NEW_ALLOCATOR, Countable, K> :: With_Builder;
+
+		using COUNTABLE =
+			typename Context<Val, _ALLOCATOR, true, K> :: With_Builder;
+
+		using FULL_BLOWN =
+			typename Context<Val, _ALLOCATOR, true, K> :: With_Builder;
+
+		template<int NEW_K>
+		using UNROLLED =
+			typename Context<Val, _ALLOCATOR, Countable, NEW_K> :: With_Builder;
+	};
+
+
+
+
+}; // struct Context
+
+
+} // salgo::_::unrolled_list
+
+
+
+#include "helper-macros-off.inc"
+
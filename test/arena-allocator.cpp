@@ -0,0 +1,135 @@
+#include "common.hpp"
+
+#include <salgo/alloc/arena-allocator>
+#include <salgo/list>
+#include <salgo/hash-table>
+
+#include <gtest/gtest.h>
+
+#include <utility>
+#include <vector>
+
+using namespace salgo;
+
+
+
+TEST(Arena_Allocator, simple) {
+	alloc::Arena_Allocator<int> alloc;
+
+	std::vector< decltype(alloc)::Handle > handles;
+	for(int i=0; i<100000; ++i) {
+		handles.emplace_back( alloc.construct(i).handle() );
+	}
+
+	for(int i=0; i<100000; ++i) EXPECT_EQ(i, alloc[ handles[i] ]);
+
+	// small handles
+	decltype(alloc)::Handle_Small small = handles[77777];
+	EXPECT_EQ(77777, alloc[small]);
+}
+
+
+
+TEST(Arena_Allocator, destructors) {
+	using T = Movable;
+	T::reset();
+
+	{
+		alloc::Arena_Allocator<T> alloc;
+		auto a = alloc.construct(1);
+		alloc.construct(2);
+		a.destruct();
+	}
+
+	// destruct() calls the destructor, the arena itself doesn't
+	EXPECT_EQ(2, T::constructors());
+	EXPECT_EQ(1, T::destructors());
+}
+
+
+
+TEST(Arena_Allocator, reset) {
+	alloc::Arena_Allocator<long long> alloc;
+
+	for(int i=0; i<100000; ++i) alloc.construct(i);
+	auto capacity = alloc.arena().capacity();
+
+	// memory is reused after reset
+	for(int round=0; round<10; ++round) {
+		alloc.reset();
+		auto h = alloc.construct(round).handle();
+		for(int i=0; i<100000; ++i) alloc.construct(i);
+
+		EXPECT_EQ(round, alloc[h]);
+		EXPECT_EQ(capacity, alloc.arena().capacity());
+	}
+
+	alloc.release();
+	EXPECT_EQ(0, alloc.arena().capacity());
+}
+
+
+
+TEST(Arena_Allocator, move) {
+	alloc::Arena_Allocator<int> a;
+	auto h = a.construct(123).handle();
+
+	alloc::Arena_Allocator<int> b;
+	b = std::move(a);
+	EXPECT_EQ(123, b[h]);
+	EXPECT_EQ(0, a.arena().capacity());
+}
+
+
+
+TEST(Arena_Allocator, list) {
+	List<int> ::COUNTABLE ::ALLOCATOR< alloc::Arena_Allocator<int> > list;
+	for(int i=0; i<1000; ++i) list.emplace_back(i);
+
+	int expected = 0;
+	for(auto& e : list) EXPECT_EQ(expected++, e);
+
+	list.clear();
+	EXPECT_TRUE(list.is_empty());
+	EXPECT_EQ(0, list.count());
+
+	list.emplace_back(5);
+	EXPECT_EQ(5, list[FIRST]);
+}
+
+
+
+namespace {
+	struct Tag {};
+}
+
+TEST(Arena_Allocator, shared) {
+	using Alloc = alloc::Arena_Allocator<int> ::SHARED<Tag>;
+
+	{
+		List<int> ::COUNTABLE ::ALLOCATOR<Alloc> list_a;
+		List<int> ::COUNTABLE ::ALLOCATOR<Alloc> list_b;
+		Hash_Table<int> ::EXTERNAL ::ALLOCATOR<Alloc> set;
+
+		for(int i=0; i<1000; ++i) {
+			list_a.emplace_back(i);
+			list_b.emplace_front(i);
+			set.emplace(i);
+		}
+
+		// nodes of both lists live in the same arena
+		list_a.splice( {}, list_b );
+		EXPECT_TRUE(list_b.is_empty());
+
+		EXPECT_EQ(2000, list_a.count());
+		EXPECT_EQ(1000, set.count());
+		for(int i=0; i<1000; ++i) EXPECT_TRUE( set(i).found() );
+	}
+
+	EXPECT_GT(Alloc().arena().capacity(), 0);
+
+	// throw away everything at once
+	Alloc().reset();
+	Alloc().release();
+	EXPECT_EQ(0, Alloc().arena().capacity());
+}
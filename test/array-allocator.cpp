@@ -0,0 +1,238 @@
+#include "common.hpp"
+
+#include <salgo/alloc/array-allocator>
+
+#include <gtest/gtest.h>
+
+#include <climits>
+#include <vector>
+
+using namespace salgo;
+using namespace salgo::alloc;
+
+
+
+
+
+TEST(Array_Allocator, simple) {
+	Array_Allocator<int> alloc;
+
+	std::vector< Array_Allocator<int>::Handle > handles;
+	for(int i=0; i<100; ++i) {
+		handles.emplace_back( alloc.construct(i).handle() );
+	}
+
+	for(int i=0; i<100; i+=2) alloc( handles[i] ).destruct();
+
+	EXPECT_EQ(50, alloc.count());
+	for(int i=1; i<100; i+=2) EXPECT_EQ(i, alloc[ handles[i] ]);
+}
+
+
+
+
+TEST(Array_Allocator, construct_near) {
+	Array_Allocator<int> ::FREE_BITMAP alloc;
+
+	std::vector< Array_Allocator<int>::Handle > handles;
+	for(int i=0; i<100; ++i) {
+		handles.emplace_back( alloc.construct(i).handle() );
+	}
+
+	alloc( handles[50] ).destruct();
+	alloc( handles[20] ).destruct();
+
+	// nearest free slot wins
+	EXPECT_EQ(50, (int)alloc.construct_near( handles[48], 1000 ).handle());
+
+	// too far - falls back to regular construct()
+	auto h = alloc.construct_near( handles[90], 2000 ).handle();
+	EXPECT_NE(20, (int)h);
+
+	// searching backwards too
+	EXPECT_EQ(20, (int)alloc.construct_near( handles[22], 3000 ).handle());
+
+	EXPECT_EQ(101, alloc.count());
+	EXPECT_EQ(1000, alloc[ handles[50] ]);
+	EXPECT_EQ(2000, alloc[h]);
+}
+
+
+
+TEST(Array_Allocator, free_bitmap_matches_linear_scan) {
+	using T = Movable;
+	T::reset();
+
+	{
+		Array_Allocator<T> a;
+		Array_Allocator<T> ::FREE_BITMAP b;
+
+		std::vector< Array_Allocator<T>::Handle > handles;
+
+		for(int iter=0; iter<300000; ++iter) {
+			// grow, then shrink
+			int erase_chance = iter < 200000 ? 3 : 7;
+
+			if(!handles.empty() && rand()%10 < erase_chance) {
+				int i = rand() % handles.size();
+				a( handles[i] ).destruct();
+				b( handles[i] ).destruct();
+				handles[i] = handles.back();
+				handles.pop_back();
+			}
+			else {
+				int val = rand();
+				auto ha = a.construct(val).handle();
+				auto hb = b.construct(val).handle();
+				ASSERT_EQ((int)ha, (int)hb);
+				handles.emplace_back(ha);
+			}
+		}
+
+		EXPECT_EQ(a.count(), b.count());
+		EXPECT_EQ(a.domain(), b.domain());
+
+		for(auto& h : handles) EXPECT_EQ((int)a[h], (int)b[h]);
+
+		// iteration order is the same
+		std::vector<int> va, vb;
+		for(auto& e : a) va.push_back( e() );
+		for(auto& e : b) vb.push_back( e() );
+		EXPECT_EQ(va, vb);
+	}
+
+	EXPECT_EQ(T::constructors(), T::destructors());
+}
+
+
+
+
+TEST(Array_Allocator, stable_matches_default) {
+	using T = Movable;
+	T::reset();
+
+	{
+		Array_Allocator<T> a;
+		Array_Allocator<T> ::STABLE ::FREE_BITMAP b;
+
+		std::vector<int> handles;
+
+		for(int iter=0; iter<300000; ++iter) {
+			// grow, then shrink
+			int erase_chance = iter < 200000 ? 3 : 7;
+
+			if(!handles.empty() && rand()%10 < erase_chance) {
+				int i = rand() % handles.size();
+				a( handles[i] ).destruct();
+				b( handles[i] ).destruct();
+				handles[i] = handles.back();
+				handles.pop_back();
+			}
+			else {
+				int val = rand();
+				int ha = a.construct(val).handle();
+				int hb = b.construct(val).handle();
+				ASSERT_EQ(ha, hb);
+				handles.emplace_back(ha);
+			}
+		}
+
+		EXPECT_EQ(a.count(), b.count());
+		EXPECT_EQ(a.domain(), b.domain());
+
+		for(auto& h : handles) EXPECT_EQ((int)a[h], (int)b[h]);
+
+		std::vector<int> va, vb;
+		for(auto& e : a) va.push_back( e() );
+		for(auto& e : b) vb.push_back( e() );
+		EXPECT_EQ(va, vb);
+	}
+
+	EXPECT_EQ(T::constructors(), T::destructors());
+}
+
+
+
+
+TEST(Array_Allocator, stable_references) {
+	struct Pinned {
+		int val;
+		Pinned(int v) : val(v) {}
+		Pinned(Pinned&&) = delete;
+	};
+
+	Array_Allocator<Pinned> ::STABLE alloc;
+	EXPECT_TRUE(alloc.Is_Persistent);
+
+	std::vector<Pinned*> pointers;
+	for(int i=0; i<100; ++i) {
+		pointers.emplace_back( &alloc[ alloc.construct(i).handle() ] );
+	}
+
+	// growing doesn't move elements
+	for(int i=100; i<100000; ++i) alloc.construct(i);
+
+	for(int i=0; i<100; ++i) {
+		EXPECT_EQ(pointers[i], &alloc[i]);
+		EXPECT_EQ(i, pointers[i]->val);
+	}
+
+	EXPECT_EQ(100000, alloc.count());
+	EXPECT_EQ(0, alloc[FIRST].val);
+	EXPECT_EQ(99999, alloc[LAST].val);
+}
+
+
+
+TEST(Array_Allocator, handle_width) {
+	using Alloc = Array_Allocator<int> ::HANDLE_INT<uint16_t>;
+	static_assert(sizeof(Alloc::Handle_Small) == 2);
+
+	Alloc alloc;
+	Alloc::STABLE stable;
+
+	// fill up to the max value representable by the handle
+	for(int i=0; i<65535; ++i) {
+		EXPECT_EQ(i, alloc.construct(i).handle());
+		EXPECT_EQ(i, stable.construct(i).handle());
+	}
+	EXPECT_EQ(65535, alloc.count());
+	EXPECT_EQ(65535, alloc.domain());
+
+	alloc(777).destruct();
+	EXPECT_EQ(777, alloc.construct(-1).handle());
+	EXPECT_EQ(-1, alloc[777]);
+	EXPECT_EQ(777, stable[777]);
+}
+
+
+TEST(Array_Allocator, handle_width_64) {
+	using Alloc = Array_Allocator<int> ::HANDLE_INT<int64_t>;
+	static_assert(sizeof(Alloc::Handle_Small) == 8);
+	static_assert(std::is_same_v<int64_t, decltype(Alloc().domain())>);
+	static_assert(Alloc::Max_Domain > INT_MAX);
+	static_assert(Alloc::STABLE::Max_Domain > INT_MAX);
+
+	Alloc alloc;
+	Alloc::FREE_BITMAP bitmap;
+	Alloc::STABLE stable;
+
+	for(int i=0; i<1000; ++i) {
+		EXPECT_EQ(i, alloc.construct(i).handle());
+		EXPECT_EQ(i, bitmap.construct(i).handle());
+		EXPECT_EQ(i, stable.construct(i).handle());
+	}
+
+	alloc(777).destruct();
+	bitmap(777).destruct();
+	EXPECT_EQ(999, alloc.count());
+	EXPECT_TRUE( bitmap(777).is_not_constructed() );
+
+	// same holes in both modes
+	auto h = alloc.construct(-1).handle();
+	EXPECT_EQ(h, bitmap.construct(-1).handle());
+	EXPECT_EQ(-1, alloc[h]);
+	EXPECT_EQ(-1, bitmap[h]);
+	EXPECT_EQ(777, stable[777]);
+	EXPECT_EQ(999, stable[LAST]);
+}
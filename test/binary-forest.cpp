@@ -145,3 +145,19 @@ TEST(Binary_Forest, inorder_erase) {
 }
 */
 
+
+
+
+TEST(Binary_Forest, handle_width) {
+	using Small_Forest = My_Binary_Forest ::DATA<int> ::HANDLE_INT<uint16_t>;
+	static_assert(sizeof(Small_Forest::Handle_Small) == 2);
+
+	Small_Forest tree;
+	auto root = sample_tree_1(tree);
+	EXPECT_EQ(77, root.right().right()());
+	EXPECT_EQ(55, root.right().right().left().parent().parent()());
+
+	std::multiset<int> vals;
+	for(auto& e : tree) vals.emplace(e());
+	EXPECT_EQ(vals, std::multiset<int>({11,22,33,44,55,66,77}));
+}
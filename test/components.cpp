@@ -0,0 +1,224 @@
+#include <salgo/graph/components>
+#include <salgo/graph/graph>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <set>
+#include <utility>
+#include <vector>
+
+using namespace salgo;
+using namespace salgo::graph;
+
+
+
+
+
+namespace {
+
+using Edges = std::vector<std::pair<int,int>>;
+
+Edges random_edges(int n, int m) {
+	Edges edges;
+	for(int i=0; i<m; ++i) edges.emplace_back( rand() % n, rand() % n );
+	return edges;
+}
+
+// transitive closure by repeated BFS
+std::vector<std::vector<bool>> reachability(int n, const Edges& edges) {
+	std::vector<std::vector<int>> adj(n);
+	for(auto& [a,b] : edges) adj[a].emplace_back(b);
+
+	std::vector<std::vector<bool>> reach(n, std::vector<bool>(n));
+	for(int s=0; s<n; ++s) {
+		std::vector<int> queue = {s};
+		reach[s][s] = true;
+		for(int i=0; i<(int)queue.size(); ++i) {
+			for(int u : adj[queue[i]]) if(!reach[s][u]) {
+				reach[s][u] = true;
+				queue.emplace_back(u);
+			}
+		}
+	}
+	return reach;
+}
+
+// same component iff mutually reachable
+void check_scc(const Components& c, int n, const std::vector<std::vector<bool>>& reach) {
+	std::set<int> ids;
+	for(int v=0; v<n; ++v) {
+		ASSERT_GE(c.component[v], 0);
+		ASSERT_LT(c.component[v], c.count);
+		ids.insert(c.component[v]);
+	}
+	EXPECT_EQ(c.count, (int)ids.size());
+
+	for(int a=0; a<n; ++a) {
+		for(int b=0; b<n; ++b) {
+			EXPECT_EQ(reach[a][b] && reach[b][a], c.component[a] == c.component[b]) << a << " " << b;
+		}
+	}
+}
+
+// number of connected components of an undirected graph, without vertex `skip` and edge `skip_edge`
+int count_components(int n, const Edges& edges, int skip, int skip_edge) {
+	std::vector<int> parent(n);
+	for(int i=0; i<n; ++i) parent[i] = i;
+	auto find = [&](int x) { while(parent[x] != x) x = parent[x] = parent[parent[x]]; return x; };
+
+	int result = n - (skip != -1);
+	for(int i=0; i<(int)edges.size(); ++i) {
+		auto [a,b] = edges[i];
+		if(i == skip_edge || a == skip || b == skip) continue;
+		a = find(a); b = find(b);
+		if(a != b) { parent[a] = b; --result; }
+	}
+	return result;
+}
+
+} // namespace
+
+
+
+
+TEST(Components, scc_random) {
+	srand(69);
+	for(int iter=0; iter<30; ++iter) {
+		const int n = 1 + rand() % 80;
+		auto edges = random_edges(n, rand() % (2*n + 1));
+		auto reach = reachability(n, edges);
+
+		Graph ::DIRECTED ::BACKLINKS g(n);
+		for(auto& [a,b] : edges) g.edges().add(a, b);
+
+		auto c = strongly_connected_components(g);
+		check_scc(c, n, reach);
+
+		// reverse topological order: edges never go to a later component
+		for(auto& [a,b] : edges) EXPECT_GE(c.component[a], c.component[b]);
+
+		check_scc( strongly_connected_components_parallel(g), n, reach );
+
+		auto csr = g.freeze();
+		check_scc( strongly_connected_components(csr), n, reach );
+		check_scc( strongly_connected_components_parallel(csr), n, reach );
+	}
+}
+
+
+
+TEST(Components, scc_parallel_big) {
+	// big enough for several threads, with a giant component and many small ones
+	srand(69);
+	const int n = 100'000;
+	Graph ::DIRECTED ::BACKLINKS g(n);
+	for(int i=0; i<n; ++i) g.edges().add(rand() % n, rand() % n);
+	for(int i=0; i<n/2; ++i) g.edges().add(rand() % (n/2), rand() % (n/2));
+	auto csr = g.freeze();
+
+	auto expected = strongly_connected_components(csr);
+	auto c = strongly_connected_components_parallel(csr, NUM_THREADS = 4);
+	EXPECT_EQ(expected.count, c.count);
+
+	// same partition
+	std::vector<int> mapping(c.count, -1);
+	for(int v=0; v<n; ++v) {
+		int& m = mapping[ c.component[v] ];
+		if(m == -1) m = expected.component[v];
+		EXPECT_EQ(m, expected.component[v]);
+	}
+}
+
+
+
+TEST(Components, scc_deep) {
+	// a long cycle would overflow the stack with a recursive implementation
+	const int n = 1'000'000;
+	Graph ::DIRECTED g(n);
+	for(int i=0; i<n; ++i) g.edges().add(i, (i+1) % n);
+	g.edges().add(0, n/2);
+
+	auto c = strongly_connected_components(g);
+	EXPECT_EQ(1, c.count);
+}
+
+
+
+TEST(Components, topological_sort) {
+	srand(69);
+	const int n = 1000;
+
+	// DAG: edges from lower to higher random rank
+	std::vector<int> rank(n);
+	for(int i=0; i<n; ++i) rank[i] = i;
+	for(int i=n-1; i>0; --i) std::swap(rank[i], rank[rand() % (i+1)]);
+
+	Graph ::DIRECTED g(n);
+	for(int i=0; i<4*n; ++i) {
+		int a = rand() % n, b = rand() % n;
+		if(rank[a] < rank[b]) g.edges().add(a, b);
+		else if(rank[b] < rank[a]) g.edges().add(b, a);
+	}
+
+	auto order = topological_sort(g);
+	ASSERT_EQ(n, order.count());
+
+	std::vector<int> position(n, -1);
+	for(int i=0; i<n; ++i) position[ order[i] ] = i;
+	for(auto& v : g.verts()) {
+		for(auto& out : v.outs()) EXPECT_LT(position[ v.handle() ], position[ out.vert().handle() ]);
+	}
+
+	// a cycle: 1 -> 2 -> 3 -> 1, and 0 -> 1, 3 -> 4
+	Graph ::DIRECTED h(5);
+	h.edges().add(0, 1);
+	h.edges().add(1, 2);
+	h.edges().add(2, 3);
+	h.edges().add(3, 1);
+	h.edges().add(3, 4);
+	auto partial = topological_sort(h);
+	ASSERT_EQ(1, partial.count());
+	EXPECT_EQ(0, partial[0].a);
+}
+
+
+
+TEST(Components, articulation_points_and_bridges) {
+	srand(69);
+	for(int iter=0; iter<30; ++iter) {
+		const int n = 1 + rand() % 40;
+		auto edges = random_edges(n, rand() % (n + n/2 + 1));
+
+		Graph g(n);
+		for(auto& [a,b] : edges) g.edges().add(a, b);
+
+		const int base = count_components(n, edges, -1, -1);
+
+		auto art = articulation_points(g);
+		for(int v=0; v<n; ++v) {
+			bool expected = count_components(n, edges, v, -1) > base;
+			EXPECT_EQ(expected, (bool)art[v]) << "vertex " << v;
+		}
+
+		std::set<std::pair<int,int>> expected_bridges;
+		for(int i=0; i<(int)edges.size(); ++i) {
+			if(count_components(n, edges, -1, i) > base) {
+				auto [a,b] = edges[i];
+				expected_bridges.emplace( std::min(a,b), std::max(a,b) );
+			}
+		}
+
+		std::set<std::pair<int,int>> found;
+		auto br = bridges(g);
+		for(int i=0; i<br.count(); ++i) {
+			int a = br[i].first, b = br[i].second;
+			found.emplace( std::min(a,b), std::max(a,b) );
+		}
+		EXPECT_EQ(expected_bridges, found);
+		EXPECT_EQ((int)found.size(), br.count());
+
+		auto csr = g.freeze();
+		EXPECT_EQ(br.count(), bridges(csr).count());
+	}
+}
@@ -2,6 +2,7 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <vector>
 
 using namespace salgo;
@@ -122,3 +123,129 @@ TEST(Crude_Allocator, no_auto_destruct) {
 }
 
 
+
+
+
+
+TEST(Crude_Allocator, reuse) {
+	using Alloc = Crude_Allocator<int> ::REUSE;
+	Alloc alloc;
+
+	std::vector< std::pair<Alloc::Handle, int> > live;
+
+	int max_block = 0;
+
+	for(int iter=0; iter<300000; ++iter) {
+		// grow, churn, then shrink
+		int erase_chance = iter < 100000 ? 3 : iter < 200000 ? 5 : 7;
+
+		if(!live.empty() && rand()%10 < erase_chance) {
+			int i = rand() % live.size();
+			EXPECT_EQ(live[i].second, alloc[ live[i].first ]);
+			alloc.destruct( live[i].first );
+			live[i] = live.back();
+			live.pop_back();
+		}
+		else {
+			int val = rand();
+			auto h = alloc.construct(val).handle();
+			max_block = std::max<int>(max_block, h.a);
+			live.emplace_back(h, val);
+		}
+	}
+
+	for(auto& [h, val] : live) EXPECT_EQ(val, alloc[h]);
+
+	// never more than ~40000 elements at once - freed slots must have been reused
+	EXPECT_LE(max_block, 15);
+
+	for(auto& [h, val] : live) alloc.destruct(h);
+
+	// released blocks are allocated again
+	for(int i=0; i<100000; ++i) alloc.construct(i);
+}
+
+
+
+TEST(Crude_Allocator, reuse_drained_current_block) {
+	using Alloc = Crude_Allocator<int> ::REUSE;
+	Alloc alloc;
+
+	auto first = alloc.construct(0).handle();
+
+	// churn inside the current block: when it drains, it's filled from the beginning again
+	for(int iter=0; iter<100; ++iter) {
+		std::vector<Alloc::Handle> handles;
+		for(int i=0; i<2; ++i) handles.emplace_back( alloc.construct(i).handle() );
+		if(iter == 0) alloc.destruct(first);
+		for(auto& h : handles) alloc.destruct(h);
+
+		auto h = alloc.construct(7).handle();
+		EXPECT_EQ(0, h.b);
+		alloc.destruct(h);
+	}
+}
+
+
+
+TEST(Crude_Allocator, reuse_construct_near) {
+	using Alloc = Crude_Allocator<int> ::REUSE;
+	Alloc alloc;
+
+	std::vector<Alloc::Handle> handles;
+	for(int i=0; i<100; ++i) handles.emplace_back( alloc.construct(i).handle() );
+
+	// free a slot in an older block
+	auto freed = handles[10];
+	auto neighbor = handles[11];
+	ASSERT_EQ(freed.a, neighbor.a);
+	ASSERT_NE(freed.a, handles.back().a);
+	alloc.destruct(freed);
+
+	// plain construct() goes to the current block, construct_near() to the hint's block
+	EXPECT_EQ(handles.back().a, alloc.construct(1000).handle().a);
+
+	auto h = alloc.construct_near(neighbor, 2000).handle();
+	EXPECT_EQ(freed, h);
+	EXPECT_EQ(2000, alloc[h]);
+
+	// no room in the hint's block: falls back to construct()
+	EXPECT_EQ(handles.back().a, alloc.construct_near(neighbor, 3000).handle().a);
+}
+
+
+
+TEST(Crude_Allocator, handle_width) {
+	{
+		using Alloc = Crude_Allocator<int> ::HANDLE_INT<uint16_t>;
+		static_assert(sizeof(Alloc::Handle_Small) == 2);
+
+		// 31 blocks: 2 + 6 + ... + 2046, then 2048 each - block 31 is the invalid handle
+		const int limit = 47080;
+
+		Alloc alloc;
+		std::vector<Alloc::Handle_Small> handles;
+		for(int i=0; i<limit; ++i) handles.emplace_back( alloc.construct(i).handle() );
+		for(int i=0; i<limit; ++i) {
+			ASSERT_TRUE(handles[i].valid()) << i;
+			EXPECT_EQ(i, alloc[ handles[i] ]);
+		}
+		EXPECT_EQ(30, Alloc::Handle(handles.back()).a);
+
+		EXPECT_DEATH( alloc.construct(limit), "out of handle space" );
+	}
+
+	{
+		// offsets bigger than 27 bits
+		using Alloc = Crude_Allocator<int> ::HANDLE_INT<uint64_t>;
+		static_assert(sizeof(Alloc::Handle_Small) == 8);
+
+		Alloc::Handle h( _::crude_allocator::H0(30), (1<<30) + 123 );
+		Alloc::Handle_Small small = h;
+		EXPECT_EQ(h, Alloc::Handle(small));
+
+		Alloc alloc;
+		Alloc::Handle_Small a = alloc.construct(5).handle();
+		EXPECT_EQ(5, alloc[a]);
+	}
+}
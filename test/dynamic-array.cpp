@@ -3,6 +3,7 @@
 #include <gtest/gtest.h>
 
 #include <chrono>
+#include <climits>
 #include <vector>
 
 using namespace std;
@@ -236,3 +237,102 @@ TEST(Accessor, print_to_ostream) {
 }
 
 
+
+
+
+
+TEST(Dynamic_Array, erase_if) {
+	Dynamic_Array<int> v;
+	vector<int> want;
+	for(int i=0; i<1000; ++i) {
+		v.emplace_back(i);
+		if(i % 3) want.emplace_back(i);
+	}
+
+	EXPECT_EQ(334, v.erase_if([](int x){ return x % 3 == 0; }));
+
+	ASSERT_EQ((int)want.size(), v.size());
+	for(int i=0; i<v.size(); ++i) EXPECT_EQ(want[i], v[i]);
+}
+
+
+TEST(Dynamic_Array, erase_if_nontrivial) {
+	g_destructors = 0;
+	g_constructors = 0;
+
+	struct S {
+		int val;
+		S(int v) : val(v) { ++g_constructors; }
+		S(S&& o) : val(o.val) { ++g_constructors; }
+		~S() { ++g_destructors; }
+	};
+
+	{
+		Dynamic_Array<S> v;
+		for(int i=0; i<100; ++i) v.emplace_back(i);
+
+		EXPECT_EQ(50, v.erase_if([](const S& s){ return s.val % 2; }));
+
+		ASSERT_EQ(50, v.size());
+		for(int i=0; i<v.size(); ++i) EXPECT_EQ(2*i, v[i].val);
+	}
+
+	EXPECT_EQ(g_constructors, g_destructors);
+}
+
+
+TEST(Dynamic_Array, erase_if_sparse) {
+	Dynamic_Array<int> ::SPARSE ::CONSTRUCTED_FLAGS ::COUNT v;
+	for(int i=0; i<10; ++i) v.emplace_back(i);
+
+	EXPECT_EQ(5, v.erase_if([](int x){ return x >= 5; }));
+
+	EXPECT_EQ(5, v.count());
+	EXPECT_EQ(10, v.domain());
+	EXPECT_TRUE(v(4).is_constructed());
+	EXPECT_FALSE(v(5).is_constructed());
+}
+
+
+TEST(Dynamic_Array, partition) {
+	Dynamic_Array<long long> v;
+	for(int i=0; i<1001; ++i) v.emplace_back(i * 7 % 1001);
+
+	vector<long long> want_fr, want_bk;
+	for(auto& e : v) (e % 5 == 0 ? want_fr : want_bk).emplace_back(e);
+
+	EXPECT_EQ((int)want_fr.size(), v.partition([](long long x){ return x % 5 == 0; }));
+
+	// stable
+	for(int i=0; i<(int)want_fr.size(); ++i) EXPECT_EQ(want_fr[i], v[i]);
+	for(int i=0; i<(int)want_bk.size(); ++i) EXPECT_EQ(want_bk[i], v[(int)want_fr.size() + i]);
+}
+
+
+
+TEST(Dynamic_Array, handle_width) {
+	Dynamic_Array<int> ::HANDLE_INT<uint16_t> v;
+	static_assert(sizeof(decltype(v)::Handle) == 2);
+
+	// growth stops at the max value representable by the handle
+	for(int i=0; i<65535; ++i) v.emplace_back(i);
+	EXPECT_EQ(65535, v.size());
+	EXPECT_EQ(65535, v.capacity());
+
+	EXPECT_EQ(65534, v[LAST]);
+	EXPECT_EQ(12345, v[ v(12345).handle() ]);
+}
+
+
+TEST(Dynamic_Array, handle_width_64) {
+	Dynamic_Array<int> ::HANDLE_INT<int64_t> v;
+	static_assert(sizeof(decltype(v)::Handle) == 8);
+	static_assert(std::is_same_v<int64_t, decltype(v.domain())>);
+	static_assert(decltype(v)::Max_Domain > INT_MAX);
+
+	for(int i=0; i<1000; ++i) v.emplace_back(i);
+	EXPECT_EQ(334, v.partition([](int x){ return x % 3 == 0; }));
+	EXPECT_EQ(666, v.erase_if([](int x){ return x % 3 != 0; }));
+	EXPECT_EQ(334, v.size());
+	EXPECT_EQ(999, v[LAST]);
+}
@@ -0,0 +1,68 @@
+#include <salgo/graph/dynamic-connectivity>
+#include <salgo/graph/graph>
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+using namespace salgo;
+using namespace salgo::graph;
+
+
+
+
+
+TEST(Dynamic_Connectivity, simple) {
+	Graph ::EDGE_DATA<Lifetime> g(4);
+	g.edges().add(0, 1, Lifetime{0, 10});
+	g.edges().add(1, 2, Lifetime{2, 5});
+	g.edges().add(2, 3, Lifetime{4, 7});
+
+	auto result = offline_connectivity(g, {
+		{0, 0, 1},
+		{1, 0, 2},
+		{2, 0, 2},
+		{4, 0, 3},
+		{5, 0, 3},
+		{5, 3, 2},
+		{12, 0, 1},
+	});
+
+	EXPECT_EQ( std::vector<bool>({true, false, true, true, false, true, false}), result );
+}
+
+
+TEST(Dynamic_Connectivity, random) {
+	const int N = 30;
+	const int T = 200;
+
+	srand(69);
+	Graph ::EDGE_DATA<Lifetime> g(N);
+	std::vector<std::pair<int,int>> edges;
+	std::vector<Lifetime> lifetimes;
+	for(int i=0; i<60; ++i) {
+		int a = rand() % N, b = rand() % N;
+		int fr = rand() % T;
+		Lifetime lifetime{fr, fr + rand() % 50};
+		g.edges().add(a, b, lifetime);
+		edges.emplace_back(a, b);
+		lifetimes.emplace_back(lifetime);
+	}
+
+	std::vector<Connectivity_Query> queries;
+	for(int i=0; i<500; ++i) queries.push_back({ rand() % T, rand() % N, rand() % N });
+
+	auto result = offline_connectivity(g, queries);
+
+	for(int i=0; i<(int)queries.size(); ++i) {
+		auto& q = queries[i];
+		Union_Find reference(N);
+		for(int e=0; e<(int)edges.size(); ++e) {
+			if(lifetimes[e].from <= q.time && q.time < lifetimes[e].to) {
+				auto [a, b] = edges[e];
+				if(reference(a) != reference(b)) reference.merge(a, b);
+			}
+		}
+		EXPECT_EQ( reference(q.a) == reference(q.b), result[i] );
+	}
+}
@@ -0,0 +1,59 @@
+#include <salgo/geom/g3d/mesh>
+#include <salgo/geom/g3d/solid>
+#include <salgo/geom/g3d/reorder-verts>
+
+#include <gtest/gtest.h>
+
+#include "common.hpp"
+
+#include <vector>
+
+using namespace salgo::geom::g3d;
+
+
+
+
+using M = Mesh<double> ::EDGE_LINKS ::VERT_POLY_LINKS;
+
+
+
+
+TEST(Reorder_verts, bunny) {
+	for(auto strategy : {Vertex_Order::BFS, Vertex_Order::RCM, Vertex_Order::DEGREE, Vertex_Order::GORDER}) {
+		M mesh = load_ply<Mesh<double>>("resources/bunny-holes.ply");
+		fast_compute_edge_links(mesh);
+		bool solid = is_solid(mesh, ALLOW_HOLES=true);
+
+		std::vector<Eigen::Matrix<double,3,1>> poly_verts;
+		for(auto& p : mesh.polys()) {
+			for(int i=0; i<3; ++i) poly_verts.emplace_back( p.vert(i).pos() );
+		}
+
+		const int n = mesh.verts().domain();
+		auto new_index = reorder_verts(mesh, strategy);
+		ASSERT_EQ(n, mesh.verts().domain());
+
+		std::vector<bool> used(n);
+		for(int v=0; v<n; ++v) {
+			ASSERT_TRUE(new_index[v] >= 0 && new_index[v] < n);
+			EXPECT_FALSE(used[ new_index[v] ]);
+			used[ new_index[v] ] = true;
+		}
+
+		// polys keep their vert positions
+		int k = 0;
+		for(auto& p : mesh.polys()) {
+			for(int i=0; i<3; ++i) EXPECT_EQ(poly_verts[k++], p.vert(i).pos());
+		}
+
+		// vert-poly links moved with the verts
+		for(auto& v : mesh.verts()) {
+			for(auto& vp : v.vertPolys()) {
+				auto p = vp.poly();
+				EXPECT_TRUE( p.vert(0).handle() == v.handle() || p.vert(1).handle() == v.handle() || p.vert(2).handle() == v.handle() );
+			}
+		}
+
+		EXPECT_EQ( solid, is_solid(mesh, ALLOW_HOLES=true) );
+	}
+}
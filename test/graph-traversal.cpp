@@ -0,0 +1,212 @@
+#include <salgo/graph/traversal>
+#include <salgo/graph/graph>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <queue>
+#include <set>
+#include <utility>
+#include <vector>
+
+using namespace salgo;
+using namespace salgo::graph;
+
+
+
+
+
+namespace {
+
+// plain BFS over an edge list
+std::vector<int> reference_depths(int n, const std::vector<std::pair<int,int>>& edges, bool directed, int source) {
+	std::vector<std::vector<int>> adj(n);
+	for(auto& [a,b] : edges) {
+		adj[a].emplace_back(b);
+		if(!directed) adj[b].emplace_back(a);
+	}
+
+	std::vector<int> depth(n, -1);
+	std::queue<int> q;
+	depth[source] = 0;
+	q.push(source);
+	while(!q.empty()) {
+		int v = q.front(); q.pop();
+		for(int u : adj[v]) if(depth[u] == -1) {
+			depth[u] = depth[v] + 1;
+			q.push(u);
+		}
+	}
+	return depth;
+}
+
+std::vector<std::pair<int,int>> random_edges(int n, int m) {
+	std::vector<std::pair<int,int>> edges;
+	for(int i=0; i<m; ++i) edges.emplace_back( rand() % n, rand() % n );
+	return edges;
+}
+
+// checks depths against the reference, and that each parent is a neighbour one layer up
+template<class G>
+void check_bfs(G& g, int n, const std::vector<std::pair<int,int>>& edges, bool directed, bool direction_optimizing) {
+	std::set<std::pair<int,int>> edge_set;
+	for(auto& [a,b] : edges) {
+		edge_set.emplace(a, b);
+		if(!directed) edge_set.emplace(b, a);
+	}
+
+	auto expected = reference_depths(n, edges, directed, 0);
+	std::vector<int> depth(n, -1);
+
+	int visited = bfs(g, 0, ON_DISCOVER = [&](int v, auto parent, int d) {
+		EXPECT_EQ(-1, depth[v]);
+		depth[v] = d;
+		if(parent.valid()) {
+			EXPECT_EQ(d-1, depth[parent]);
+			EXPECT_TRUE( edge_set.count({(int)parent, v}) );
+		}
+		else EXPECT_EQ(0, v);
+	}, DIRECTION_OPTIMIZING = direction_optimizing);
+
+	EXPECT_EQ(expected, depth);
+	EXPECT_EQ(n - (int)std::count(expected.begin(), expected.end(), -1), visited);
+}
+
+} // namespace
+
+
+
+
+TEST(Graph_Traversal, bfs_undirected) {
+	srand(69);
+	const int n = 3000;
+	auto edges = random_edges(n, 4*n);
+
+	Graph g(n);
+	for(auto& [a,b] : edges) g.edges().add(a, b);
+
+	check_bfs(g, n, edges, false, false);
+	check_bfs(g, n, edges, false, true);
+
+	auto csr = g.freeze();
+	check_bfs(csr, n, edges, false, false);
+	check_bfs(csr, n, edges, false, true);
+}
+
+
+
+TEST(Graph_Traversal, bfs_directed) {
+	srand(69);
+	const int n = 3000;
+	auto edges = random_edges(n, 5*n);
+
+	Graph ::DIRECTED a(n);
+	Graph ::DIRECTED ::BACKLINKS b(n);
+	for(auto& [x,y] : edges) {
+		a.edges().add(x, y);
+		b.edges().add(x, y);
+	}
+
+	check_bfs(a, n, edges, true, true); // no in-edges: always top-down
+	check_bfs(b, n, edges, true, true);
+
+	auto csr = b.freeze();
+	check_bfs(csr, n, edges, true, true);
+}
+
+
+
+TEST(Graph_Traversal, bfs_callbacks) {
+	// 0 - 1 - 2 - 3,  1 - 4
+	Graph g(5);
+	g.edges().add(0, 1);
+	g.edges().add(1, 2);
+	g.edges().add(2, 3);
+	g.edges().add(1, 4);
+
+	int num_edges = 0;
+	std::vector<int> finished;
+	bfs(g, 0,
+		ON_EDGE = [&](int, auto& out) { ++num_edges; EXPECT_LT(out.vert().handle(), 5); },
+		ON_FINISH = [&](int v) { finished.emplace_back(v); }
+	);
+	EXPECT_EQ(8, num_edges); // each undirected edge is examined from both sides
+	EXPECT_EQ((std::vector<int>{0, 1, 2, 4, 3}), finished);
+
+	// stop at vertex 2
+	std::vector<int> discovered;
+	int visited = bfs(g, 0, ON_DISCOVER = [&](int v) {
+		discovered.emplace_back(v);
+		return v == 2 ? BREAK : CONTINUE;
+	});
+	EXPECT_EQ((std::vector<int>{0, 1, 2}), discovered);
+	EXPECT_EQ(3, visited);
+}
+
+
+
+TEST(Graph_Traversal, dfs_order) {
+	/*
+	      0
+	    /   \
+	   1     4
+	  / \
+	 2   3
+	*/
+	Graph ::DIRECTED g(5);
+	g.edges().add(0, 1);
+	g.edges().add(1, 2);
+	g.edges().add(1, 3);
+	g.edges().add(0, 4);
+	g.edges().add(3, 0); // back edge
+
+	std::vector<int> pre, post, depths;
+	int num_edges = 0;
+	int visited = dfs(g, 0,
+		ON_DISCOVER = [&](int v, auto parent, int depth) {
+			pre.emplace_back(v);
+			depths.emplace_back(depth);
+			if(v) {
+				EXPECT_TRUE(parent.valid());
+			}
+		},
+		ON_FINISH = [&](int v) { post.emplace_back(v); },
+		ON_EDGE = [&](int, auto&) { ++num_edges; }
+	);
+
+	EXPECT_EQ(5, visited);
+	EXPECT_EQ(5, num_edges);
+	EXPECT_EQ((std::vector<int>{0, 1, 2, 3, 4}), pre);
+	EXPECT_EQ((std::vector<int>{0, 1, 2, 2, 1}), depths);
+	EXPECT_EQ((std::vector<int>{2, 3, 1, 4, 0}), post);
+
+	// same on the frozen graph
+	auto csr = g.freeze();
+	pre.clear();
+	dfs(csr, 0, ON_DISCOVER = [&](int v) { pre.emplace_back(v); });
+	EXPECT_EQ((std::vector<int>{0, 1, 2, 3, 4}), pre);
+}
+
+
+
+TEST(Graph_Traversal, dfs_deep) {
+	// a long path would overflow the stack with a recursive DFS
+	const int n = 1'000'000;
+	Graph g(n);
+	for(int i=0; i+1<n; ++i) g.edges().add(i, i+1);
+
+	int max_depth = 0;
+	int last_finished = -1;
+	int visited = dfs(g, 0,
+		ON_DISCOVER = [&](int, auto, int depth) { max_depth = std::max(max_depth, depth); },
+		ON_FINISH = [&](int v) { last_finished = v; }
+	);
+
+	EXPECT_EQ(n, visited);
+	EXPECT_EQ(n-1, max_depth);
+	EXPECT_EQ(0, last_finished);
+
+	// stop when reaching the middle
+	visited = dfs(g, 0, ON_DISCOVER = [&](int v) { return v == n/2 ? BREAK : CONTINUE; });
+	EXPECT_EQ(n/2 + 1, visited);
+}
@@ -2,6 +2,9 @@
 
 #include <gtest/gtest.h>
 
+#include <set>
+#include <utility>
+
 using namespace salgo;
 using namespace salgo::graph;
 
@@ -135,3 +138,66 @@ TEST(Graph, verts_erase_star) {
 	}
 	EXPECT_EQ(std::multiset<int>({2,4}), r);
 }
+
+
+
+
+// same code for Graph and Csr_Graph
+template<class G>
+static std::multiset<std::pair<int,int>> out_pairs(G& g) {
+	std::multiset<std::pair<int,int>> r;
+	for(auto& v : g.verts()) {
+		for(auto& e : v.outs()) r.emplace( v.handle(), e.vert().handle() );
+	}
+	return r;
+}
+
+
+TEST(Graph, freeze) {
+	Graph ::VERT_DATA<int> ::EDGE_DATA<int> g(4);
+	g.edges().add(0, 1, 10);
+	g.edges().add(1, 2, 20);
+	g.edges().add(3, 1, 30);
+	for(int i=0; i<4; ++i) g.vert(i).data() = 100*i;
+
+	auto csr = g.freeze();
+
+	EXPECT_EQ(4, csr.verts().count());
+	EXPECT_EQ(3, csr.num_edges());
+	EXPECT_EQ(out_pairs(g), out_pairs(csr));
+
+	EXPECT_EQ(3, csr.vert(1).outs().count());
+	EXPECT_EQ(200, csr.vert(2).data());
+
+	// edge data is shared by both directions
+	int sum = 0;
+	for(auto& e : csr.vert(1).outs()) sum += e.edge().data();
+	EXPECT_EQ(60, sum);
+	EXPECT_EQ(30, csr.vert(3).out(FIRST).edge().data());
+
+	csr.vert(3).out(FIRST).edge().data() = 31;
+	EXPECT_EQ(31, csr.vert(1).out(LAST).edge().data());
+
+	// raw arrays
+	EXPECT_EQ(1, csr.out_offsets()[1]);
+	EXPECT_EQ(4, csr.out_offsets()[2]);
+	EXPECT_EQ(1, csr.out_targets()[0]);
+}
+
+
+TEST(Graph, freeze_directed_backlinks) {
+	Graph ::DIRECTED ::BACKLINKS g(3);
+	g.edges().add(0, 1);
+	g.edges().add(2, 1);
+	g.edges().add(1, 0);
+
+	auto csr = g.freeze();
+	EXPECT_EQ(out_pairs(g), out_pairs(csr));
+
+	std::multiset<int> r;
+	for(auto& e : csr.vert(1).ins()) r.emplace( e.vert().handle() );
+	EXPECT_EQ(std::multiset<int>({0,2}), r);
+
+	EXPECT_EQ(0, csr.vert(2).ins().count());
+	EXPECT_EQ(1, csr.vert(0).ins().count());
+}
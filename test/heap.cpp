@@ -0,0 +1,190 @@
+#include "common.hpp"
+
+#include <salgo/heap>
+#include <salgo/pairing-heap>
+
+#include <gtest/gtest.h>
+
+#include <functional> // std::greater
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace salgo;
+
+
+
+namespace {
+
+// random push / pop / update / decrease_key / erase, checked against std::multiset
+template<class HEAP>
+void check_random() {
+	srand(69);
+
+	HEAP heap;
+	std::multiset<int> ref;
+	std::vector< typename HEAP::Handle > handles;
+
+	auto erase_handle = [&](int i) {
+		handles[i] = handles.back();
+		handles.pop_back();
+	};
+
+	for(int iter=0; iter<100000; ++iter) {
+		int op = rand() % 10;
+
+		if(op < 4 || handles.empty()) {
+			int v = rand() % 1000;
+			handles.emplace_back( heap.push(v).handle() );
+			ref.insert(v);
+		}
+		else if(op < 6) {
+			EXPECT_EQ(*ref.begin(), heap.top());
+			auto h = heap(FIRST).handle();
+			for(int i=0; i<(int)handles.size(); ++i) if(handles[i] == h) { erase_handle(i); break; }
+			heap.pop();
+			ref.erase(ref.begin());
+		}
+		else {
+			int i = rand() % handles.size();
+			auto h = handles[i];
+			int old = heap[h];
+			ref.erase( ref.find(old) );
+
+			if(op == 6) {
+				int v = old - rand() % 100;
+				heap.decrease_key(h, v);
+				ref.insert(v);
+			}
+			else if(op == 7) {
+				int v = rand() % 1000;
+				heap(h).update(v);
+				ref.insert(v);
+			}
+			else if(op == 8) {
+				heap[h] += rand() % 100 - 50; // modify in place
+				heap.update(h);
+				ref.insert(heap[h]);
+			}
+			else {
+				heap(h).erase();
+				erase_handle(i);
+			}
+		}
+
+		ASSERT_EQ((int)ref.size(), heap.count());
+		if(!ref.empty()) {
+			ASSERT_EQ(*ref.begin(), heap.top());
+		}
+	}
+
+	// handles stay valid while values move
+	for(auto& h : handles) EXPECT_TRUE( ref.count(heap[h]) );
+
+	// iteration visits all values
+	std::multiset<int> all;
+	for(auto& e : heap) all.insert(e);
+	EXPECT_EQ(ref, all);
+
+	// drain in sorted order
+	std::vector<int> sorted;
+	while(heap.not_empty()) {
+		sorted.emplace_back( heap.top() );
+		heap.pop();
+	}
+	EXPECT_EQ( std::vector<int>(ref.begin(), ref.end()), sorted );
+}
+
+} // namespace
+
+
+
+
+TEST(Heap, simple) {
+	Heap<int> heap;
+	EXPECT_TRUE( heap.is_empty() );
+
+	auto a = heap.push(5).handle();
+	auto b = heap.push(3).handle();
+	heap.push(8);
+
+	EXPECT_EQ(3, heap.top());
+	EXPECT_EQ(b, heap(FIRST).handle());
+	EXPECT_EQ(5, heap[a]);
+
+	heap.decrease_key(a, 1);
+	EXPECT_EQ(1, heap.top());
+
+	heap(a).erase();
+	EXPECT_EQ(3, heap.top());
+	EXPECT_EQ(2, heap.count());
+
+	heap.pop();
+	heap.pop();
+	EXPECT_TRUE( heap.is_empty() );
+}
+
+TEST(Heap, max_heap) {
+	Heap<int> ::COMPARE<std::greater<>> ::ARITY<2> heap;
+	for(int i : {4, 9, 1, 7}) heap.push(i);
+
+	std::vector<int> r;
+	while(heap.not_empty()) { r.emplace_back(heap.top()); heap.pop(); }
+	EXPECT_EQ((std::vector<int>{9, 7, 4, 1}), r);
+}
+
+TEST(Heap, random) {
+	check_random< Heap<int> >();
+	check_random< Heap<int> ::ARITY<2> >();
+	check_random< Heap<int> ::ARITY<8> >();
+}
+
+TEST(Heap, strings) {
+	Heap<std::string> heap;
+	for(auto s : {"pear", "apple", "fig", "banana"}) heap.push(s);
+
+	auto h = heap.push("cherry").handle();
+	heap(h).decrease_key("aardvark");
+
+	std::vector<std::string> r;
+	while(heap.not_empty()) { r.emplace_back( std::move(heap(FIRST)()) ); heap.pop(); }
+	EXPECT_EQ((std::vector<std::string>{"aardvark", "apple", "banana", "fig", "pear"}), r);
+}
+
+
+
+
+TEST(Pairing_Heap, simple) {
+	Pairing_Heap<int> heap;
+
+	auto a = heap.push(5).handle();
+	auto b = heap.push(3).handle();
+	heap.push(8);
+
+	EXPECT_EQ(3, heap.top());
+	EXPECT_EQ(b, heap(FIRST).handle());
+
+	heap(a).decrease_key(1);
+	EXPECT_EQ(1, heap.top());
+
+	heap.update(a, 10);
+	EXPECT_EQ(3, heap.top());
+
+	heap.erase(b);
+	EXPECT_EQ(8, heap.top());
+	EXPECT_EQ(2, heap.count());
+}
+
+TEST(Pairing_Heap, max_heap) {
+	Pairing_Heap<int> ::COMPARE<std::greater<>> heap;
+	for(int i : {4, 9, 1, 7}) heap.push(i);
+
+	std::vector<int> r;
+	while(heap.not_empty()) { r.emplace_back(heap.top()); heap.pop(); }
+	EXPECT_EQ((std::vector<int>{9, 7, 4, 1}), r);
+}
+
+TEST(Pairing_Heap, random) {
+	check_random< Pairing_Heap<int> >();
+}
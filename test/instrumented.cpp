@@ -0,0 +1,152 @@
+#include "common.hpp"
+
+#include <salgo/alloc/instrumented>
+#include <salgo/alloc/array-allocator>
+#include <salgo/alloc/random-allocator>
+#include <salgo/alloc/crude-allocator>
+#include <salgo/list>
+#include <salgo/graph/binary-forest>
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+using namespace salgo;
+
+
+
+TEST(Instrumented, counts) {
+	Instrumented< alloc::Array_Allocator<int> > alloc;
+
+	std::vector< decltype(alloc)::Handle > handles;
+	for(int i=0; i<100; ++i) handles.emplace_back( alloc.construct(i).handle() );
+	for(int i=0; i<100; i+=2) alloc( handles[i] ).destruct();
+	alloc.construct(123);
+
+	auto s = alloc.stats();
+	EXPECT_EQ(101, s.constructs);
+	EXPECT_EQ(50, s.destructs);
+	EXPECT_EQ(51, s.live);
+	EXPECT_EQ(100, s.peak_live);
+	EXPECT_EQ(51 * (long long)sizeof(int), s.bytes_used);
+	EXPECT_EQ(alloc.domain() * (long long)sizeof(int), s.bytes_reserved);
+
+	// probe stats are enabled automatically
+	EXPECT_EQ(101, s.probes.calls);
+
+	alloc.reset_stats();
+	EXPECT_EQ(0, alloc.stats().constructs);
+	EXPECT_EQ(101, alloc.stats().probes.calls);
+}
+
+
+
+TEST(Instrumented, destruct_through_iterators) {
+	Instrumented< alloc::Array_Allocator<int> > alloc;
+	for(int i=0; i<100; ++i) alloc.construct(i);
+
+	int sum = 0;
+	for(auto& e : alloc) sum += e();
+	EXPECT_EQ(99*100/2, sum);
+
+	for(auto& e : alloc) if(e() % 2) e.destruct();
+	EXPECT_EQ(50, alloc.stats().destructs);
+	EXPECT_EQ(50, alloc.stats().live);
+
+	for(auto& e : alloc) e.destruct();
+	alloc.construct(1);
+
+	auto s = alloc.stats();
+	EXPECT_EQ(101, s.constructs);
+	EXPECT_EQ(100, s.destructs);
+	EXPECT_EQ(1, s.live);
+	EXPECT_EQ(100, s.peak_live);
+}
+
+
+
+// both hole search strategies choose the same holes, so they report the same probe lengths
+TEST(Instrumented, probes_array_allocator) {
+	Instrumented< alloc::Array_Allocator<int> > linear;
+	Instrumented< alloc::Array_Allocator<int> ::FREE_BITMAP > bitmap;
+
+	std::vector< decltype(linear)::Handle > handles;
+	for(int i=0; i<1000; ++i) {
+		handles.emplace_back( linear.construct(i).handle() );
+		bitmap.construct(i);
+	}
+
+	srand(69);
+	for(int i=0; i<10000; ++i) {
+		auto& h = handles[ rand() % handles.size() ];
+		linear(h).destruct();
+		bitmap(h).destruct();
+
+		auto new_handle = linear.construct(i).handle();
+		EXPECT_EQ(new_handle, bitmap.construct(i).handle());
+		h = new_handle;
+	}
+
+	auto a = linear.stats().probes;
+	auto b = bitmap.stats().probes;
+	EXPECT_EQ(11000, a.calls);
+	EXPECT_EQ(a.calls, b.calls);
+	EXPECT_EQ(a.total, b.total);
+	EXPECT_EQ(a.max, b.max);
+	EXPECT_GT(a.max, 0);
+}
+
+
+
+TEST(Instrumented, probes_random_allocator) {
+	Instrumented< Random_Allocator<int> > alloc;
+
+	std::vector< decltype(alloc)::Handle > handles;
+	for(int i=0; i<1000; ++i) handles.emplace_back( alloc.construct(i).handle() );
+
+	srand(69);
+	for(int i=0; i<10000; ++i) {
+		auto& h = handles[ rand() % handles.size() ];
+		alloc(h).destruct();
+		h = alloc.construct(i).handle();
+	}
+
+	auto s = alloc.stats();
+	EXPECT_EQ(1000, s.live);
+	EXPECT_EQ(11000, s.probes.calls);
+	EXPECT_GE(s.probes.max, 1);
+	EXPECT_GT(s.bytes_reserved, s.bytes_used);
+}
+
+
+
+TEST(Instrumented, containers) {
+	{
+		List<int> ::ALLOCATOR< Instrumented< Crude_Allocator<int> > > list;
+		for(int i=0; i<100; ++i) list.emplace_back(i);
+		for(auto& e : list) if(e() % 2) e.erase();
+
+		auto s = list.allocator().stats();
+		EXPECT_EQ(50, s.live);
+		EXPECT_EQ(100, s.peak_live);
+		EXPECT_GE(s.bytes_reserved, s.bytes_used);
+	}
+
+	{
+		using namespace salgo::graph;
+		Binary_Forest ::PARENT_LINKS ::CHILD_LINKS ::DATA<int>
+			::ALLOCATOR< Instrumented< alloc::Array_Allocator<> > > tree;
+
+		auto root = tree.emplace(1);
+		root.emplace_left(2);
+		root.emplace_right(3);
+		root.left().emplace_left(4);
+
+		int sum = 0;
+		for(auto& e : tree) sum += e();
+		EXPECT_EQ(10, sum);
+
+		root.left().left().unlink_and_erase();
+		EXPECT_EQ(3, tree.allocator().stats().live);
+	}
+}
@@ -2,10 +2,13 @@
 
 #include <salgo/list>
 #include <salgo/alloc/salgo-from-std-allocator>
+#include <salgo/alloc/crude-allocator>
 
 #include <gtest/gtest.h>
 
 #include <list>
+#include <algorithm>
+#include <unordered_map>
 #include <chrono>
 
 using namespace salgo;
@@ -158,3 +161,288 @@ TEST(List, std_alloc) {
 
 
 
+
+
+
+
+
+
+TEST(List, unrolled_simple) {
+	List<int> ::UNROLLED<4> m;
+	for(int i=3; i<=10; ++i) m.emplace_back(i);
+	m.emplace_front(2);
+	m.emplace_front(1);
+
+	vector<int> vals;
+	for(auto& e : m) vals.push_back( e );
+
+	EXPECT_EQ(vector<int>({1,2,3,4,5,6,7,8,9,10}), vals);
+	EXPECT_EQ(10, m[LAST]);
+}
+
+
+template<class LIST>
+static vector<int> values(const LIST& m) {
+	vector<int> r;
+	for(auto& e : m) r.push_back( e() );
+	return r;
+}
+
+TEST(List, unrolled_handles_survive_splits_and_merges) {
+	List<int> ::COUNTABLE ::UNROLLED<4> m;
+	std::list<int> want;
+
+	vector<decltype(m)::Handle> handles;
+	handles.push_back( m.emplace_back(0) );
+	want.push_back(0);
+
+	// insert in the middle to force node splits
+	for(int i=1; i<200; ++i) {
+		auto h = handles[ rand() % handles.size() ];
+		auto it = want.begin();
+		while(*it != m[h]) ++it;
+
+		if(i % 2) {
+			handles.push_back( m(h).emplace_after(i) );
+			want.insert( std::next(it), i );
+		}
+		else {
+			handles.push_back( m(h).emplace_before(i) );
+			want.insert( it, i );
+		}
+	}
+
+	for(int i=0; i<(int)handles.size(); ++i) EXPECT_EQ(i, m[ handles[i] ]);
+	EXPECT_EQ(vector<int>(want.begin(), want.end()), values(m));
+
+	// erase most elements, forcing merges
+	for(int i=0; i<(int)handles.size(); ++i) if(i % 5) {
+		m(handles[i]).erase();
+		want.remove(i);
+	}
+
+	EXPECT_EQ(40, m.count());
+	for(int i=0; i<(int)handles.size(); i += 5) EXPECT_EQ(i, m[ handles[i] ]);
+	EXPECT_EQ(vector<int>(want.begin(), want.end()), values(m));
+}
+
+
+TEST(List, unrolled_no_invalidation) {
+	List<int> ::UNROLLED<2> m;
+	m.emplace_back(11);
+	m.emplace_back(2);
+	m.emplace_back(13);
+	m.emplace_back(14);
+	m.emplace_back(5);
+
+	{
+		int sum = 0;
+		for(auto& e : m) {
+			sum += e;
+			if(e >= 10) e.erase();
+		}
+		EXPECT_EQ(45, sum);
+	}
+
+	{
+		int sum = 0;
+		for(auto& e : m) {
+			sum += e;
+			if(e < 100) e.emplace_after(100);
+		}
+		EXPECT_EQ(7 + 200, sum);
+	}
+}
+
+
+TEST(List, unrolled_nontrivial) {
+	using T = Movable;
+	T::reset();
+
+	{
+		List<T> ::COUNTABLE ::UNROLLED<8> li;
+
+		for(int i=0; i<100; ++i) {
+			li.emplace_back( rand() );
+			li.emplace_front( rand() );
+		}
+
+		for(int i=0; i<10; ++i) {
+			int ith = 0;
+			for(auto& e : li) {
+				if(ith%2) {
+					e.erase();
+					li.emplace_front( rand() );
+				}
+				else if(ith%3 == 0) e.emplace_after( rand() );
+
+				++ith;
+			}
+		}
+	}
+
+	EXPECT_EQ(T::constructors(), T::destructors());
+	EXPECT_NE(T::constructors(), 0);
+}
+
+
+
+
+
+
+
+
+
+TEST(List, splice_same_list) {
+	List<int> ::COUNTABLE m = {1,2,3,4,5,6};
+
+	auto h2 = m(FIRST).next();
+	auto h5 = m(LAST).prev();
+
+	m.splice(m(FIRST), m, h2, h5); // 2,3,4 to the front
+	EXPECT_EQ(vector<int>({2,3,4,1,5,6}), values(m));
+
+	m.splice({}, m, h2, m(FIRST).next().next().next()); // 2,3,4 to the end
+	EXPECT_EQ(vector<int>({1,5,6,2,3,4}), values(m));
+
+	m.splice(h5, m, h2); // 2,3,4 before 5
+	EXPECT_EQ(vector<int>({1,2,3,4,5,6}), values(m));
+
+	EXPECT_EQ(6, m.count());
+	EXPECT_EQ(2, m[h2]);
+	EXPECT_EQ(5, m[h5]);
+}
+
+
+TEST(List, splice_shared_allocator) {
+	List<int> ::COUNTABLE ::ALLOCATOR< Crude_Allocator<int> ::SINGLETON > a = {1,2,3}, b = {4,5,6};
+
+	auto h5 = b(FIRST).next().handle();
+
+	a.splice(a(FIRST).next(), b, h5); // handles are preserved
+	EXPECT_EQ(vector<int>({1,5,6,2,3}), values(a));
+	EXPECT_EQ(vector<int>({4}), values(b));
+	EXPECT_EQ(5, a.count());
+	EXPECT_EQ(1, b.count());
+	EXPECT_EQ(5, a[h5]);
+
+	a.splice({}, b);
+	EXPECT_EQ(vector<int>({1,5,6,2,3,4}), values(a));
+	EXPECT_TRUE(b.is_empty());
+	EXPECT_EQ(6, a.count());
+	EXPECT_EQ(0, b.count());
+	EXPECT_EQ(4, a[LAST]);
+}
+
+
+TEST(List, splice_separate_allocators) {
+	using T = Movable;
+	T::reset();
+
+	{
+		List<T> ::COUNTABLE a, b;
+		for(int i=0; i<3; ++i) a.emplace_back(i);
+		for(int i=3; i<6; ++i) b.emplace_back(i);
+
+		a.splice(a(FIRST), b, b(FIRST).next());
+		EXPECT_EQ(vector<int>({4,5,0,1,2}), values(a));
+		EXPECT_EQ(vector<int>({3}), values(b));
+		EXPECT_EQ(5, a.count());
+		EXPECT_EQ(1, b.count());
+	}
+
+	EXPECT_EQ(T::constructors(), T::destructors());
+}
+
+
+TEST(List, merge) {
+	List<int> ::COUNTABLE a = {1,3,3,7,9}, b = {0,2,3,8,10,11};
+
+	a.merge(b);
+	EXPECT_EQ(vector<int>({0,1,2,3,3,3,7,8,9,10,11}), values(a));
+	EXPECT_TRUE(b.is_empty());
+	EXPECT_EQ(11, a.count());
+	EXPECT_EQ(0, b.count());
+
+	List<int> c = {5,4,1};
+	List<int> d = {6,2};
+	c.merge(d, std::greater<>());
+	EXPECT_EQ(vector<int>({6,5,4,2,1}), values(c));
+}
+
+
+TEST(List, sort) {
+	for(int n : {0, 1, 2, 3, 7, 100, 1000}) {
+		List< pair<int,int> > m;
+		vector< pair<int,int> > want;
+		vector< decltype(m)::Handle > handles;
+
+		for(int i=0; i<n; ++i) {
+			handles.emplace_back( m.emplace_back( rand() % 10, i ).handle() );
+			want.emplace_back( m[LAST] );
+		}
+
+		auto by_first = [](auto& x, auto& y){ return x.first < y.first; };
+		m.sort(by_first);
+		std::stable_sort(want.begin(), want.end(), by_first);
+
+		vector< pair<int,int> > vals;
+		for(auto& e : m) vals.push_back(e);
+		EXPECT_EQ(want, vals);
+
+		// handles stay valid
+		for(int i=0; i<n; ++i) EXPECT_EQ(i, m[ handles[i] ].second);
+
+		// backward links
+		vals.clear();
+		for(auto e = m(LAST); e.found(); e = e.prev()) vals.push_back(e);
+		std::reverse(vals.begin(), vals.end());
+		EXPECT_EQ(want, vals);
+	}
+}
+
+
+TEST(List, linearize) {
+	using T = Movable;
+	T::reset();
+
+	{
+		List<T> ::COUNTABLE m;
+		std::list<int> want;
+
+		for(int i=0; i<1000; ++i) {
+			if(rand()%2) { m.emplace_back(i); want.emplace_back(i); }
+			else { m.emplace_front(i); want.emplace_front(i); }
+		}
+
+		int ith = 0;
+		for(auto& e : m) if(ith++ % 3 == 0) e.erase();
+		ith = 0;
+		want.remove_if([&](int){ return ith++ % 3 == 0; });
+
+		auto h = m(FIRST).next().next().handle();
+		int val = m[h];
+
+		std::unordered_map<int,int> remap;
+		m.linearize([&](auto old_handle, auto new_handle) { remap[old_handle] = new_handle; });
+
+		EXPECT_EQ(vector<int>(want.begin(), want.end()), values(m));
+		EXPECT_EQ((int)want.size(), m.count());
+		EXPECT_EQ((int)want.size(), (int)remap.size());
+		EXPECT_EQ(val, m[ decltype(h)( remap[h] ) ]);
+
+		// stored in list order
+		int i = 0;
+		for(auto& e : m) EXPECT_EQ(i++, (int)e.handle());
+
+		// backward links
+		vector<int> backward;
+		for(auto e = m(LAST); e.found(); e = e.prev()) backward.push_back( e() );
+		EXPECT_EQ(vector<int>(want.rbegin(), want.rend()), backward);
+
+		m.emplace_back(-1);
+		EXPECT_EQ(-1, m[LAST]);
+	}
+
+	EXPECT_EQ(T::constructors(), T::destructors());
+}
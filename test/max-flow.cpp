@@ -0,0 +1,201 @@
+#include <salgo/graph/max-flow>
+#include <salgo/graph/graph>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <queue>
+#include <tuple>
+#include <vector>
+
+using namespace salgo;
+using namespace salgo::graph;
+
+
+
+
+
+namespace {
+
+using Edges = std::vector<std::tuple<int,int,int>>; // from, to, capacity
+
+// Edmonds-Karp on a capacity matrix
+long long reference_max_flow(int n, const Edges& edges, int s, int t) {
+	std::vector<std::vector<long long>> cap(n, std::vector<long long>(n));
+	for(auto& [a,b,c] : edges) cap[a][b] += c;
+
+	long long total = 0;
+	for(;;) {
+		std::vector<int> parent(n, -1);
+		parent[s] = s;
+		std::queue<int> q;
+		q.push(s);
+		while(!q.empty() && parent[t] == -1) {
+			int v = q.front(); q.pop();
+			for(int u=0; u<n; ++u) if(parent[u] == -1 && cap[v][u] > 0) {
+				parent[u] = v;
+				q.push(u);
+			}
+		}
+		if(parent[t] == -1) return total;
+
+		long long f = 1LL << 60;
+		for(int v=t; v!=s; v=parent[v]) f = std::min(f, cap[parent[v]][v]);
+		for(int v=t; v!=s; v=parent[v]) {
+			cap[parent[v]][v] -= f;
+			cap[v][parent[v]] += f;
+		}
+		total += f;
+	}
+}
+
+Edges random_edges(int n, int m, int max_cap) {
+	Edges edges;
+	for(int i=0; i<m; ++i) edges.emplace_back( rand() % n, rand() % n, rand() % (max_cap+1) );
+	return edges;
+}
+
+auto capacity = [](auto& out) { return (long long)out.edge().data(); };
+
+// capacity constraints, conservation, and the cut
+template<class G, class RESULT>
+void check_flow(G& g, const RESULT& r, int n, int s, int t) {
+	std::vector<long long> balance(n);
+	for(auto& vert : g.verts()) {
+		for(auto& out : vert.outs()) {
+			long long f = r.flow[ out.edge().handle() ];
+			EXPECT_GE(f, 0);
+			EXPECT_LE(f, capacity(out));
+			balance[ vert.handle() ] -= f;
+			balance[ out.vert().handle() ] += f;
+		}
+	}
+
+	for(int v=0; v<n; ++v) {
+		if(v == s) EXPECT_EQ(-r.value, balance[v]);
+		else if(v == t) EXPECT_EQ(r.value, balance[v]);
+		else EXPECT_EQ(0, balance[v]) << "vertex " << v;
+	}
+}
+
+template<class G, class RESULT>
+void check_cut(G& g, const RESULT& r, int s, int t) {
+	EXPECT_TRUE(r.source_side[s]);
+	EXPECT_FALSE(r.source_side[t]);
+
+	long long cut = 0;
+	int num_cut_edges = 0;
+	for(auto& vert : g.verts()) {
+		for(auto& out : vert.outs()) {
+			if(r.source_side[ vert.handle() ] && !r.source_side[ out.vert().handle() ]) {
+				cut += capacity(out);
+				++num_cut_edges;
+			}
+		}
+	}
+	EXPECT_EQ(r.value, cut);
+	EXPECT_EQ(num_cut_edges, (int)r.edges.size());
+}
+
+template<class G>
+void check_all(G& g, int n, int s, int t, long long expected) {
+	auto dinic = max_flow(g, s, t, capacity);
+	EXPECT_EQ(expected, dinic.value);
+	check_flow(g, dinic, n, s, t);
+	check_cut(g, dinic, s, t);
+
+	auto pr = max_flow_push_relabel(g, s, t, capacity);
+	EXPECT_EQ(expected, pr.value);
+	check_flow(g, pr, n, s, t);
+	check_cut(g, pr, s, t);
+
+	auto cut = min_cut(g, s, t, capacity);
+	EXPECT_EQ(expected, cut.value);
+	check_cut(g, cut, s, t);
+}
+
+} // namespace
+
+
+
+
+TEST(Max_Flow, random) {
+	srand(69);
+	for(int iter=0; iter<50; ++iter) {
+		const int n = 2 + rand() % 60;
+		auto edges = random_edges(n, rand() % (6*n), 1 + rand() % 100);
+		int s = rand() % n;
+		int t = (s + 1 + rand() % (n-1)) % n;
+
+		Graph ::DIRECTED ::EDGE_DATA<int> g(n);
+		for(auto& [a,b,c] : edges) g.edges().add(a, b, c);
+
+		auto expected = reference_max_flow(n, edges, s, t);
+		check_all(g, n, s, t, expected);
+
+		auto csr = g.freeze();
+		check_all(csr, n, s, t, expected);
+	}
+}
+
+
+
+TEST(Max_Flow, backlinks) {
+	srand(69);
+	const int n = 300;
+	auto edges = random_edges(n, 8*n, 1000);
+
+	Graph ::DIRECTED ::BACKLINKS ::EDGE_DATA<int> g(n);
+	for(auto& [a,b,c] : edges) g.edges().add(a, b, c);
+
+	check_all(g, n, 0, n-1, reference_max_flow(n, edges, 0, n-1));
+}
+
+
+
+TEST(Max_Flow, bipartite_matching) {
+	// source 0, left 1..L, right L+1..2L, sink 2L+1
+	srand(69);
+	const int L = 500;
+	const int s = 0, t = 2*L + 1;
+
+	Graph ::DIRECTED ::EDGE_DATA<int> g(2*L + 2);
+	for(int i=1; i<=L; ++i) {
+		g.edges().add(s, i, 1);
+		g.edges().add(L + i, t, 1);
+	}
+
+	// left i is matched to right i, plus random extra edges
+	for(int i=1; i<=L; ++i) {
+		g.edges().add(i, L + i, 1);
+		for(int j=0; j<3; ++j) g.edges().add(i, L + 1 + rand() % L, 1);
+	}
+
+	check_all(g, 2*L + 2, s, t, L);
+}
+
+
+
+TEST(Max_Flow, simple) {
+	//   1
+	//  / \      capacities: 0->1: 3, 0->2: 2, 1->2: 5, 1->3: 2, 2->3: 3
+	// 0   3
+	//  \ /
+	//   2
+	Graph ::DIRECTED ::EDGE_DATA<int> g(5);
+	g.edges().add(0, 1, 3);
+	g.edges().add(0, 2, 2);
+	g.edges().add(1, 2, 5);
+	g.edges().add(1, 3, 2);
+	g.edges().add(2, 3, 3);
+
+	auto r = max_flow(g, 0, 3, capacity);
+	EXPECT_EQ(5, r.value);
+	EXPECT_EQ(3, r.flow[ g.vert(0).out(FIRST).edge().handle() ]); // 0->1
+	EXPECT_FALSE(r.source_side[4]); // unreachable
+
+	// sink unreachable
+	auto z = max_flow_push_relabel(g, 0, 4, capacity);
+	EXPECT_EQ(0, z.value);
+	EXPECT_TRUE(z.edges.empty());
+}
@@ -4,6 +4,9 @@
 
 #include <gtest/gtest.h>
 
+#include <sys/mman.h>
+#include <climits>
+
 using namespace salgo;
 
 
@@ -201,3 +204,63 @@ TEST(Memory_Block, begin_returns_first_existing) {
 	EXPECT_TRUE( block.begin()->is_constructed() );
 	EXPECT_EQ( 123, block.begin()->data() );
 }
+
+
+
+TEST(Memory_Block, handle_width) {
+	Memory_Block<int> ::CONSTRUCTED_FLAGS ::HANDLE_INT<uint16_t> block(1000);
+	static_assert(sizeof(decltype(block)::Handle) == 2);
+
+	for(int i=0; i<1000; i+=3) block(i).construct(i);
+
+	int sum = 0;
+	for(auto& e : block) {
+		EXPECT_EQ(e.handle(), e());
+		sum += e();
+	}
+	EXPECT_EQ(166833, sum);
+
+	EXPECT_FALSE( decltype(block)::Handle().valid() );
+	EXPECT_EQ( 65535, decltype(block)::Max_Domain );
+}
+
+
+
+namespace {
+// pages are only backed by memory when touched, and nodes are left unconstructed
+template<class T>
+struct Lazy_Allocator {
+	using value_type = T;
+
+	Lazy_Allocator() = default;
+	template<class U> Lazy_Allocator(const Lazy_Allocator<U>&) {}
+
+	T* allocate(size_t n) {
+		void* p = mmap(nullptr, n * sizeof(T), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+		CHECK(p != MAP_FAILED);
+		return (T*)p;
+	}
+
+	void deallocate(T* p, size_t n) { munmap(p, n * sizeof(T)); }
+
+	template<class... ARGS> void construct(T*, ARGS&&...) {}
+	void destroy(T*) {}
+};
+} // namespace
+
+TEST(Memory_Block, handle_width_past_int_max) {
+	using Block = Memory_Block<char> ::ALLOCATOR< Lazy_Allocator<char> > ::HANDLE_INT<int64_t>;
+	static_assert(std::is_same_v<int64_t, Block::Index_Int>);
+	static_assert(Block::Max_Domain > INT_MAX);
+
+	const int64_t size = (1LL << 31) + 10;
+	Block block(size);
+	EXPECT_EQ( size, block.domain() );
+
+	const int64_t idx = (1LL << 31) + 5;
+	block(idx).construct('x');
+	block(3).construct('y');
+	EXPECT_EQ( 'x', block[idx] );
+	EXPECT_EQ( 'y', block[3] );
+	EXPECT_EQ( idx, block(idx).handle() );
+}
@@ -0,0 +1,148 @@
+#include "common.hpp"
+
+#include <salgo/alloc/memory-resource>
+#include <salgo/alloc/pmr-allocator>
+#include <salgo/list>
+#include <salgo/hash-table>
+
+#include <gtest/gtest.h>
+
+#include <cstdint> // uintptr_t
+#include <list>
+#include <map>
+#include <vector>
+
+using namespace salgo;
+
+
+
+
+TEST(Salgo_Memory_Resource, size_classes) {
+	using R = Salgo_Memory_Resource;
+
+	EXPECT_EQ(0, R::size_class(1, 1));
+	EXPECT_EQ(0, R::size_class(8, 8));
+	EXPECT_EQ(1, R::size_class(9, 1));
+	EXPECT_EQ(1, R::size_class(4, 16));
+	EXPECT_EQ(R::Num_Classes-1, R::size_class(R::Max_Size, 8));
+
+	EXPECT_EQ(-1, R::size_class(R::Max_Size+1, 8));
+	EXPECT_EQ(-1, R::size_class(8, 2*alignof(std::max_align_t)));
+}
+
+
+
+TEST(Salgo_Memory_Resource, reuse) {
+	Salgo_Memory_Resource r;
+
+	void* a = r.allocate(24, 8);
+	void* b = r.allocate(32, 8);
+	EXPECT_EQ(32, (char*)b - (char*)a); // same size class - packed together
+
+	r.deallocate(a, 24, 8);
+	EXPECT_EQ(a, r.allocate(20, 4)); // freed block is reused
+
+	EXPECT_EQ(4096, r.bytes_reserved()); // first arena page of a single size class
+
+	r.deallocate(a, 20, 4);
+	r.deallocate(b, 32, 8);
+}
+
+
+
+TEST(Salgo_Memory_Resource, alignment_and_upstream) {
+	Salgo_Memory_Resource r;
+
+	for(std::size_t align = 1; align <= 256; align *= 2) {
+		for(std::size_t bytes : {1, 7, 100, 5000}) {
+			void* p = r.allocate(bytes, align);
+			EXPECT_EQ(0u, (std::uintptr_t)p % align);
+			r.deallocate(p, bytes, align);
+		}
+	}
+
+	EXPECT_TRUE( r.is_equal(r) );
+	Salgo_Memory_Resource other;
+	EXPECT_FALSE( r.is_equal(other) );
+}
+
+
+
+TEST(Salgo_Memory_Resource, std_pmr_containers) {
+	Salgo_Memory_Resource r;
+
+	std::pmr::list<int> l(&r);
+	std::pmr::map<int,int> m(&r);
+	std::pmr::vector<int> v(&r);
+
+	srand(69);
+	std::map<int,int> m_ref;
+	for(int i=0; i<10000; ++i) {
+		l.push_back(i);
+		v.push_back(i);
+		int k = rand() % 1000;
+		m[k] += i;
+		m_ref[k] += i;
+		if(rand() % 2) {
+			k = rand() % 1000;
+			m.erase(k);
+			m_ref.erase(k);
+		}
+	}
+
+	EXPECT_EQ(10000u, l.size());
+	EXPECT_EQ(9999, v.back());
+
+	std::map<int,int> m_copy(m.begin(), m.end());
+	EXPECT_EQ(m_ref, m_copy);
+	EXPECT_GT(r.bytes_reserved(), 0);
+}
+
+
+
+TEST(Pmr_Allocator, list) {
+	Salgo_Memory_Resource r;
+
+	{
+		List<int> ::PMR list(&r);
+		for(int i=0; i<100; ++i) list.emplace_back(i);
+		for(auto& e : list) if(e() % 2) e.erase();
+
+		int sum = 0;
+		for(auto& e : list) sum += e;
+		EXPECT_EQ(2450, sum);
+		EXPECT_EQ(&r, list.allocator().resource());
+
+		// relocated nodes stay in the same resource
+		list.linearize();
+		EXPECT_EQ(&r, list.allocator().resource());
+
+		sum = 0;
+		for(auto& e : list) sum += e;
+		EXPECT_EQ(2450, sum);
+	}
+
+	{
+		List<int> ::PMR list; // default resource
+		list.emplace_back(1);
+		EXPECT_EQ(std::pmr::get_default_resource(), list.allocator().resource());
+	}
+}
+
+
+
+TEST(Pmr_Allocator, hash_table) {
+	Salgo_Memory_Resource r;
+	Hash_Table<int, int> ::PMR m(&r);
+
+	for(int i=0; i<1000; ++i) m.emplace(i, i*i);
+	for(int i=0; i<1000; i+=2) m(i).erase();
+
+	for(int i=0; i<1000; ++i) {
+		EXPECT_EQ(i%2 == 1, m(i).found());
+		if(i%2) {
+			EXPECT_EQ(i*i, m[i]);
+		}
+	}
+	EXPECT_EQ(&r, m.allocator().resource());
+}
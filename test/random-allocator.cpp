@@ -0,0 +1,146 @@
+#include "common.hpp"
+
+#include <salgo/alloc/random-allocator>
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <vector>
+
+using namespace salgo;
+
+
+
+
+
+TEST(Random_Allocator, simple) {
+	Random_Allocator<int> alloc;
+
+	std::vector< Random_Allocator<int>::Handle > handles;
+	for(int i=0; i<100; ++i) {
+		handles.emplace_back( alloc.construct(i).handle() );
+	}
+
+	for(int i=0; i<100; i+=2) alloc( handles[i] ).destruct();
+	for(int i=1; i<100; i+=2) EXPECT_EQ(i, alloc[ handles[i] ]);
+
+	// holes are reused before the next chunk is allocated
+	auto reserved = alloc.bytes_reserved();
+	for(int i=0; i<50; ++i) alloc.construct(-1);
+	EXPECT_EQ(reserved, alloc.bytes_reserved());
+}
+
+
+
+
+TEST(Random_Allocator, reproducible) {
+	auto run = [](Random_Allocator<int>& alloc) {
+		std::vector< Random_Allocator<int>::Handle > handles;
+		for(int i=0; i<1000; ++i) handles.emplace_back( alloc.construct(i).handle() );
+
+		std::vector< Random_Allocator<int>::Handle > result;
+		for(int i=0; i<1000; ++i) {
+			auto& h = handles[ (i * 7919) % 1000 ];
+			alloc(h).destruct();
+			h = alloc.construct(i).handle();
+			result.emplace_back(h);
+		}
+		return result;
+	};
+
+	Random_Allocator<int> a, b, c;
+
+	// unaffected by the global generator
+	rand_32();
+
+	c.seed(123);
+	auto ra = run(a);
+	auto rb = run(b);
+	auto rc = run(c);
+	EXPECT_EQ(ra, rb);
+	EXPECT_NE(ra, rc);
+}
+
+
+
+
+TEST(Random_Allocator, high_load) {
+	Random_Allocator<int> ::PROBE_STATS alloc;
+
+	// fill 3 chunks completely (1 + 2 + ... + 2^15 elements)
+	const int N = (1<<16) - 1;
+	std::vector< Random_Allocator<int>::Handle > handles;
+	for(int i=0; i<N; ++i) handles.emplace_back( alloc.construct(i).handle() );
+
+	auto reserved = alloc.bytes_reserved();
+
+	// keep 95% load
+	std::map<int, Random_Allocator<int>::Handle> alive;
+	for(int i=0; i<N; ++i) alive.emplace(i, handles[i]);
+
+	srand(69);
+	for(int i=0; i<N/20; ++i) {
+		auto it = alive.lower_bound( rand() % N );
+		if(it == alive.end()) it = alive.begin();
+		alloc( it->second ).destruct();
+		alive.erase(it);
+	}
+
+	for(int i=0; i<100000; ++i) {
+		auto it = alive.lower_bound( rand() % N );
+		if(it == alive.end()) it = alive.begin();
+		int key = it->first;
+		alloc( it->second ).destruct();
+		alive.erase(it);
+
+		alive.emplace(key, alloc.construct(key).handle());
+	}
+
+	for(auto& [k, h] : alive) EXPECT_EQ(k, alloc[h]);
+
+	EXPECT_EQ(reserved, alloc.bytes_reserved());
+	EXPECT_LT(alloc.probe_stats().average(), 100);
+}
+
+
+
+
+TEST(Random_Allocator, construct_near) {
+	Random_Allocator<int> alloc;
+
+	std::vector< Random_Allocator<int>::Handle > handles;
+	for(int i=0; i<1023; ++i) handles.emplace_back( alloc.construct(i).handle() );
+
+	alloc( handles[500] ).destruct();
+	alloc( handles[10] ).destruct();
+
+	auto h = alloc.construct_near( handles[503], -1 ).handle();
+	EXPECT_EQ(handles[500], h);
+
+	// the remaining hole is still found by construct()
+	h = alloc.construct(-2).handle();
+	EXPECT_EQ(handles[10], h);
+}
+
+
+
+
+TEST(Random_Allocator, destruct_through_iterators) {
+	Random_Allocator<int> alloc;
+
+	long long reserved = 0;
+	for(int round=0; round<5; ++round) {
+		for(int i=0; i<1000; ++i) alloc.construct(i);
+
+		int sum = 0;
+		for(auto& e : alloc) sum += e();
+		EXPECT_EQ(999*1000/2, sum);
+
+		// holes are tracked, so the next round reuses them
+		for(auto& e : alloc) e.destruct();
+		EXPECT_TRUE(alloc.begin() == alloc.end());
+
+		if(round == 0) reserved = alloc.bytes_reserved();
+		EXPECT_EQ(reserved, alloc.bytes_reserved());
+	}
+}
@@ -0,0 +1,177 @@
+#include <salgo/graph/reorder-vertices>
+#include <salgo/graph/graph>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdlib> // std::abs
+#include <tuple>
+#include <utility> // std::pair
+#include <vector>
+
+using namespace salgo;
+using namespace salgo::graph;
+
+
+
+
+
+namespace {
+
+constexpr Vertex_Order All_Orders[] = { Vertex_Order::BFS, Vertex_Order::RCM, Vertex_Order::DEGREE, Vertex_Order::GORDER };
+
+using Edges = std::vector<std::tuple<int,int,int>>; // from, to, data
+
+// edges in terms of original vertex ids (stored as vertex data), sorted
+template<class G>
+Edges edges_by_vert_data(G& g) {
+	Edges result;
+	for(auto& vert : g.verts()) {
+		for(auto& out : vert.outs()) result.emplace_back( vert.data(), out.vert().data(), out.edge().data() );
+	}
+	std::sort(result.begin(), result.end());
+	return result;
+}
+
+template<class NEW_INDEX>
+void check_permutation(const NEW_INDEX& new_index, int n) {
+	ASSERT_EQ(n, new_index.domain());
+	std::vector<bool> used(n);
+	for(int v=0; v<n; ++v) {
+		ASSERT_TRUE(new_index[v] >= 0 && new_index[v] < n);
+		EXPECT_FALSE(used[ new_index[v] ]) << "duplicate " << new_index[v];
+		used[ new_index[v] ] = true;
+	}
+}
+
+template<class G>
+void check_reorder(int n, int m) {
+	for(auto strategy : All_Orders) {
+		srand(69);
+		G g(n);
+		for(int v=0; v<n; ++v) g.vert(v).data() = v;
+		for(int i=0; i<m; ++i) g.edges().add( rand() % n, rand() % n, i );
+
+		auto expected = edges_by_vert_data(g);
+		auto new_index = reorder_vertices(g, strategy);
+		check_permutation(new_index, n);
+
+		for(int v=0; v<n; ++v) EXPECT_EQ(v, g.vert( new_index[v] ).data());
+		EXPECT_EQ(expected, edges_by_vert_data(g));
+
+		// the snapshot sees the new order
+		auto csr = g.freeze();
+		Edges csr_edges;
+		for(auto& vert : csr.verts()) {
+			for(auto& out : vert.outs()) csr_edges.emplace_back( g.vert(vert.handle()).data(), g.vert(out.vert().handle()).data(), out.edge().data() );
+		}
+		std::sort(csr_edges.begin(), csr_edges.end());
+		EXPECT_EQ(expected, csr_edges);
+	}
+}
+
+// max and sum of |new_index[a] - new_index[b]| over edges of the grid
+template<class NEW_INDEX>
+std::pair<int,long long> grid_gaps(int w, int h, const NEW_INDEX& new_index) {
+	int max = 0;
+	long long sum = 0;
+	auto add = [&](int a, int b) {
+		int gap = std::abs( new_index[a] - new_index[b] );
+		max = std::max(max, gap);
+		sum += gap;
+	};
+	for(int y=0; y<h; ++y) {
+		for(int x=0; x<w; ++x) {
+			int v = y*w + x;
+			if(x+1 < w) add(v, v+1);
+			if(y+1 < h) add(v, v+w);
+		}
+	}
+	return {max, sum};
+}
+
+} // namespace
+
+
+
+
+
+TEST(Reorder_Vertices, undirected) {
+	check_reorder< Graph ::VERT_DATA<int> ::EDGE_DATA<int> >(500, 1500);
+}
+
+TEST(Reorder_Vertices, directed) {
+	check_reorder< Graph ::DIRECTED ::VERT_DATA<int> ::EDGE_DATA<int> >(500, 1500);
+}
+
+TEST(Reorder_Vertices, backlinks) {
+	using G = Graph ::DIRECTED ::BACKLINKS ::VERT_DATA<int> ::EDGE_DATA<int>;
+	check_reorder<G>(500, 1500);
+
+	srand(69);
+	const int n = 300;
+	G g(n);
+	for(int v=0; v<n; ++v) g.vert(v).data() = v;
+	for(int i=0; i<4*n; ++i) g.edges().add( rand() % n, rand() % n, i );
+	reorder_vertices(g, Vertex_Order::GORDER);
+
+	// in-edges mirror out-edges
+	Edges outs, ins;
+	for(auto& vert : g.verts()) {
+		for(auto& out : vert.outs()) outs.emplace_back( vert.data(), out.vert().data(), out.edge().data() );
+		for(auto& in : vert.ins()) ins.emplace_back( in.vert().data(), vert.data(), in.edge().data() );
+	}
+	std::sort(outs.begin(), outs.end());
+	std::sort(ins.begin(), ins.end());
+	EXPECT_EQ(outs, ins);
+}
+
+
+
+TEST(Reorder_Vertices, orders) {
+	// 40 x 30 grid, vertices numbered randomly
+	const int w = 40, h = 30, n = w*h;
+	std::vector<int> label(n);
+	for(int i=0; i<n; ++i) label[i] = i;
+	srand(69);
+	for(int i=n-1; i>0; --i) std::swap(label[i], label[rand() % (i+1)]);
+
+	auto make = [&]() {
+		Graph ::EDGE_DATA<int> g(n);
+		for(int y=0; y<h; ++y) {
+			for(int x=0; x<w; ++x) {
+				int v = y*w + x;
+				if(x+1 < w) g.edges().add(label[v], label[v+1], 0);
+				if(y+1 < h) g.edges().add(label[v], label[v+w], 0);
+			}
+		}
+		return g;
+	};
+
+	// new index by grid position
+	auto by_position = [&](const auto& new_index) {
+		std::vector<int> result(n);
+		for(int i=0; i<n; ++i) result[i] = new_index[ label[i] ];
+		return result;
+	};
+
+	auto [label_bandwidth, label_sum] = grid_gaps(w, h, label);
+	EXPECT_GT(label_bandwidth, n/2);
+
+	auto g = make();
+	auto rcm = by_position( reorder_vertices(g, Vertex_Order::RCM) );
+	EXPECT_LE(grid_gaps(w, h, rcm).first, h + 1); // diagonal sweep from a corner
+
+	g = make();
+	auto bfs = by_position( reorder_vertices(g, Vertex_Order::BFS) );
+	EXPECT_LE(grid_gaps(w, h, bfs).first, 2*h + 1);
+
+	g = make();
+	auto gorder = by_position( reorder_vertices(g, Vertex_Order::GORDER) );
+	EXPECT_LT(grid_gaps(w, h, gorder).second * 4, label_sum);
+
+	// degree: non-increasing
+	g = make();
+	reorder_vertices(g, Vertex_Order::DEGREE);
+	for(int v=0; v+1<n; ++v) EXPECT_GE(g.vert(v).outs().count(), g.vert(v+1).outs().count());
+}
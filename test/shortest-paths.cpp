@@ -0,0 +1,206 @@
+#include <salgo/graph/shortest-paths>
+#include <salgo/graph/graph>
+
+#include <gtest/gtest.h>
+
+#include <functional>
+#include <limits>
+#include <queue>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+using namespace salgo;
+using namespace salgo::graph;
+
+
+
+
+
+namespace {
+
+using Edges = std::vector<std::tuple<int,int,int>>; // from, to, weight
+
+constexpr long long Inf = std::numeric_limits<long long>::max();
+
+// plain Dijkstra over an edge list
+std::vector<long long> reference_dist(int n, const Edges& edges, bool directed, int source) {
+	std::vector<std::vector<std::pair<int,int>>> adj(n);
+	for(auto& [a,b,w] : edges) {
+		adj[a].emplace_back(b, w);
+		if(!directed) adj[b].emplace_back(a, w);
+	}
+
+	std::vector<long long> dist(n, Inf);
+	std::priority_queue<std::pair<long long,int>, std::vector<std::pair<long long,int>>, std::greater<>> q;
+	dist[source] = 0;
+	q.emplace(0, source);
+	while(!q.empty()) {
+		auto [d, v] = q.top(); q.pop();
+		if(d != dist[v]) continue;
+		for(auto& [u, w] : adj[v]) if(d + w < dist[u]) {
+			dist[u] = d + w;
+			q.emplace(dist[u], u);
+		}
+	}
+	return dist;
+}
+
+Edges random_edges(int n, int m, int max_weight) {
+	Edges edges;
+	for(int i=0; i<m; ++i) edges.emplace_back( rand() % n, rand() % n, rand() % (max_weight+1) );
+	return edges;
+}
+
+auto edge_weight = [](auto& out) { return (long long)out.edge().data(); };
+
+// checks distances against the reference, and that each parent edge is tight
+template<class G, class RESULT>
+void check(G& g, const RESULT& r, int n, const std::vector<long long>& expected) {
+	ASSERT_EQ(n, r.dist.domain());
+	for(int v=0; v<n; ++v) {
+		EXPECT_EQ(expected[v], r.dist[v]) << "vertex " << v;
+		EXPECT_EQ(expected[v] != Inf, r.reached(v));
+
+		if(v == 0 || !r.reached(v)) {
+			EXPECT_FALSE(r.parent[v].valid());
+			continue;
+		}
+
+		int p = r.parent[v];
+		bool tight = false;
+		for(auto& out : g.vert(p).outs()) {
+			if((int)out.vert().handle() == v && r.dist[p] + edge_weight(out) == r.dist[v]) tight = true;
+		}
+		EXPECT_TRUE(tight) << "parent of " << v;
+
+		// parents lead to the source
+		auto x = r.parent[v];
+		int steps = 1;
+		for(; x.valid() && x.a != 0 && steps <= n; ++steps) x = r.parent[x];
+		EXPECT_EQ(0, x.a) << "parents of " << v;
+		EXPECT_LE(steps, n) << "parent cycle through " << v;
+	}
+}
+
+template<class G>
+void check_all(G& g, int n, const std::vector<long long>& expected) {
+	check(g, shortest_paths(g, 0, edge_weight), n, expected);
+	check(g, shortest_paths_radix(g, 0, edge_weight), n, expected);
+	check(g, shortest_paths_delta_stepping(g, 0, edge_weight, NUM_THREADS = 1), n, expected);
+	check(g, shortest_paths_delta_stepping(g, 0, edge_weight, NUM_THREADS = 4, DELTA = 7LL), n, expected);
+}
+
+} // namespace
+
+
+
+
+TEST(Shortest_Paths, undirected) {
+	srand(69);
+	const int n = 3000;
+	auto edges = random_edges(n, 4*n, 100);
+
+	Graph ::EDGE_DATA<int> g(n);
+	for(auto& [a,b,w] : edges) g.edges().add(a, b, w);
+
+	auto expected = reference_dist(n, edges, false, 0);
+	check_all(g, n, expected);
+
+	auto csr = g.freeze();
+	check_all(csr, n, expected);
+}
+
+
+
+TEST(Shortest_Paths, directed) {
+	srand(69);
+	const int n = 3000;
+	auto edges = random_edges(n, 3*n, 1000);
+
+	Graph ::DIRECTED ::EDGE_DATA<int> g(n);
+	for(auto& [a,b,w] : edges) g.edges().add(a, b, w);
+
+	auto expected = reference_dist(n, edges, true, 0);
+	check_all(g, n, expected);
+
+	auto csr = g.freeze();
+	check_all(csr, n, expected);
+
+	// 32-bit keys in the radix heap
+	auto r = shortest_paths_radix(csr, 0, [](auto& out) { return out.edge().data(); });
+	for(int v=0; v<n; ++v) {
+		if(r.reached(v)) EXPECT_EQ(expected[v], r.dist[v]);
+		else EXPECT_EQ(Inf, expected[v]);
+	}
+}
+
+
+
+TEST(Shortest_Paths, many_threads) {
+	// big enough for delta-stepping to actually use several threads
+	srand(69);
+	const int n = 50'000;
+	auto edges = random_edges(n, 4*n, 50);
+
+	Graph ::EDGE_DATA<int> g(n);
+	for(auto& [a,b,w] : edges) g.edges().add(a, b, w);
+	auto csr = g.freeze();
+
+	auto expected = reference_dist(n, edges, false, 0);
+	check(csr, shortest_paths_delta_stepping(csr, 0, edge_weight, NUM_THREADS = 4), n, expected);
+	check(csr, shortest_paths_delta_stepping(csr, 0, edge_weight, NUM_THREADS = 3, DELTA = 1LL), n, expected);
+}
+
+
+
+TEST(Shortest_Paths, path_and_target) {
+	// 0 -1- 1 -1- 2 -1- 3
+	//  \_________5_____/
+	// 4 unreachable
+	Graph ::EDGE_DATA<int> g(5);
+	g.edges().add(0, 1, 1);
+	g.edges().add(1, 2, 1);
+	g.edges().add(2, 3, 1);
+	g.edges().add(0, 3, 5);
+
+	auto r = shortest_paths(g, 0, edge_weight);
+	EXPECT_EQ(3, r.dist[3]);
+	EXPECT_EQ(4, (int)r.path(3).size());
+	EXPECT_EQ(2, r.path(3)[2].a);
+	EXPECT_TRUE(r.path(4).empty());
+	EXPECT_FALSE(r.reached(4));
+
+	// early exit: the target is final, farther vertices are not settled
+	auto check_target = [&](auto&& res) {
+		EXPECT_EQ(2, res.dist[2]);
+		EXPECT_EQ(1, res.path(2)[1].a);
+	};
+	check_target( shortest_paths(g, 0, edge_weight, TARGET = 2) );
+	check_target( shortest_paths_radix(g, 0, edge_weight, TARGET = 2) );
+	check_target( shortest_paths_delta_stepping(g, 0, edge_weight, TARGET = 2) );
+
+	// floating-point weights
+	auto rf = shortest_paths(g, 0, [](auto& out) { return out.edge().data() * 0.5; });
+	EXPECT_DOUBLE_EQ(1.5, rf.dist[3]);
+}
+
+
+
+TEST(Shortest_Paths, zero_weight_cycle) {
+	// 0 -1- 1 -0- 2 -0- 3 -0- 1, 3 -2- 4
+	Graph ::EDGE_DATA<int> g(5);
+	g.edges().add(0, 1, 1);
+	g.edges().add(1, 2, 0);
+	g.edges().add(2, 3, 0);
+	g.edges().add(3, 1, 0);
+	g.edges().add(3, 4, 2);
+
+	Edges edges = { {0,1,1}, {1,2,0}, {2,3,0}, {3,1,0}, {3,4,2} };
+	check_all(g, 5, reference_dist(5, edges, false, 0));
+
+	auto r = shortest_paths_delta_stepping(g, 0, edge_weight);
+	EXPECT_EQ(3, r.dist[4]);
+	ASSERT_GE((int)r.path(4).size(), 3);
+	EXPECT_EQ(0, r.path(4).front().a);
+}
@@ -0,0 +1,165 @@
+#include "common.hpp"
+
+#include <salgo/alloc/slab-allocator>
+#include <salgo/list>
+#include <salgo/hash-table>
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstdint> // uintptr_t
+#include <map>
+#include <vector>
+
+using namespace salgo;
+
+
+
+TEST(Slab_Allocator, size_classes) {
+	using P = alloc::Slab_Pool;
+
+	EXPECT_EQ(0, P::size_class(1, 1));
+	EXPECT_EQ(0, P::size_class(8, 8));
+	EXPECT_EQ(1, P::size_class(12, 4));
+	EXPECT_EQ(1, P::size_class(4, 16));
+	EXPECT_EQ(P::Num_Classes-1, P::size_class(4096, 8));
+
+	EXPECT_EQ(8192, P::slots_per_slab(0));
+	EXPECT_EQ(16, P::slots_per_slab(P::Num_Classes-1));
+}
+
+
+
+TEST(Slab_Allocator, simple) {
+	alloc::Slab_Allocator<int> alloc;
+
+	std::vector< decltype(alloc)::Handle > handles;
+	for(int i=0; i<100000; ++i) {
+		handles.emplace_back( alloc.construct(i).handle() );
+	}
+
+	for(int i=0; i<100000; ++i) EXPECT_EQ(i, alloc[ handles[i] ]);
+
+	// small handles
+	decltype(alloc)::Handle_Small small = handles[77777];
+	EXPECT_EQ(77777, alloc[small]);
+
+	// 8-byte slots, 8192 per slab
+	EXPECT_EQ( (100000 + 8191) / 8192 * alloc::Slab_Pool::Slab_Size, alloc.bytes_reserved() );
+
+	for(auto& h : handles) alloc(h).destruct();
+}
+
+
+
+TEST(Slab_Allocator, reuse_and_alignment) {
+	struct alignas(16) Vec4 { float v[4]; };
+	alloc::Slab_Allocator<Vec4> alloc;
+
+	auto a = alloc.construct().handle();
+	auto b = alloc.construct().handle();
+	EXPECT_EQ(16, (char*)&alloc[b] - (char*)&alloc[a]);
+	EXPECT_EQ(0u, (std::uintptr_t)&alloc[a] % 16);
+
+	alloc(a).destruct();
+	EXPECT_EQ(a, alloc.construct().handle()); // freed slot is reused
+
+	// big elements
+	alloc::Slab_Allocator< std::array<char,3000> > big_alloc;
+	std::vector< decltype(big_alloc)::Handle > handles;
+	for(int i=0; i<40; ++i) handles.emplace_back( big_alloc.construct().handle() );
+	EXPECT_EQ(3 * alloc::Slab_Pool::Slab_Size, big_alloc.bytes_reserved()); // 16 slots per slab
+	for(auto& h : handles) big_alloc(h).destruct();
+}
+
+
+
+TEST(Slab_Allocator, construct_near) {
+	alloc::Slab_Allocator<long long> alloc;
+
+	std::vector< decltype(alloc)::Handle > handles;
+	for(int i=0; i<3*8192; ++i) handles.emplace_back( alloc.construct(i).handle() );
+
+	// free one slot in the first slab, and some in the last one
+	alloc( handles[100] ).destruct();
+	for(int i=0; i<10; ++i) alloc( handles[3*8192 - 1 - i] ).destruct();
+
+	// a plain construct() fills the most recently used slab, construct_near() the hint's one
+	auto h = alloc.construct_near( handles[5], 1 ).handle();
+	EXPECT_EQ(handles[5].a, h.a);
+	EXPECT_EQ(handles[100], h);
+
+	auto h2 = alloc.construct_near( handles[5], 2 ).handle(); // slab full - falls back
+	EXPECT_EQ(handles[3*8192 - 1].a, h2.a);
+}
+
+
+
+TEST(Slab_Allocator, random) {
+	using T = Movable;
+	T::reset();
+
+	{
+		alloc::Slab_Allocator<T> alloc;
+		std::map<int, decltype(alloc)::Handle> alive;
+
+		srand(69);
+		for(int i=0; i<100000; ++i) {
+			if(!alive.empty() && rand()%2) {
+				auto it = alive.lower_bound( rand() % i );
+				if(it == alive.end()) it = alive.begin();
+				EXPECT_EQ(it->first, (int)alloc[ it->second ]);
+				alloc( it->second ).destruct();
+				alive.erase(it);
+			}
+			else if(!alive.empty() && rand()%2) {
+				// fills slabs from the middle of the partial stack
+				auto hint = alive.lower_bound( rand() % i );
+				if(hint == alive.end()) hint = alive.begin();
+				alive.emplace(i, alloc.construct_near(hint->second, i).handle());
+			}
+			else alive.emplace(i, alloc.construct(i).handle());
+		}
+
+		for(auto& [k, h] : alive) {
+			EXPECT_EQ(k, (int)alloc[h]);
+			alloc(h).destruct();
+		}
+	}
+
+	EXPECT_EQ(T::constructors(), T::destructors());
+}
+
+
+
+TEST(Slab_Allocator, shared_pool) {
+	struct Tag {};
+	using Alloc = alloc::Slab_Allocator<int> ::SHARED<Tag>;
+
+	// different node types share one pool (list nodes: 16 bytes, hash table elements: 32 bytes)
+	{
+		List<int> ::ALLOCATOR<Alloc> a, b;
+		Hash_Table<int, std::array<double,2>> ::EXTERNAL ::ALLOCATOR<Alloc> c;
+
+		for(int i=0; i<1000; ++i) {
+			a.emplace_back(i);
+			b.emplace_back(-i);
+			c.emplace(i, std::array<double,2>{i/2.0, 0});
+		}
+
+		// lists sharing the pool can splice nodes without moving them
+		auto h = a(FIRST).handle();
+		b.splice( b(FIRST), a, h );
+		EXPECT_EQ(0, b[FIRST]);
+		EXPECT_EQ(h, b(FIRST).handle());
+
+		long long sum = 0;
+		for(auto& e : a) sum += e;
+		for(auto& e : b) sum += e;
+		EXPECT_EQ(0, sum);
+		EXPECT_EQ(250.0, c[500][0]);
+
+		EXPECT_EQ(Alloc().bytes_reserved(), alloc::Slab_Allocator<char> ::SHARED<Tag>().bytes_reserved());
+		EXPECT_GE(Alloc().bytes_reserved(), 2 * alloc::Slab_Pool::Slab_Size);
+	}
+}
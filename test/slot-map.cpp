@@ -0,0 +1,120 @@
+#include "common.hpp"
+
+#include <salgo/slot-map>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <map>
+#include <vector>
+
+using namespace std;
+using namespace salgo;
+
+
+
+
+
+
+TEST(Slot_Map, simple) {
+	Slot_Map<int> m;
+
+	auto h1 = m.emplace(1).handle();
+	auto h2 = m.emplace(2).handle();
+	auto h3 = m.emplace(3).handle();
+
+	EXPECT_EQ(3, m.count());
+	EXPECT_EQ(1, m[h1]);
+	EXPECT_EQ(2, m(h2)());
+	EXPECT_EQ(3, m[h3]);
+
+	m.erase(h1); // 3 moves into the hole
+	EXPECT_EQ(2, m.count());
+	EXPECT_EQ(2, m[h2]);
+	EXPECT_EQ(3, m[h3]);
+	EXPECT_EQ(3, m[FIRST]);
+	EXPECT_EQ(2, m[LAST]);
+
+	int sum = 0;
+	for(auto& e : m) sum += e;
+	EXPECT_EQ(5, sum);
+}
+
+
+
+TEST(Slot_Map, stale_handles) {
+	Slot_Map<int> m;
+
+	auto h1 = m.emplace(1).handle();
+	EXPECT_TRUE(m.exists(h1));
+
+	m(h1).erase();
+	EXPECT_FALSE(m.exists(h1));
+
+	// slot is reused, but the old handle doesn't alias the new element
+	auto h2 = m.emplace(2).handle();
+	EXPECT_EQ(h1.a, h2.a);
+	EXPECT_NE(h1, h2);
+	EXPECT_FALSE(m.exists(h1));
+	EXPECT_TRUE(m(h2).exists());
+
+	EXPECT_FALSE(m.exists( Slot_Map<int>::Handle() ));
+
+	m.clear();
+	EXPECT_TRUE(m.is_empty());
+	EXPECT_FALSE(m.exists(h2));
+}
+
+
+
+TEST(Slot_Map, erase_while_iterating) {
+	Slot_Map<int> m;
+	for(int i=0; i<100; ++i) m.emplace(i);
+
+	for(auto& e : m) if(e() % 3 == 0) e.erase();
+
+	EXPECT_EQ(66, m.count());
+
+	vector<int> vals;
+	for(auto& e : m) {
+		EXPECT_TRUE(e.exists());
+		EXPECT_EQ(e(), m[ e.handle() ]);
+		vals.push_back(e);
+	}
+	sort(vals.begin(), vals.end());
+
+	vector<int> expected;
+	for(int i=0; i<100; ++i) if(i % 3) expected.push_back(i);
+	EXPECT_EQ(expected, vals);
+}
+
+
+
+TEST(Slot_Map, random) {
+	using T = Movable;
+	T::reset();
+
+	{
+		Slot_Map<T> m;
+		std::map<int, Slot_Map<T>::Handle> alive;
+		vector<Slot_Map<T>::Handle> dead;
+
+		srand(69);
+		for(int i=0; i<100000; ++i) {
+			if(!alive.empty() && rand()%2) {
+				auto it = alive.lower_bound( rand() % i );
+				if(it == alive.end()) it = alive.begin();
+				m.erase(it->second);
+				dead.push_back(it->second);
+				alive.erase(it);
+			}
+			else alive.emplace(i, m.emplace(i).handle());
+		}
+
+		EXPECT_EQ((int)alive.size(), m.count());
+		for(auto& [k, h] : alive) EXPECT_EQ(k, (int)m[h]);
+		for(auto& h : dead) EXPECT_FALSE(m.exists(h));
+	}
+
+	EXPECT_EQ(T::constructors(), T::destructors());
+}
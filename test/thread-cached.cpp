@@ -0,0 +1,107 @@
+#include "common.hpp"
+
+#include <salgo/alloc/thread-cached>
+#include <salgo/alloc/crude-allocator>
+#include <salgo/list>
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+using namespace salgo;
+
+
+
+TEST(Thread_Cached, simple) {
+	using Alloc = Thread_Cached< Crude_Allocator<int> ::REUSE > ::BATCH<4>;
+	Alloc alloc;
+
+	std::vector< Alloc::Handle > handles;
+	for(int i=0; i<100; ++i) {
+		handles.emplace_back( alloc.construct(i).handle() );
+	}
+
+	for(int i=0; i<100; i+=2) alloc( handles[i] ).destruct();
+
+	// slots are reused
+	for(int i=0; i<100; i+=2) handles[i] = alloc.construct(i).handle();
+
+	for(int i=0; i<100; ++i) EXPECT_EQ(i, alloc[ handles[i] ]);
+
+	for(auto& h : handles) alloc.destruct(h);
+}
+
+
+
+TEST(Thread_Cached, destructors) {
+	using T = Movable;
+
+	int constructors = 0;
+	int destructors = 0;
+
+	auto worker = [&](int seed) {
+		T::reset();
+
+		Thread_Cached< Crude_Allocator<T> ::REUSE > ::BATCH<8> alloc;
+		std::vector< decltype(alloc)::Handle > handles;
+
+		srand(seed);
+		for(int i=0; i<10000; ++i) {
+			if(!handles.empty() && rand()%2) {
+				int j = rand() % handles.size();
+				alloc.destruct( handles[j] );
+				handles[j] = handles.back();
+				handles.pop_back();
+			}
+			else handles.emplace_back( alloc.construct(i).handle() );
+		}
+		for(auto& h : handles) alloc.destruct(h);
+
+		constructors += T::constructors();
+		destructors += T::destructors();
+	};
+
+	std::thread th(worker, 1);
+	th.join();
+	worker(2);
+
+	EXPECT_EQ(constructors, destructors);
+}
+
+
+
+TEST(Thread_Cached, lists_from_many_threads) {
+	using Alloc = Thread_Cached< Crude_Allocator<int> ::REUSE > ::BATCH<16>;
+
+	const int Threads = 4;
+	const int N = 20000;
+
+	std::vector< List<int> ::ALLOCATOR<Alloc> > lists(Threads);
+	std::vector<long long> sums(Threads);
+
+	std::vector<std::thread> threads;
+	for(int t=0; t<Threads; ++t) threads.emplace_back([&, t] {
+		auto& li = lists[t];
+		for(int i=0; i<N; ++i) {
+			li.emplace_back(i);
+			if(i % 3 == 0) li(FIRST).erase();
+		}
+		for(auto& e : li) sums[t] += e;
+	});
+	for(auto& th : threads) th.join();
+
+	// expected: emplace 0..N-1, erasing the first element every 3rd step
+	List<int> expected;
+	for(int i=0; i<N; ++i) {
+		expected.emplace_back(i);
+		if(i % 3 == 0) expected(FIRST).erase();
+	}
+	long long expected_sum = 0;
+	for(auto& e : expected) expected_sum += e;
+
+	for(int t=0; t<Threads; ++t) EXPECT_EQ(expected_sum, sums[t]);
+
+	// elements constructed by other threads can be erased here
+	for(auto& li : lists) li.clear();
+}
@@ -2,6 +2,9 @@
 
 #include <gtest/gtest.h>
 
+#include <utility>
+#include <vector>
+
 
 using namespace salgo;
 
@@ -86,3 +89,142 @@ TEST(Union_Find, data_destruct_and_count) {
 }
 
 
+
+
+
+TEST(Union_Find, concurrent_simple) {
+	Union_Find ::CONCURRENT uf(10);
+	EXPECT_EQ(10, uf.domain());
+
+	EXPECT_FALSE( uf.same(2, 5) );
+	EXPECT_TRUE( uf.merge(2, 5) );
+	EXPECT_FALSE( uf.merge(5, 2) );
+	EXPECT_TRUE( uf.same(2, 5) );
+
+	uf.merge(7, 5);
+	EXPECT_EQ( 2, uf.find(7) ); // linked by index
+	EXPECT_FALSE( uf.same(7, 3) );
+}
+
+
+TEST(Union_Find, concurrent_merge_edges) {
+	const int N = 100000;
+
+	srand(69);
+	std::vector<std::pair<int,int>> edges;
+	for(int i=0; i<N/2; ++i) edges.emplace_back( rand() % N, rand() % N );
+
+	Union_Find ::COUNTABLE reference(N);
+	for(auto& [a, b] : edges) if(reference(a) != reference(b)) reference.merge(a, b);
+
+	for(int num_threads : {1, 4}) {
+		Union_Find ::CONCURRENT uf(N);
+		uf.merge_edges(edges, num_threads);
+
+		int num_sets = 0;
+		for(int i=0; i<N; ++i) {
+			num_sets += uf.find(i) == i;
+			EXPECT_EQ( reference(i) == reference(edges[i % edges.size()].first), uf.same(i, edges[i % edges.size()].first) );
+		}
+		EXPECT_EQ( reference.count(), num_sets );
+	}
+}
+
+
+
+TEST(Union_Find, countable_sets) {
+	Union_Find ::COUNTABLE_SETS uf(10);
+
+	uf.merge(1, 2);
+	uf.merge(3, 1);
+	uf.merge(4, 5);
+
+	EXPECT_EQ( 3, uf(3).count() );
+	EXPECT_EQ( 2, uf(5).count() );
+	EXPECT_EQ( 1, uf(0).count() );
+
+	uf.merge(5, 2); // smaller under bigger
+	EXPECT_EQ( 5, uf(4).count() );
+	EXPECT_EQ( uf(1), uf(4) );
+}
+
+
+TEST(Union_Find, rollback) {
+	Union_Find ::ROLLBACK ::COUNTABLE uf(10);
+
+	uf.merge(0, 1);
+	auto cp = uf.checkpoint();
+
+	uf.merge(2, 3);
+	uf.merge(1, 3);
+	uf.merge(0, 2); // already in the same set - nothing to undo
+	EXPECT_EQ( uf(0), uf(3) );
+	EXPECT_EQ( 7, uf.count() );
+	EXPECT_EQ( 4, uf(2).count() );
+
+	auto cp2 = uf.checkpoint();
+	uf.merge(5, 6);
+	uf.rollback(cp2);
+	EXPECT_NE( uf(5), uf(6) );
+	EXPECT_EQ( uf(0), uf(3) );
+
+	uf.rollback(cp);
+	EXPECT_EQ( uf(0), uf(1) );
+	EXPECT_NE( uf(0), uf(2) );
+	EXPECT_NE( uf(2), uf(3) );
+	EXPECT_EQ( 9, uf.count() );
+	EXPECT_EQ( 2, uf(1).count() );
+	EXPECT_EQ( 1, uf(3).count() );
+}
+
+
+TEST(Union_Find, rollback_data) {
+	Union_Find ::DATA<int> ::ROLLBACK uf(4, 10);
+	uf[3] = 7;
+
+	auto cp = uf.checkpoint();
+	uf.merge(0, 1);
+	uf.merge(1, 3);
+	EXPECT_EQ( 27, uf[0] );
+
+	uf.rollback(cp);
+	EXPECT_EQ( 10, uf[0] );
+	EXPECT_EQ( 10, uf[1] );
+	EXPECT_EQ( 7, uf[3] );
+}
+
+
+TEST(Union_Find, rollback_random) {
+	const int N = 100;
+
+	srand(69);
+	std::vector<std::pair<int,int>> edges;
+	Union_Find ::ROLLBACK uf(N);
+	std::vector<int> checkpoints;
+
+	for(int iter=0; iter<1000; ++iter) {
+		if(rand() % 3 == 0 && !checkpoints.empty()) {
+			int k = rand() % checkpoints.size();
+			uf.rollback( checkpoints[k] );
+			edges.resize( checkpoints[k] );
+			checkpoints.resize(k);
+		}
+		else {
+			if(rand() % 4 == 0) checkpoints.emplace_back( uf.checkpoint() );
+
+			int a = rand() % N, b = rand() % N;
+			if(uf(a) != uf(b)) {
+				uf.merge(a, b);
+				edges.emplace_back(a, b);
+			}
+		}
+
+		Union_Find reference(N);
+		for(auto& [a, b] : edges) if(reference(a) != reference(b)) reference.merge(a, b);
+
+		for(int i=0; i<20; ++i) {
+			int a = rand() % N, b = rand() % N;
+			EXPECT_EQ( reference(a) == reference(b), uf(a) == uf(b) );
+		}
+	}
+}
@@ -1,3 +1,5 @@
+#include "common.hpp"
+
 #include <salgo/unordered-array>
 
 #include <gtest/gtest.h>
@@ -127,3 +129,45 @@ TEST(Unordered_Array, forward_iteration_bad) {
 
 
 
+
+
+
+TEST(Unordered_Array, erase_if) {
+	Unordered_Array<int> v;
+	for(int i=0; i<100; ++i) v.add(i);
+
+	EXPECT_EQ(90, v.erase_if([](int x){ return x % 10; }));
+
+	multiset<int> s;
+	for(auto& e : v) s.insert(e);
+	EXPECT_EQ(multiset<int>({0,10,20,30,40,50,60,70,80,90}), s);
+}
+
+
+TEST(Unordered_Array, erase_if_nontrivial) {
+	Movable::reset();
+
+	{
+		Unordered_Array<Movable> v;
+		for(int i=0; i<100; ++i) v.add(i);
+
+		EXPECT_EQ(90, v.erase_if([](const Movable& x){ return x.x % 10; }));
+
+		multiset<int> s;
+		for(auto& e : v) s.insert(e().x);
+		EXPECT_EQ(multiset<int>({0,10,20,30,40,50,60,70,80,90}), s);
+	}
+
+	EXPECT_EQ(Movable::constructors(), Movable::destructors());
+}
+
+
+TEST(Unordered_Array, partition) {
+	Unordered_Array<Movable> v;
+	for(int i=0; i<100; ++i) v.add(i);
+
+	int n = v.partition([](const Movable& x){ return x.x % 3 == 0; });
+	EXPECT_EQ(34, n);
+
+	for(int i=0; i<v.size(); ++i) EXPECT_EQ(i < n, v[i].x % 3 == 0);
+}